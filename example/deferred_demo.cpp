@@ -755,6 +755,32 @@ private:
     }
 
     ImGui::Text("Keys: 1-7 modes, G grid");
+
+    const CullStats& cull = m_SceneRenderer->GetCullStats();
+    ImGui::Text("Nodes: %u visible, %u culled",
+                cull.NodesVisible,
+                cull.GetNodesCulled());
+    ImGui::Text("Submeshes culled: %u, draws: %u (%u instanced batches)",
+                cull.SubMeshesCulled,
+                cull.DrawCalls,
+                cull.InstancedBatches);
+    bool instancing = m_SceneRenderer->IsInstancing();
+    if (ImGui::Checkbox("Instancing", &instancing)) {
+      m_SceneRenderer->SetInstancing(instancing);
+    }
+    bool indirect = m_SceneRenderer->IsIndirectDraws();
+    if (ImGui::Checkbox("Indirect draws", &indirect)) {
+      m_SceneRenderer->SetIndirectDraws(indirect);
+    }
+    const BindStats& binds = m_SceneRenderer->GetBindStats();
+    ImGui::Text("Binds: %u sorted, %u in scene order",
+                binds.Sorted.GetTotal(),
+                binds.SceneOrder.GetTotal());
+    const CommandStats commands =
+        GetDevice().GetCurrentCommandBuffer()->GetCommandStats();
+    ImGui::Text("Commands: %u emitted, %u filtered",
+                commands.Emitted,
+                commands.Filtered);
     ImGui::Separator();
 
     // Directional light controls
@@ -0,0 +1,155 @@
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <linalg/vec.hpp>
+
+#include "Core/Logger.hpp"
+#include "Renderer/Model/Mesh.hpp"
+#include "Renderer/Model/Model.hpp"
+#include "Renderer/Model/Vertex.hpp"
+#include "Renderer/Scene/Scene.hpp"
+#include "Renderer/Scene/SceneNode.hpp"
+
+// Compares Scene::PickNode, which walks the scene BVH, against a linear scan
+// over every renderable node's world bounds, on scenes with 1k/10k/100k
+// unit cubes scattered through a volume. Also times a refit after 1% of the
+// nodes moved. Only CPU-side mesh data is created, so no device is needed.
+
+namespace
+{
+
+constexpr int RAY_COUNT = 1000;
+constexpr unsigned RANDOM_SEED = 1234;
+constexpr float SCENE_EXTENT = 500.0F;
+constexpr size_t MOVE_STRIDE = 100;  // Move 1% of the nodes per refit
+
+auto CreateCubeModel() -> std::shared_ptr<Model>
+{
+  std::vector<Vertex> vertices;
+  for (const float x : {-0.5F, 0.5F}) {
+    for (const float y : {-0.5F, 0.5F}) {
+      for (const float z : {-0.5F, 0.5F}) {
+        Vertex vertex {};
+        vertex.Position = linalg::Vec3 {x, y, z};
+        vertices.push_back(vertex);
+      }
+    }
+  }
+
+  auto mesh = std::make_unique<Mesh>("Cube");
+  mesh->SetVertices(std::move(vertices));
+
+  auto model = std::make_shared<Model>("Cube");
+  model->AddMesh(std::move(mesh));
+  return model;
+}
+
+auto LinearPick(const std::vector<SceneNode*>& nodes, const Ray& ray)
+    -> SceneNode*
+{
+  SceneNode* closest = nullptr;
+  float closest_t = std::numeric_limits<float>::max();
+  for (auto* node : nodes) {
+    float t_hit = 0.0F;
+    if (node->GetWorldBounds().Intersects(ray, t_hit) && t_hit < closest_t) {
+      closest_t = t_hit;
+      closest = node;
+    }
+  }
+  return closest;
+}
+
+template<typename PickFn>
+auto TimePicks(const std::vector<Ray>& rays, PickFn&& pick, size_t& hits)
+    -> double
+{
+  using Clock = std::chrono::steady_clock;
+  hits = 0;
+  const auto start = Clock::now();
+  for (const auto& ray : rays) {
+    if (pick(ray) != nullptr) {
+      ++hits;
+    }
+  }
+  const Clock::duration total = Clock::now() - start;
+  return std::chrono::duration<double, std::micro>(total).count()
+      / static_cast<double>(rays.size());
+}
+
+}  // namespace
+
+auto main() -> int
+{
+  Logger::Init(LoggerConfig {spdlog::level::info});
+
+  const auto cube = CreateCubeModel();
+  std::mt19937 rng(RANDOM_SEED);
+  std::uniform_real_distribution<float> coord(-SCENE_EXTENT, SCENE_EXTENT);
+
+  std::vector<Ray> rays;
+  rays.reserve(RAY_COUNT);
+  for (int i = 0; i < RAY_COUNT; ++i) {
+    const linalg::Vec3 origin {coord(rng), coord(rng), -2.0F * SCENE_EXTENT};
+    const linalg::Vec3 target {coord(rng), coord(rng), coord(rng)};
+    rays.push_back({origin, linalg::normalized(target - origin)});
+  }
+
+  for (const size_t node_count : {1'000UZ, 10'000UZ, 100'000UZ}) {
+    Scene scene("Benchmark");
+    std::vector<SceneNode*> nodes;
+    nodes.reserve(node_count);
+    for (size_t i = 0; i < node_count; ++i) {
+      SceneNode* node = scene.GetRoot().CreateChild("Cube");
+      node->SetPosition(linalg::Vec3 {coord(rng), coord(rng), coord(rng)});
+      node->SetModel(cube);
+      nodes.push_back(node);
+    }
+    scene.UpdateTransforms();
+
+    using Clock = std::chrono::steady_clock;
+    const auto build_start = Clock::now();
+    (void)scene.GetBounds();  // Forces the initial BVH build
+    const double build_ms =
+        std::chrono::duration<double, std::milli>(Clock::now() - build_start)
+            .count();
+
+    size_t bvh_hits = 0;
+    size_t linear_hits = 0;
+    const double bvh_us = TimePicks(
+        rays,
+        [&scene](const Ray& ray) -> SceneNode* { return scene.PickNode(ray); },
+        bvh_hits);
+    const double linear_us = TimePicks(
+        rays,
+        [&nodes](const Ray& ray) -> SceneNode*
+        { return LinearPick(nodes, ray); },
+        linear_hits);
+
+    for (size_t i = 0; i < nodes.size(); i += MOVE_STRIDE) {
+      nodes[i]->GetTransform().Translate(linalg::Vec3 {1.0F, 0.0F, 0.0F});
+    }
+    const auto refit_start = Clock::now();
+    scene.UpdateTransforms();
+    const double refit_ms =
+        std::chrono::duration<double, std::milli>(Clock::now() - refit_start)
+            .count();
+
+    Logger::Info(
+        "{:>6} nodes: pick bvh {:.2f} us, linear {:.2f} us ({:.1f}x), "
+        "hits {}/{}, build {:.2f} ms, 1% refit {:.3f} ms",
+        node_count,
+        bvh_us,
+        linear_us,
+        linear_us / bvh_us,
+        bvh_hits,
+        linear_hits,
+        build_ms,
+        refit_ms);
+  }
+
+  return 0;
+}
@@ -0,0 +1,128 @@
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "Core/Logger.hpp"
+#include "Renderer/Scene/Scene.hpp"
+#include "Renderer/Scene/SceneNode.hpp"
+
+// Compares the std::function Scene::ForEachNode overload against the
+// templated traversal on a wide random hierarchy and on a deep chain, and
+// times the pruned visible-only walk with a tenth of the subtrees hidden.
+
+namespace
+{
+
+constexpr int ITERATIONS = 50;
+constexpr unsigned RANDOM_SEED = 1234;
+constexpr size_t NODE_COUNT = 100'000;
+constexpr size_t CHAIN_DEPTH = 5'000;
+constexpr size_t HIDDEN_STRIDE = 10;
+
+void BuildWide(Scene& scene)
+{
+  std::mt19937 rng(RANDOM_SEED);
+  std::vector<SceneNode*> nodes {&scene.GetRoot()};
+  nodes.reserve(NODE_COUNT);
+  while (nodes.size() < NODE_COUNT) {
+    std::uniform_int_distribution<size_t> pick_parent(0, nodes.size() - 1);
+    nodes.push_back(nodes[pick_parent(rng)]->CreateChild("Node"));
+  }
+}
+
+void BuildChain(Scene& scene)
+{
+  SceneNode* node = &scene.GetRoot();
+  for (size_t i = 0; i < CHAIN_DEPTH; ++i) {
+    node = node->CreateChild("Node");
+  }
+}
+
+template<typename TraverseFn>
+auto TimeTraversal(TraverseFn&& traverse, size_t& visited) -> double
+{
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
+  for (int i = 0; i < ITERATIONS; ++i) {
+    visited = traverse();
+  }
+  const Clock::duration total = Clock::now() - start;
+  return std::chrono::duration<double, std::milli>(total).count() / ITERATIONS;
+}
+
+void Compare(const char* label, const Scene& scene)
+{
+  size_t function_visited = 0;
+  const double function_ms = TimeTraversal(
+      [&scene]() -> size_t
+      {
+        size_t count = 0;
+        const std::function<void(const SceneNode&)> callback =
+            [&count](const SceneNode& /*node*/) -> void { ++count; };
+        scene.ForEachNode(callback);
+        return count;
+      },
+      function_visited);
+
+  size_t template_visited = 0;
+  const double template_ms = TimeTraversal(
+      [&scene]() -> size_t
+      {
+        size_t count = 0;
+        scene.ForEachNode([&count](const SceneNode& /*node*/) -> void
+                          { ++count; });
+        return count;
+      },
+      template_visited);
+
+  size_t visible_visited = 0;
+  const double visible_ms = TimeTraversal(
+      [&scene]() -> size_t
+      {
+        size_t count = 0;
+        scene.ForEachVisibleNode([&count](const SceneNode& /*node*/) -> void
+                                 { ++count; });
+        return count;
+      },
+      visible_visited);
+
+  Logger::Info(
+      "{}: std::function {:.3f} ms, template {:.3f} ms ({:.2f}x), "
+      "visible-only {:.3f} ms ({} of {} nodes)",
+      label,
+      function_ms,
+      template_ms,
+      function_ms / template_ms,
+      visible_ms,
+      visible_visited,
+      template_visited);
+}
+
+}  // namespace
+
+auto main() -> int
+{
+  Logger::Init(LoggerConfig {spdlog::level::info});
+
+  {
+    Scene scene("Wide");
+    BuildWide(scene);
+
+    // Hide every tenth child of the root, pruning their whole subtrees
+    const auto& children = scene.GetRoot().GetChildren();
+    for (size_t i = 0; i < children.size(); i += HIDDEN_STRIDE) {
+      children[i]->SetVisible(false);
+    }
+    Compare("100k wide", scene);
+  }
+
+  {
+    Scene scene("Deep");
+    BuildChain(scene);
+    Compare("5k deep", scene);
+  }
+
+  return 0;
+}
@@ -65,7 +65,7 @@ protected:
   void SwitchBackend(RenderAPI new_api);
 
 private:
-  static void InitSdl();
+  static void InitSdl(RenderAPI api);
   [[nodiscard]] auto buildSwapchainPassInfo() -> RenderPassInfo;
 
   RendererConfig m_RendererConfig;
@@ -0,0 +1,52 @@
+#ifndef CORE_THREADPOOL_HPP
+#define CORE_THREADPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size pool for fork-join loops. The calling thread takes part in
+// ParallelFor, so a pool of N threads starts N - 1 workers.
+class ThreadPool
+{
+public:
+  explicit ThreadPool(uint32_t thread_count);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+  auto operator=(ThreadPool&&) -> ThreadPool& = delete;
+
+  // Run task(i) for every i in [0, count) and wait for all of them. Indices
+  // are handed out dynamically, so uneven tasks balance across threads.
+  void ParallelFor(size_t count, const std::function<void(size_t)>& task);
+
+  [[nodiscard]] auto GetThreadCount() const -> uint32_t
+  {
+    return static_cast<uint32_t>(m_Workers.size()) + 1;
+  }
+
+private:
+  void worker_loop(const std::stop_token& stop_token);
+  void run_tasks();
+
+  std::vector<std::jthread> m_Workers;
+
+  std::mutex m_Mutex;
+  std::condition_variable_any m_WakeCondition;
+  std::condition_variable m_DoneCondition;
+
+  const std::function<void(size_t)>* m_Task {nullptr};
+  size_t m_TaskCount {0};
+  std::atomic<size_t> m_NextIndex {0};
+  uint64_t m_Generation {0};
+  uint32_t m_ActiveWorkers {0};
+};
+
+#endif
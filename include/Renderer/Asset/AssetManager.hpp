@@ -6,6 +6,7 @@
 #include <string>
 #include <unordered_map>
 
+class GeometryPool;
 class RHIDevice;
 class RHITexture;
 class RHISampler;
@@ -75,6 +76,8 @@ public:
   [[nodiscard]] auto GetAssetBasePath() const -> const std::filesystem::path&;
 
   [[nodiscard]] auto GetDevice() -> RHIDevice&;
+  // Shared vertex and index storage for every loaded model
+  [[nodiscard]] auto GetGeometryPool() -> GeometryPool&;
 
 private:
   void create_default_resources();
@@ -85,6 +88,8 @@ private:
 
   RHIDevice& m_Device;
   std::filesystem::path m_AssetBasePath {"assets"};
+  // Declared before the caches so it outlives the meshes allocated from it
+  std::unique_ptr<GeometryPool> m_GeometryPool;
 
   std::unordered_map<std::string, std::shared_ptr<RHITexture>> m_TextureCache;
   std::unordered_map<std::string, std::shared_ptr<Model>> m_ModelCache;
@@ -0,0 +1,78 @@
+#ifndef RENDERER_DRAWQUEUE_HPP
+#define RENDERER_DRAWQUEUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class Material;
+class Mesh;
+struct SubMesh;
+
+enum class DrawPass : uint8_t
+{
+  Opaque,
+  Masked,
+  Transparent
+};
+
+// One indexed draw of a submesh, with everything needed to bind it
+struct DrawPacket
+{
+  uint64_t SortKey {0};
+  const Mesh* MeshRef {nullptr};
+  const SubMesh* SubMeshRef {nullptr};
+  const Material* MaterialRef {nullptr};
+  // Range of per-instance data owned by whoever fills the queue
+  uint32_t FirstInstance {0};
+  uint32_t InstanceCount {1};
+};
+
+// Collects draw packets for a frame and orders them by sort key.
+//
+// Keys hold, from the most significant bits down, the pass (4 bits) and then
+// material (20), mesh (20) and view depth (20). Opaque and masked draws are
+// grouped by state and go front to back within a group; transparent draws
+// put depth right after the pass so they are drawn back to front. Ids are
+// truncated to their field, so two ids may share a group; that only costs a
+// redundant bind, never a wrong draw.
+//
+// Sort() is an LSD radix sort over 8-bit digits that skips digits on which
+// every key agrees, so small id ranges sort in a few passes.
+class DrawQueue
+{
+public:
+  DrawQueue() = default;
+
+  [[nodiscard]] static auto MakeSortKey(DrawPass pass,
+                                        uint64_t material_id,
+                                        uint64_t mesh_id,
+                                        float depth) -> uint64_t;
+
+  void Clear();
+  void Add(const DrawPacket& packet);
+  void Sort();
+
+  // Insertion order until Sort() is called
+  [[nodiscard]] auto GetPackets() const -> std::span<const DrawPacket>
+  {
+    return m_Packets;
+  }
+  [[nodiscard]] auto GetSize() const -> size_t { return m_Packets.size(); }
+
+private:
+  struct SortEntry
+  {
+    uint64_t Key {0};
+    uint32_t Index {0};
+  };
+
+  std::vector<DrawPacket> m_Packets;
+  // Scratch storage, kept between frames to avoid reallocating
+  std::vector<DrawPacket> m_Sorted;
+  std::vector<SortEntry> m_Entries;
+  std::vector<SortEntry> m_Scratch;
+};
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef RENDERER_FRUSTUM_HPP
+#define RENDERER_FRUSTUM_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <linalg/mat4.hpp>
+#include <linalg/vec.hpp>
+
+#include "Renderer/Model/BoundingVolume.hpp"
+
+// View frustum as six normalized planes (xyz = inward normal, w = distance),
+// extracted from a view-projection matrix.
+//
+// The batched tests process four volumes per step in SoA form (SSE when
+// available, a scalar loop otherwise) and write one visibility byte per
+// volume. Tests are conservative: a volume straddling a plane is visible.
+class Frustum
+{
+public:
+  enum Plane : uint8_t
+  {
+    Left,
+    Right,
+    Bottom,
+    Top,
+    Near,
+    Far,
+    PlaneCount,
+  };
+
+  Frustum() = default;
+
+  [[nodiscard]] static auto FromMatrix(const linalg::Mat4& view_projection)
+      -> Frustum;
+
+  [[nodiscard]] auto Intersects(const AABB& aabb) const -> bool;
+  [[nodiscard]] auto Intersects(const BoundingSphere& sphere) const -> bool;
+
+  // visible must be at least as large as the input. Returns the number of
+  // visible volumes. Invalid volumes are never visible.
+  auto CullAABBs(std::span<const AABB> boxes, std::span<uint8_t> visible) const
+      -> size_t;
+  auto CullSpheres(std::span<const BoundingSphere> spheres,
+                   std::span<uint8_t> visible) const -> size_t;
+
+  [[nodiscard]] auto GetPlanes() const
+      -> const std::array<linalg::Vec4, PlaneCount>&
+  {
+    return m_Planes;
+  }
+
+private:
+  // Bit N of the result is set when volume N of the batch is visible
+  [[nodiscard]] auto test_aabb_batch(const AABB* boxes) const -> uint32_t;
+  [[nodiscard]] auto test_sphere_batch(const BoundingSphere* spheres) const
+      -> uint32_t;
+
+  std::array<linalg::Vec4, PlaneCount> m_Planes {};
+};
+
+#endif
@@ -104,6 +104,14 @@ struct AABB
     return result;
   }
 
+  [[nodiscard]] auto Overlaps(const AABB& other) const -> bool
+  {
+    return IsValid() && other.IsValid() && Min.x() <= other.Max.x()
+        && Max.x() >= other.Min.x() && Min.y() <= other.Max.y()
+        && Max.y() >= other.Min.y() && Min.z() <= other.Max.z()
+        && Max.z() >= other.Min.z();
+  }
+
   // Ray-AABB intersection using the slab method.
   // Returns true if the ray hits, writing the entry distance to t_hit.
   [[nodiscard]] auto Intersects(const Ray& ray, float& t_hit) const -> bool
@@ -140,6 +148,18 @@ struct BoundingSphere
 
   [[nodiscard]] auto IsValid() const -> bool { return Radius > 0.0F; }
 
+  // Sphere-AABB test against the closest point of the box
+  [[nodiscard]] auto Overlaps(const AABB& aabb) const -> bool
+  {
+    if (!aabb.IsValid()) {
+      return false;
+    }
+    const linalg::Vec3 closest =
+        linalg::min(linalg::max(Center, aabb.Min), aabb.Max);
+    const linalg::Vec3 delta = closest - Center;
+    return linalg::dot(delta, delta) <= Radius * Radius;
+  }
+
   [[nodiscard]] static auto FromAABB(const AABB& aabb) -> BoundingSphere
   {
     if (!aabb.IsValid()) {
@@ -0,0 +1,173 @@
+#ifndef RENDERER_MODEL_GEOMETRYPOOL_HPP
+#define RENDERER_MODEL_GEOMETRYPOOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Renderer/Model/Vertex.hpp"
+
+class GeometryPool;
+class RHIBuffer;
+class RHIDevice;
+
+// First-fit free list over a range of elements. Freed ranges are merged
+// with their free neighbours, so space released in any order coalesces back
+// into the largest possible blocks. Live ranges are never moved: meshes bake
+// their offsets into their submeshes, so coalescing is the only
+// defragmentation.
+class FreeListAllocator
+{
+public:
+  explicit FreeListAllocator(uint32_t capacity);
+
+  [[nodiscard]] auto Allocate(uint32_t count) -> std::optional<uint32_t>;
+  void Free(uint32_t offset, uint32_t count);
+
+  [[nodiscard]] auto GetCapacity() const -> uint32_t { return m_Capacity; }
+  [[nodiscard]] auto GetUsed() const -> uint32_t { return m_Used; }
+  [[nodiscard]] auto GetLargestFreeBlock() const -> uint32_t;
+  [[nodiscard]] auto GetFreeBlockCount() const -> size_t
+  {
+    return m_FreeBlocks.size();
+  }
+
+private:
+  struct Block
+  {
+    uint32_t Offset {0};
+    uint32_t Count {0};
+  };
+
+  // Sorted by offset, never adjacent to each other
+  std::vector<Block> m_FreeBlocks;
+  uint32_t m_Capacity;
+  uint32_t m_Used {0};
+};
+
+// Vertex and index range of one mesh inside a pool page. Offsets are in
+// elements, not bytes.
+struct GeometryRange
+{
+  uint32_t Page {0};
+  uint32_t FirstVertex {0};
+  uint32_t VertexCount {0};
+  uint32_t FirstIndex {0};
+  uint32_t IndexCount {0};
+};
+
+// Owns a range of a GeometryPool and returns it when destroyed. An
+// allocation that outlives its pool is detached: it releases nothing and
+// has no buffers.
+class GeometryAllocation
+{
+public:
+  GeometryAllocation() = default;
+  GeometryAllocation(GeometryPool& pool, const GeometryRange& range);
+  ~GeometryAllocation();
+
+  GeometryAllocation(const GeometryAllocation&) = delete;
+  GeometryAllocation(GeometryAllocation&& other) noexcept;
+  auto operator=(const GeometryAllocation&) -> GeometryAllocation& = delete;
+  auto operator=(GeometryAllocation&& other) noexcept -> GeometryAllocation&;
+
+  void Reset();
+
+  [[nodiscard]] auto IsValid() const -> bool { return get_pool() != nullptr; }
+  [[nodiscard]] auto GetRange() const -> const GeometryRange&
+  {
+    return m_Range;
+  }
+  [[nodiscard]] auto GetVertexBuffer() const -> RHIBuffer*;
+  [[nodiscard]] auto GetIndexBuffer() const -> RHIBuffer*;
+
+private:
+  [[nodiscard]] auto get_pool() const -> GeometryPool*
+  {
+    return m_Pool ? *m_Pool : nullptr;
+  }
+
+  // Shared with the pool, which clears it when it is destroyed
+  std::shared_ptr<GeometryPool*> m_Pool;
+  GeometryRange m_Range {};
+};
+
+// Shared vertex and index storage for meshes.
+//
+// Geometry lives in a few large pages, each a vertex buffer plus an index
+// buffer, instead of one buffer pair per mesh. Meshes in the same page share
+// their bindings, so a sorted scene only rebinds geometry when it crosses a
+// page. Pages live in device-local memory and are filled through
+// RHIDevice::UploadBuffer(). Indices are stored as authored; draws add
+// FirstVertex as the vertex offset.
+//
+// A new page is added when no existing page has room for both ranges of a
+// request. Requests larger than the page capacity get a page of their own.
+// Pages that become empty are released, except the first one.
+class GeometryPool
+{
+public:
+  static constexpr uint32_t DEFAULT_PAGE_VERTICES = 1U << 19;
+  static constexpr uint32_t DEFAULT_PAGE_INDICES = 1U << 21;
+
+  explicit GeometryPool(RHIDevice& device,
+                        uint32_t page_vertices = DEFAULT_PAGE_VERTICES,
+                        uint32_t page_indices = DEFAULT_PAGE_INDICES);
+  ~GeometryPool();
+
+  GeometryPool(const GeometryPool&) = delete;
+  GeometryPool(GeometryPool&&) = delete;
+  auto operator=(const GeometryPool&) -> GeometryPool& = delete;
+  auto operator=(GeometryPool&&) -> GeometryPool& = delete;
+
+  // Reserves space for the data and uploads it
+  [[nodiscard]] auto Allocate(std::span<const Vertex> vertices,
+                              std::span<const uint32_t> indices)
+      -> GeometryAllocation;
+
+  [[nodiscard]] auto GetVertexBuffer(uint32_t page) const -> RHIBuffer*;
+  [[nodiscard]] auto GetIndexBuffer(uint32_t page) const -> RHIBuffer*;
+
+  [[nodiscard]] auto GetPageCount() const -> size_t;
+  [[nodiscard]] auto GetAllocationCount() const -> size_t
+  {
+    return m_AllocationCount;
+  }
+  [[nodiscard]] auto GetUsedVertices() const -> size_t;
+  [[nodiscard]] auto GetUsedIndices() const -> size_t;
+  // Free ranges across all pages; more blocks means more fragmentation
+  [[nodiscard]] auto GetFreeBlockCount() const -> size_t;
+
+private:
+  friend class GeometryAllocation;
+
+  struct Page
+  {
+    std::unique_ptr<RHIBuffer> VertexBuffer;
+    std::unique_ptr<RHIBuffer> IndexBuffer;
+    FreeListAllocator Vertices;
+    FreeListAllocator Indices;
+  };
+
+  void free_range(const GeometryRange& range);
+  auto try_allocate(Page& page,
+                    uint32_t vertex_count,
+                    uint32_t index_count,
+                    GeometryRange& range) -> bool;
+  auto add_page(uint32_t min_vertices, uint32_t min_indices) -> uint32_t;
+
+  RHIDevice& m_Device;
+  uint32_t m_PageVertices;
+  uint32_t m_PageIndices;
+  // Released pages leave a null entry so page indices stay stable
+  std::vector<std::unique_ptr<Page>> m_Pages;
+  size_t m_AllocationCount {0};
+  // Handed to every allocation; points back at the pool until it is
+  // destroyed
+  std::shared_ptr<GeometryPool*> m_Handle;
+};
+
+#endif
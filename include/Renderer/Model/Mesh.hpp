@@ -7,12 +7,15 @@
 #include <vector>
 
 #include "Renderer/Model/BoundingVolume.hpp"
+#include "Renderer/Model/GeometryPool.hpp"
 #include "Renderer/Model/Vertex.hpp"
 #include "Renderer/RHI/RHIVertexLayout.hpp"
 
 class RHIBuffer;
 class RHIDevice;
 
+// Offsets are relative to the mesh's own data until its buffers come from
+// a GeometryPool; from then on they address the shared pool page directly.
 struct SubMesh
 {
   uint32_t IndexOffset {0};
@@ -38,7 +41,7 @@ public:
   void SetVertices(std::vector<Vertex> vertices);
   void SetIndices(std::vector<uint32_t> indices);
 
-  // Add submesh with explicit parameters
+  // Add submesh with explicit parameters, offsets relative to this mesh
   void AddSubMesh(const SubMesh& submesh);
   void AddSubMesh(uint32_t index_offset,
                   uint32_t index_count,
@@ -49,6 +52,8 @@ public:
 
   // Create GPU buffers (must be called before rendering)
   void CreateBuffers(RHIDevice& device);
+  // Place vertex and index data in shared pool pages instead
+  void CreateBuffers(GeometryPool& pool);
   void DestroyBuffers();
 
   // Getters
@@ -63,12 +68,13 @@ public:
   [[nodiscard]] auto GetVertexCount() const -> uint32_t;
   [[nodiscard]] auto GetIndexCount() const -> uint32_t;
   [[nodiscard]] auto AreBuffersCreated() const -> bool;
+  [[nodiscard]] auto IsPooled() const -> bool;
 
   // Access to CPU-side data (available before CreateBuffers or if retained)
   [[nodiscard]] auto GetVertices() const -> const std::vector<Vertex>&;
   [[nodiscard]] auto GetIndices() const -> const std::vector<uint32_t>&;
 
-  // Compute mesh bounds from vertex data
+  // Compute mesh and per-submesh bounds from vertex data
   void ComputeBounds();
 
   // Compute tangents if not already present
@@ -78,6 +84,14 @@ public:
   [[nodiscard]] auto GetId() const -> uint64_t;
 
 private:
+  // Bounds of the vertices referenced by a submesh's index range
+  [[nodiscard]] auto compute_submesh_bounds(const SubMesh& submesh) const
+      -> AABB;
+  // Moves submesh offsets between mesh-local and pool-page space
+  void rebase_submeshes(const GeometryRange& from, const GeometryRange& to);
+  [[nodiscard]] auto get_base_vertex() const -> uint32_t;
+  [[nodiscard]] auto get_base_index() const -> uint32_t;
+
   std::string m_Name {"Unnamed"};
 
   std::vector<Vertex> m_Vertices;
@@ -89,6 +103,7 @@ private:
 
   std::unique_ptr<RHIBuffer> m_VertexBuffer;
   std::unique_ptr<RHIBuffer> m_IndexBuffer;
+  GeometryAllocation m_Geometry;
 
   uint64_t m_Id {0};
   bool m_BuffersCreated {false};
@@ -7,6 +7,7 @@
 
 #include "Renderer/Model/BoundingVolume.hpp"
 
+class GeometryPool;
 class Mesh;
 class Material;
 class RHIDevice;
@@ -31,13 +32,15 @@ public:
   void AddMesh(std::unique_ptr<Mesh> mesh);
   void AddMaterial(std::unique_ptr<Material> material);
 
-  // Create all GPU resources
+  // Create all GPU resources. Mesh data goes into geometry_pool when one is
+  // given, otherwise every mesh gets buffers of its own.
   void CreateResources(
       RHIDevice& device,
       const std::shared_ptr<RHIDescriptorSetLayout>& material_layout,
       RHISampler* default_sampler,
       RHITexture* default_texture,
-      RHITexture* default_normal);
+      RHITexture* default_normal,
+      GeometryPool* geometry_pool = nullptr);
 
   void DestroyResources();
 
@@ -0,0 +1,46 @@
+#ifndef RENDERER_RHI_NULL_NULLBUFFER_HPP
+#define RENDERER_RHI_NULL_NULLBUFFER_HPP
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "Renderer/RHI/RHIBuffer.hpp"
+
+class NullBuffer final : public RHIBuffer
+{
+public:
+  explicit NullBuffer(const BufferDesc& desc);
+
+  NullBuffer(const NullBuffer&) = delete;
+  NullBuffer(NullBuffer&&) = delete;
+  auto operator=(const NullBuffer&) -> NullBuffer& = delete;
+  auto operator=(NullBuffer&&) -> NullBuffer& = delete;
+  ~NullBuffer() override = default;
+
+  [[nodiscard]] auto Map() -> void* override;
+  void Unmap() override;
+  void Upload(const void* data, size_t size, size_t offset) override;
+  void Flush(size_t offset, size_t size) override;
+  [[nodiscard]] auto GetSize() const -> size_t override;
+
+  [[nodiscard]] auto IsPersistentlyMapped() const -> bool override
+  {
+    return m_Persistent;
+  }
+
+  [[nodiscard]] auto GetUsage() const -> BufferUsage { return m_Usage; }
+
+  [[nodiscard]] auto GetData() const -> std::span<const std::byte>
+  {
+    return m_Data;
+  }
+
+private:
+  std::vector<std::byte> m_Data;
+  BufferUsage m_Usage {BufferUsage::Vertex};
+  bool m_Persistent {false};
+  bool m_CPUVisible {true};
+};
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef RENDERER_RHI_NULL_NULLCOMMANDBUFFER_HPP
+#define RENDERER_RHI_NULL_NULLCOMMANDBUFFER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Renderer/RHI/RHICommandBuffer.hpp"
+#include "Renderer/RHI/RHIVertexLayout.hpp"
+#include "Renderer/RHI/RenderPassInfo.hpp"
+
+enum class NullCommandType : uint8_t
+{
+  BeginRenderPass,
+  EndRenderPass,
+  Barrier,
+  BindShaders,
+  BindVertexBuffer,
+  BindIndexBuffer,
+  SetVertexInput,
+  SetPrimitiveTopology,
+  SetPolygonMode,
+  BindDescriptorSet,
+  Draw,
+  DrawIndexed,
+  DrawIndexedIndirect,
+  DrawIndexedIndirectCount,
+  Count
+};
+
+// One recorded RHICommandBuffer call. Args hold the integer parameters in
+// declaration order; Object/SecondaryObject hold the resources involved.
+//
+//   BeginRenderPass      Object = RenderTarget, Args = {width, height,
+//                        color attachment count, has depth}
+//   Barrier              Args = {first barrier, count}; see GetBarriers()
+//   BindShaders          Object = vertex, SecondaryObject = fragment
+//   BindVertexBuffer     Object = buffer, Args = {binding}
+//   BindIndexBuffer      Object = buffer
+//   SetVertexInput       Args = {stride, attribute count}
+//   SetPrimitiveTopology Args = {topology}
+//   SetPolygonMode       Args = {mode}
+//   BindDescriptorSet    Object = set, SecondaryObject = layout,
+//                        Args = {set index, first dynamic offset, count}
+//   Draw                 Args = {vertex count, instance count, first vertex,
+//                        first instance}
+//   DrawIndexed          Args = {index count, instance count, first index,
+//                        vertex offset (bit cast), first instance}
+//   DrawIndexedIndirect  Object = args buffer, Args = {offset, draw count,
+//                        stride}
+//   DrawIndexedIndirectCount
+//                        Object = args buffer, SecondaryObject = count
+//                        buffer, Args = {offset, max draw count, stride,
+//                        count offset}
+struct NullCommand
+{
+  NullCommandType Type {NullCommandType::Draw};
+  std::array<uint32_t, 5> Args {};
+  const void* Object {nullptr};
+  const void* SecondaryObject {nullptr};
+};
+
+class NullCommandBuffer final : public RHICommandBuffer
+{
+public:
+  NullCommandBuffer() = default;
+  NullCommandBuffer(const NullCommandBuffer&) = delete;
+  NullCommandBuffer(NullCommandBuffer&&) = delete;
+  auto operator=(const NullCommandBuffer&) -> NullCommandBuffer& = delete;
+  auto operator=(NullCommandBuffer&&) -> NullCommandBuffer& = delete;
+  ~NullCommandBuffer() override = default;
+
+  // Null-specific lifecycle methods. Begin() clears the previous recording
+  // but keeps its storage, so steady-state frames do not allocate.
+  void Begin();
+  void End();
+
+  void BeginRenderPass(const RenderPassInfo& info) override;
+  void EndRenderPass() override;
+  void Barrier(std::span<const TextureBarrier> barriers) override;
+
+  void BindShaders(const RHIShaderModule* vertex_shader,
+                   const RHIShaderModule* fragment_shader) override;
+  void BindVertexBuffer(const RHIBuffer& buffer, uint32_t binding) override;
+  void BindIndexBuffer(const RHIBuffer& buffer) override;
+  void SetVertexInput(const VertexInputLayout& layout) override;
+  void SetPrimitiveTopology(PrimitiveTopology topology) override;
+  void SetPolygonMode(PolygonMode mode) override;
+  void BindDescriptorSet(
+      uint32_t set_index,
+      const RHIDescriptorSet& descriptor_set,
+      const RHIPipelineLayout& layout,
+      std::span<const uint32_t> dynamic_offsets = {}) override;
+  void Draw(uint32_t vertex_count,
+            uint32_t instance_count,
+            uint32_t first_vertex,
+            uint32_t first_instance) override;
+  void DrawIndexed(uint32_t index_count,
+                   uint32_t instance_count,
+                   uint32_t first_index,
+                   int32_t vertex_offset,
+                   uint32_t first_instance) override;
+  void DrawIndexedIndirect(
+      const RHIBuffer& args_buffer,
+      size_t offset,
+      uint32_t draw_count,
+      uint32_t stride = sizeof(DrawIndexedIndirectCommand)) override;
+  void DrawIndexedIndirectCount(
+      const RHIBuffer& args_buffer,
+      size_t offset,
+      const RHIBuffer& count_buffer,
+      size_t count_offset,
+      uint32_t max_draw_count,
+      uint32_t stride = sizeof(DrawIndexedIndirectCommand)) override;
+
+  // Inspection
+  [[nodiscard]] auto GetCommands() const -> std::span<const NullCommand>
+  {
+    return m_Commands;
+  }
+
+  [[nodiscard]] auto GetDynamicOffsets(const NullCommand& command) const
+      -> std::span<const uint32_t>;
+  [[nodiscard]] auto GetBarriers(const NullCommand& command) const
+      -> std::span<const TextureBarrier>;
+
+  [[nodiscard]] auto GetCommandCount(NullCommandType type) const -> size_t
+  {
+    return m_CommandCounts.at(static_cast<size_t>(type));
+  }
+
+  [[nodiscard]] auto GetDrawCount() const -> size_t
+  {
+    return GetCommandCount(NullCommandType::Draw)
+        + GetCommandCount(NullCommandType::DrawIndexed)
+        + GetCommandCount(NullCommandType::DrawIndexedIndirect)
+        + GetCommandCount(NullCommandType::DrawIndexedIndirectCount);
+  }
+
+  [[nodiscard]] auto IsRecording() const -> bool { return m_Recording; }
+
+  [[nodiscard]] auto IsInRenderPass() const -> bool { return m_InRenderPass; }
+
+private:
+  auto record(NullCommandType type) -> NullCommand&;
+
+  std::vector<NullCommand> m_Commands;
+  std::vector<uint32_t> m_DynamicOffsets;
+  std::vector<TextureBarrier> m_Barriers;
+  std::array<size_t, static_cast<size_t>(NullCommandType::Count)>
+      m_CommandCounts {};
+  bool m_Recording {false};
+  bool m_InRenderPass {false};
+};
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef RENDERER_RHI_NULL_NULLDESCRIPTORSET_HPP
+#define RENDERER_RHI_NULL_NULLDESCRIPTORSET_HPP
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include "Renderer/RHI/RHIDescriptorSet.hpp"
+
+class NullDescriptorSetLayout : public RHIDescriptorSetLayout
+{
+public:
+  explicit NullDescriptorSetLayout(const DescriptorSetLayoutDesc& desc);
+
+  [[nodiscard]] auto GetBindings() const
+      -> const std::vector<DescriptorBinding>&;
+
+private:
+  std::vector<DescriptorBinding> m_Bindings;
+};
+
+struct NullDescriptorWrite
+{
+  const RHIBuffer* Buffer {nullptr};
+  size_t Offset {0};
+  size_t Range {0};
+  const RHITexture* Texture {nullptr};
+  const RHISampler* Sampler {nullptr};
+};
+
+class NullDescriptorSet : public RHIDescriptorSet
+{
+public:
+  explicit NullDescriptorSet(
+      const std::shared_ptr<RHIDescriptorSetLayout>& layout);
+
+  void WriteBuffer(uint32_t binding,
+                   RHIBuffer* buffer,
+                   size_t offset,
+                   size_t range) override;
+
+  void WriteCombinedImageSampler(uint32_t binding,
+                                 RHITexture* texture,
+                                 RHISampler* sampler) override;
+
+  [[nodiscard]] auto GetWrite(uint32_t binding) const
+      -> const NullDescriptorWrite*;
+
+private:
+  std::shared_ptr<RHIDescriptorSetLayout> m_Layout;
+  std::unordered_map<uint32_t, NullDescriptorWrite> m_Writes;
+};
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef RENDERER_RHI_NULL_NULLDEVICE_HPP
+#define RENDERER_RHI_NULL_NULLDEVICE_HPP
+
+#include <cstdint>
+#include <memory>
+
+#include "Renderer/RHI/Null/NullCommandBuffer.hpp"
+#include "Renderer/RHI/Null/NullSwapchain.hpp"
+#include "Renderer/RHI/RHIDevice.hpp"
+
+struct RendererConfig;
+
+// Headless device: every resource lives in plain host memory and the command
+// buffer records calls instead of submitting them. Used to profile and test
+// the CPU side of rendering on machines without a GPU or display.
+class NullDevice final : public RHIDevice
+{
+  static constexpr uint32_t FRAMES_IN_FLIGHT = 3;
+
+public:
+  NullDevice() = default;
+  NullDevice(const NullDevice&) = delete;
+  NullDevice(NullDevice&&) = delete;
+  auto operator=(const NullDevice&) -> NullDevice& = delete;
+  auto operator=(NullDevice&&) -> NullDevice& = delete;
+  ~NullDevice() override = default;
+
+  // The window may be null; the Null device never presents to it.
+  void Init(const RendererConfig& config, void* window) override;
+  void CreateSwapchain(uint32_t width, uint32_t height) override;
+  void Destroy() override;
+
+  void BeginFrame() override;
+  void EndFrame() override;
+  void Present() override;
+  void WaitIdle() override;
+
+  // Mirrors the Vulkan frame ring so per-frame code paths are exercised;
+  // the "GPU" finishes instantly, so no slot is ever waited on
+  [[nodiscard]] auto GetFramesInFlight() const -> uint32_t override
+  {
+    return FRAMES_IN_FLIGHT;
+  }
+  [[nodiscard]] auto GetFrameIndex() const -> uint32_t override
+  {
+    return static_cast<uint32_t>(m_FrameCount % FRAMES_IN_FLIGHT);
+  }
+
+  [[nodiscard]] auto GetSwapchain() const -> RHISwapchain* override;
+  [[nodiscard]] auto GetCurrentCommandBuffer() -> RHICommandBuffer* override;
+
+  [[nodiscard]] auto CreateRenderTarget(const RenderTargetDesc& desc)
+      -> std::unique_ptr<RHIRenderTarget> override;
+  [[nodiscard]] auto CreateBuffer(const BufferDesc& desc)
+      -> std::unique_ptr<RHIBuffer> override;
+  [[nodiscard]] auto CreateTexture(const TextureDesc& desc)
+      -> std::unique_ptr<RHITexture> override;
+  [[nodiscard]] auto CreateSampler(const SamplerDesc& desc)
+      -> std::unique_ptr<RHISampler> override;
+  [[nodiscard]] auto CreateShaderModule(const ShaderModuleDesc& desc)
+      -> std::unique_ptr<RHIShaderModule> override;
+  [[nodiscard]] auto CreateGraphicsPipeline(const GraphicsPipelineDesc& desc)
+      -> std::unique_ptr<RHIGraphicsPipeline> override;
+  // Copies land immediately; submissions are still counted per batch so
+  // upload batching can be checked without a GPU
+  void UploadBuffer(RHIBuffer& buffer,
+                    const void* data,
+                    size_t size,
+                    size_t offset) override;
+  void UploadTexture(RHITexture& texture,
+                     const void* data,
+                     size_t size) override;
+  void FlushUploads() override;
+  [[nodiscard]] auto GetUploadStats() const -> UploadStats override
+  {
+    return m_UploadStats;
+  }
+
+  [[nodiscard]] auto CreateDescriptorSetLayout(
+      const DescriptorSetLayoutDesc& desc)
+      -> std::shared_ptr<RHIDescriptorSetLayout> override;
+  [[nodiscard]] auto CreateDescriptorSet(
+      const std::shared_ptr<RHIDescriptorSetLayout>& layout)
+      -> std::unique_ptr<RHIDescriptorSet> override;
+  [[nodiscard]] auto CreatePipelineLayout(
+      const std::vector<std::shared_ptr<RHIDescriptorSetLayout>>& set_layouts)
+      -> std::shared_ptr<RHIPipelineLayout> override;
+
+  [[nodiscard]] auto GetNullCommandBuffer() -> NullCommandBuffer*
+  {
+    return m_CommandBuffer.get();
+  }
+
+  [[nodiscard]] auto GetWindow() const -> void* { return m_Window; }
+
+  [[nodiscard]] auto GetFrameCount() const -> uint64_t { return m_FrameCount; }
+
+  // Emulates GPUs without drawIndirectFirstInstance (supported by default)
+  void SetIndirectFirstInstance(bool supported)
+  {
+    m_IndirectFirstInstance = supported;
+  }
+  [[nodiscard]] auto SupportsIndirectFirstInstance() const -> bool override
+  {
+    return m_IndirectFirstInstance;
+  }
+
+private:
+  std::unique_ptr<NullSwapchain> m_Swapchain;
+  std::unique_ptr<NullCommandBuffer> m_CommandBuffer;
+  void* m_Window {nullptr};
+  uint64_t m_FrameCount {0};
+  UploadStats m_UploadStats;
+  uint32_t m_PendingUploads {0};
+  bool m_Initialized {false};
+  bool m_IndirectFirstInstance {true};
+};
+
+#endif
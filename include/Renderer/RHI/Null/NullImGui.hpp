@@ -0,0 +1,37 @@
+#ifndef RENDERER_RHI_NULL_NULLIMGUI_HPP
+#define RENDERER_RHI_NULL_NULLIMGUI_HPP
+
+#include "UI/RHIImGui.hpp"
+
+class NullDevice;
+
+/**
+ * @brief Headless ImGui backend for the Null device.
+ *
+ * Builds UI every frame like the real backends so panel code is exercised,
+ * but discards the resulting draw data instead of rendering it.
+ */
+class NullImGui final : public RHIImGui
+{
+public:
+  explicit NullImGui(NullDevice& device);
+  ~NullImGui() override = default;
+
+  NullImGui(const NullImGui&) = delete;
+  NullImGui(NullImGui&&) = delete;
+  auto operator=(const NullImGui&) -> NullImGui& = delete;
+  auto operator=(NullImGui&&) -> NullImGui& = delete;
+
+  void Init(Window& window) override;
+  void Shutdown() override;
+  void BeginFrame() override;
+  void EndFrame() override;
+
+  auto RegisterTexture(RHITexture* texture) -> void* override;
+
+private:
+  NullDevice& m_Device;
+  bool m_HasPlatformBackend {false};
+};
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef RENDERER_RHI_NULL_NULLPIPELINELAYOUT_HPP
+#define RENDERER_RHI_NULL_NULLPIPELINELAYOUT_HPP
+
+#include <memory>
+#include <vector>
+
+#include "Renderer/RHI/RHIPipeline.hpp"
+
+class RHIDescriptorSetLayout;
+
+class NullPipelineLayout : public RHIPipelineLayout
+{
+public:
+  explicit NullPipelineLayout(
+      const std::vector<std::shared_ptr<RHIDescriptorSetLayout>>& set_layouts)
+      : m_SetLayouts(set_layouts)
+  {
+  }
+
+  [[nodiscard]] auto GetSetLayouts() const
+      -> const std::vector<std::shared_ptr<RHIDescriptorSetLayout>>&
+  {
+    return m_SetLayouts;
+  }
+
+private:
+  std::vector<std::shared_ptr<RHIDescriptorSetLayout>> m_SetLayouts;
+};
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef RENDERER_RHI_NULL_NULLRENDERTARGET_HPP
+#define RENDERER_RHI_NULL_NULLRENDERTARGET_HPP
+
+#include <memory>
+#include <vector>
+
+#include "Renderer/RHI/RHIRenderTarget.hpp"
+
+class NullTexture;
+
+class NullRenderTarget final : public RHIRenderTarget
+{
+public:
+  explicit NullRenderTarget(const RenderTargetDesc& desc);
+
+  NullRenderTarget(const NullRenderTarget&) = delete;
+  NullRenderTarget(NullRenderTarget&&) = delete;
+  auto operator=(const NullRenderTarget&) -> NullRenderTarget& = delete;
+  auto operator=(NullRenderTarget&&) -> NullRenderTarget& = delete;
+  ~NullRenderTarget() override;
+
+  [[nodiscard]] auto GetWidth() const -> uint32_t override;
+  [[nodiscard]] auto GetHeight() const -> uint32_t override;
+  [[nodiscard]] auto GetColorTexture(size_t index = 0) -> RHITexture* override;
+  [[nodiscard]] auto GetColorTextureCount() const -> size_t override;
+  [[nodiscard]] auto GetDepthTexture() -> RHITexture* override;
+
+private:
+  uint32_t m_Width {0};
+  uint32_t m_Height {0};
+  std::vector<std::unique_ptr<NullTexture>> m_ColorTextures;
+  std::unique_ptr<NullTexture> m_DepthTexture;
+};
+
+#endif
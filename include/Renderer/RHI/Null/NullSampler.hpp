@@ -0,0 +1,26 @@
+#ifndef RENDERER_RHI_NULL_NULLSAMPLER_HPP
+#define RENDERER_RHI_NULL_NULLSAMPLER_HPP
+
+#include "Renderer/RHI/RHISampler.hpp"
+
+class NullSampler final : public RHISampler
+{
+public:
+  explicit NullSampler(const SamplerDesc& desc)
+      : m_Desc(desc)
+  {
+  }
+
+  NullSampler(const NullSampler&) = delete;
+  NullSampler(NullSampler&&) = delete;
+  auto operator=(const NullSampler&) -> NullSampler& = delete;
+  auto operator=(NullSampler&&) -> NullSampler& = delete;
+  ~NullSampler() override = default;
+
+  [[nodiscard]] auto GetDesc() const -> const SamplerDesc& { return m_Desc; }
+
+private:
+  SamplerDesc m_Desc;
+};
+
+#endif
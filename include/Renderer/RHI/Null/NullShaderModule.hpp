@@ -0,0 +1,34 @@
+#ifndef RENDERER_RHI_NULL_NULLSHADERMODULE_HPP
+#define RENDERER_RHI_NULL_NULLSHADERMODULE_HPP
+
+#include <string>
+
+#include "Renderer/RHI/RHIShaderModule.hpp"
+
+class NullShaderModule final : public RHIShaderModule
+{
+public:
+  explicit NullShaderModule(const ShaderModuleDesc& desc);
+
+  NullShaderModule(const NullShaderModule&) = delete;
+  NullShaderModule(NullShaderModule&&) = delete;
+  auto operator=(const NullShaderModule&) -> NullShaderModule& = delete;
+  auto operator=(NullShaderModule&&) -> NullShaderModule& = delete;
+  ~NullShaderModule() override = default;
+
+  [[nodiscard]] auto GetStage() const -> ShaderStage override
+  {
+    return m_Stage;
+  }
+
+  [[nodiscard]] auto GetEntryPoint() const -> const std::string&
+  {
+    return m_EntryPoint;
+  }
+
+private:
+  ShaderStage m_Stage {ShaderStage::Vertex};
+  std::string m_EntryPoint;
+};
+
+#endif
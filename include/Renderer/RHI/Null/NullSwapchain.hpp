@@ -0,0 +1,20 @@
+#ifndef RENDERER_RHI_NULL_NULLSWAPCHAIN_HPP
+#define RENDERER_RHI_NULL_NULLSWAPCHAIN_HPP
+
+#include "Renderer/RHI/RHISwapchain.hpp"
+
+class NullSwapchain final : public RHISwapchain
+{
+public:
+  NullSwapchain(uint32_t width, uint32_t height);
+
+  NullSwapchain(const NullSwapchain&) = delete;
+  NullSwapchain(NullSwapchain&&) = delete;
+  auto operator=(const NullSwapchain&) -> NullSwapchain& = delete;
+  auto operator=(NullSwapchain&&) -> NullSwapchain& = delete;
+  ~NullSwapchain() override = default;
+
+  void Resize(uint32_t width, uint32_t height) override;
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef RENDERER_RHI_NULL_NULLTEXTURE_HPP
+#define RENDERER_RHI_NULL_NULLTEXTURE_HPP
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "Renderer/RHI/RHITexture.hpp"
+
+class NullTexture final : public RHITexture
+{
+public:
+  explicit NullTexture(const TextureDesc& desc);
+
+  NullTexture(const NullTexture&) = delete;
+  NullTexture(NullTexture&&) = delete;
+  auto operator=(const NullTexture&) -> NullTexture& = delete;
+  auto operator=(NullTexture&&) -> NullTexture& = delete;
+  ~NullTexture() override = default;
+
+  [[nodiscard]] auto GetWidth() const -> uint32_t override;
+  [[nodiscard]] auto GetHeight() const -> uint32_t override;
+  [[nodiscard]] auto GetFormat() const -> TextureFormat override;
+  void Upload(const void* data, size_t size) override;
+
+  [[nodiscard]] auto GetData() const -> std::span<const std::byte>
+  {
+    return m_Data;
+  }
+
+private:
+  std::vector<std::byte> m_Data;
+  uint32_t m_Width {0};
+  uint32_t m_Height {0};
+  TextureFormat m_Format {TextureFormat::RGBA8Unorm};
+};
+
+#endif
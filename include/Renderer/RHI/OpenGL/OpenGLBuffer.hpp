@@ -1,14 +1,22 @@
 #ifndef RENDERER_RHI_OPENGL_OPENGLBUFFER_HPP
 #define RENDERER_RHI_OPENGL_OPENGLBUFFER_HPP
 
+#include <memory>
+
 #include <glad/glad.h>
 
 #include "Renderer/RHI/RHIBuffer.hpp"
 
+class OpenGLVertexArrayCache;
+
 class OpenGLBuffer final : public RHIBuffer
 {
 public:
-  explicit OpenGLBuffer(const BufferDesc& desc);
+  // Vertex arrays referencing this buffer are dropped from vertex_array_cache
+  // when the buffer is destroyed
+  explicit OpenGLBuffer(
+      const BufferDesc& desc,
+      std::weak_ptr<OpenGLVertexArrayCache> vertex_array_cache = {});
 
   OpenGLBuffer(const OpenGLBuffer&) = delete;
   OpenGLBuffer(OpenGLBuffer&&) = delete;
@@ -19,17 +27,27 @@ public:
   [[nodiscard]] auto Map() -> void* override;
   void Unmap() override;
   void Upload(const void* data, size_t size, size_t offset) override;
+  void Flush(size_t offset, size_t size) override;
   [[nodiscard]] auto GetSize() const -> size_t override;
 
+  [[nodiscard]] auto IsPersistentlyMapped() const -> bool override
+  {
+    return m_Persistent;
+  }
+
   [[nodiscard]] auto GetGLBuffer() const -> GLuint { return m_Buffer; }
 
   [[nodiscard]] auto GetTarget() const -> GLenum { return m_Target; }
 
 private:
+  std::weak_ptr<OpenGLVertexArrayCache> m_VertexArrayCache;
   GLuint m_Buffer {0};
   GLenum m_Target {GL_ARRAY_BUFFER};
   size_t m_Size {0};
   bool m_Mapped {false};
+  bool m_Persistent {false};
+  bool m_DeviceLocal {false};
+  void* m_MappedPtr {nullptr};
 };
 
 #endif
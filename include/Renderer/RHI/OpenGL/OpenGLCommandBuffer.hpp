@@ -1,18 +1,23 @@
 #ifndef RENDERER_RHI_OPENGL_OPENGLCOMMANDBUFFER_HPP
 #define RENDERER_RHI_OPENGL_OPENGLCOMMANDBUFFER_HPP
 
+#include <cstdint>
 #include <span>
 
 #include <glad/glad.h>
 
 #include "Renderer/RHI/RHICommandBuffer.hpp"
 #include "Renderer/RHI/RHIVertexLayout.hpp"
+#include "Renderer/RHI/OpenGL/OpenGLVertexArrayCache.hpp"
 #include "Renderer/RHI/RenderPassInfo.hpp"
 
+class OpenGLProgramCache;
+
 class OpenGLCommandBuffer final : public RHICommandBuffer
 {
 public:
-  OpenGLCommandBuffer() = default;
+  OpenGLCommandBuffer(OpenGLProgramCache& program_cache,
+                      OpenGLVertexArrayCache& vertex_array_cache);
   OpenGLCommandBuffer(const OpenGLCommandBuffer&) = delete;
   OpenGLCommandBuffer(OpenGLCommandBuffer&&) = delete;
   auto operator=(const OpenGLCommandBuffer&) -> OpenGLCommandBuffer& = delete;
@@ -48,18 +53,34 @@ public:
                    uint32_t first_index,
                    int32_t vertex_offset,
                    uint32_t first_instance) override;
+  void DrawIndexedIndirect(
+      const RHIBuffer& args_buffer,
+      size_t offset,
+      uint32_t draw_count,
+      uint32_t stride = sizeof(DrawIndexedIndirectCommand)) override;
+  void DrawIndexedIndirectCount(
+      const RHIBuffer& args_buffer,
+      size_t offset,
+      const RHIBuffer& count_buffer,
+      size_t count_offset,
+      uint32_t max_draw_count,
+      uint32_t stride = sizeof(DrawIndexedIndirectCommand)) override;
 
 private:
+  OpenGLProgramCache& m_ProgramCache;
+  OpenGLVertexArrayCache& m_VertexArrayCache;
   bool m_Recording {false};
   RenderPassInfo m_CurrentRenderPass {};
   GLuint m_CurrentProgram {0};
-  GLuint m_VAO {0};
   GLenum m_PrimitiveMode {GL_TRIANGLES};
 
-  VertexInputLayout m_PendingLayout {};
-  bool m_HasPendingLayout {false};
+  // Layout and buffers of the next draw; the VAO matching them is looked up
+  // only after one of them changed
+  VertexArrayKey m_VertexArrayKey {};
+  bool m_VertexArrayDirty {true};
+  uint64_t m_VertexArrayGeneration {0};
 
-  void applyVertexLayout();
+  void bind_vertex_array();
 };
 
 #endif
@@ -1,9 +1,12 @@
 #ifndef RENDERER_RHI_OPENGL_OPENGLDEVICE_HPP
 #define RENDERER_RHI_OPENGL_OPENGLDEVICE_HPP
 
+#include <array>
+#include <cstdint>
 #include <memory>
 
 #include <SDL3/SDL.h>
+#include <glad/glad.h>
 
 #include "Renderer/RHI/OpenGL/OpenGLCommandBuffer.hpp"
 #include "Renderer/RHI/OpenGL/OpenGLSwapchain.hpp"
@@ -11,6 +14,8 @@
 #include "Renderer/RHI/RenderPassInfo.hpp"
 
 struct RendererConfig;
+class OpenGLProgramCache;
+class OpenGLVertexArrayCache;
 
 class OpenGLDevice final : public RHIDevice
 {
@@ -31,6 +36,17 @@ public:
   void Present() override;
   void WaitIdle() override;
 
+  // Persistently mapped buffers bypass the driver's implicit ordering, so
+  // frames are fenced and a slot is reused only once the GPU finished it
+  [[nodiscard]] auto GetFramesInFlight() const -> uint32_t override
+  {
+    return FRAMES_IN_FLIGHT;
+  }
+  [[nodiscard]] auto GetFrameIndex() const -> uint32_t override
+  {
+    return m_FrameIndex;
+  }
+
   [[nodiscard]] auto GetSwapchain() const -> RHISwapchain* override;
   [[nodiscard]] auto GetCurrentCommandBuffer() -> RHICommandBuffer* override;
 
@@ -46,6 +62,21 @@ public:
       -> std::unique_ptr<RHIShaderModule> override;
   [[nodiscard]] auto CreateGraphicsPipeline(const GraphicsPipelineDesc& desc)
       -> std::unique_ptr<RHIGraphicsPipeline> override;
+  // The driver stages buffer data itself; FlushUploads() hands the pending
+  // copies to the GPU with glFlush()
+  void UploadBuffer(RHIBuffer& buffer,
+                    const void* data,
+                    size_t size,
+                    size_t offset) override;
+  void UploadTexture(RHITexture& texture,
+                     const void* data,
+                     size_t size) override;
+  void FlushUploads() override;
+  [[nodiscard]] auto GetUploadStats() const -> UploadStats override
+  {
+    return m_UploadStats;
+  }
+
   [[nodiscard]] auto CreateDescriptorSetLayout(
       const DescriptorSetLayoutDesc& desc)
       -> std::shared_ptr<RHIDescriptorSetLayout> override;
@@ -57,10 +88,22 @@ public:
       -> std::shared_ptr<RHIPipelineLayout> override;
 
 private:
+  static constexpr uint32_t FRAMES_IN_FLIGHT = 3;
+
+  void wait_frame_fence(uint32_t index);
+
   std::unique_ptr<OpenGLSwapchain> m_Swapchain;
+  // Shared with the shader modules, which may outlive the device
+  std::shared_ptr<OpenGLProgramCache> m_ProgramCache;
+  // Shared with the buffers for the same reason
+  std::shared_ptr<OpenGLVertexArrayCache> m_VertexArrayCache;
   std::unique_ptr<OpenGLCommandBuffer> m_CommandBuffer;
   SDL_Window* m_Window {nullptr};
   SDL_GLContext m_GLContext {nullptr};
+  std::array<GLsync, FRAMES_IN_FLIGHT> m_FrameFences {};
+  uint32_t m_FrameIndex {0};
+  UploadStats m_UploadStats;
+  uint32_t m_PendingUploads {0};
   bool m_Initialized {false};
   bool m_DepthEnabled {false};
 };
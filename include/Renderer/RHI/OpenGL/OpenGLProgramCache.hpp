@@ -0,0 +1,47 @@
+#ifndef RENDERER_RHI_OPENGL_OPENGLPROGRAMCACHE_HPP
+#define RENDERER_RHI_OPENGL_OPENGLPROGRAMCACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#include <glad/glad.h>
+
+// Linked programs keyed by the pair of shader objects they were linked from.
+//
+// Linking is one of the most expensive GL operations, so each vertex and
+// fragment pair is linked once and the program is reused by every later
+// bind. Shader modules invalidate their programs when they are destroyed,
+// before GL is free to hand out their names again.
+class OpenGLProgramCache
+{
+public:
+  OpenGLProgramCache() = default;
+  ~OpenGLProgramCache();
+
+  OpenGLProgramCache(const OpenGLProgramCache&) = delete;
+  OpenGLProgramCache(OpenGLProgramCache&&) = delete;
+  auto operator=(const OpenGLProgramCache&) -> OpenGLProgramCache& = delete;
+  auto operator=(OpenGLProgramCache&&) -> OpenGLProgramCache& = delete;
+
+  // Returns the program for the pair, linking it on a miss
+  [[nodiscard]] auto GetProgram(GLuint vertex_shader, GLuint fragment_shader)
+      -> GLuint;
+  // Deletes every program linked from the shader
+  void Invalidate(GLuint shader);
+
+  [[nodiscard]] auto GetProgramCount() const -> size_t
+  {
+    return m_Programs.size();
+  }
+  [[nodiscard]] auto GetHits() const -> uint64_t { return m_Hits; }
+  [[nodiscard]] auto GetLinks() const -> uint64_t { return m_Links; }
+
+private:
+  // Vertex shader in the high half, fragment shader in the low half
+  std::unordered_map<uint64_t, GLuint> m_Programs;
+  uint64_t m_Hits {0};
+  uint64_t m_Links {0};
+};
+
+#endif
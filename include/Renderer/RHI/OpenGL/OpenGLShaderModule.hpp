@@ -1,14 +1,22 @@
 #ifndef RENDERER_RHI_OPENGL_OPENGLSHADERMODULE_HPP
 #define RENDERER_RHI_OPENGL_OPENGLSHADERMODULE_HPP
 
+#include <memory>
+
 #include <glad/glad.h>
 
 #include "Renderer/RHI/RHIShaderModule.hpp"
 
+class OpenGLProgramCache;
+
 class OpenGLShaderModule final : public RHIShaderModule
 {
 public:
-  explicit OpenGLShaderModule(const ShaderModuleDesc& desc);
+  // Programs linked from this module are dropped from program_cache when
+  // the module is destroyed
+  explicit OpenGLShaderModule(
+      const ShaderModuleDesc& desc,
+      std::weak_ptr<OpenGLProgramCache> program_cache = {});
 
   OpenGLShaderModule(const OpenGLShaderModule&) = delete;
   OpenGLShaderModule(OpenGLShaderModule&&) = delete;
@@ -24,6 +32,7 @@ public:
   [[nodiscard]] auto GetGLShader() const -> GLuint { return m_Shader; }
 
 private:
+  std::weak_ptr<OpenGLProgramCache> m_ProgramCache;
   GLuint m_Shader {0};
   ShaderStage m_Stage {ShaderStage::Vertex};
 };
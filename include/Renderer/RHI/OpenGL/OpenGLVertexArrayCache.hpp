@@ -0,0 +1,69 @@
+#ifndef RENDERER_RHI_OPENGL_OPENGLVERTEXARRAYCACHE_HPP
+#define RENDERER_RHI_OPENGL_OPENGLVERTEXARRAYCACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#include <glad/glad.h>
+
+#include "Renderer/RHI/RHIVertexLayout.hpp"
+
+struct VertexArrayKey
+{
+  VertexInputLayout Layout;
+  GLuint VertexBuffer {0};
+  GLuint IndexBuffer {0};
+
+  auto operator==(const VertexArrayKey&) const -> bool = default;
+};
+
+struct VertexArrayKeyHash
+{
+  auto operator()(const VertexArrayKey& key) const -> size_t;
+};
+
+// Vertex array objects keyed by vertex layout and the buffers bound to them.
+//
+// Each VAO is fully described once through the vertex format/binding split
+// of direct state access, so switching between meshes is a single
+// glBindVertexArray() instead of re-specifying every attribute. Buffers
+// invalidate their VAOs when they are destroyed, before GL is free to hand
+// out their names again.
+class OpenGLVertexArrayCache
+{
+public:
+  OpenGLVertexArrayCache() = default;
+  ~OpenGLVertexArrayCache();
+
+  OpenGLVertexArrayCache(const OpenGLVertexArrayCache&) = delete;
+  OpenGLVertexArrayCache(OpenGLVertexArrayCache&&) = delete;
+  auto operator=(const OpenGLVertexArrayCache&)
+      -> OpenGLVertexArrayCache& = delete;
+  auto operator=(OpenGLVertexArrayCache&&) -> OpenGLVertexArrayCache& = delete;
+
+  // Returns the VAO for the key, creating it on a miss. An empty layout
+  // without buffers gives the VAO for attribute-less draws.
+  [[nodiscard]] auto GetVertexArray(const VertexArrayKey& key) -> GLuint;
+  // Deletes every VAO referencing the buffer
+  void Invalidate(GLuint buffer);
+
+  [[nodiscard]] auto GetVertexArrayCount() const -> size_t
+  {
+    return m_VertexArrays.size();
+  }
+  [[nodiscard]] auto GetHits() const -> uint64_t { return m_Hits; }
+  [[nodiscard]] auto GetCreates() const -> uint64_t { return m_Creates; }
+  // Changes whenever VAOs are deleted, so holders of a VAO name can tell it
+  // may no longer exist
+  [[nodiscard]] auto GetGeneration() const -> uint64_t { return m_Generation; }
+
+private:
+  std::unordered_map<VertexArrayKey, GLuint, VertexArrayKeyHash>
+      m_VertexArrays;
+  uint64_t m_Hits {0};
+  uint64_t m_Creates {0};
+  uint64_t m_Generation {0};
+};
+
+#endif
@@ -10,7 +10,9 @@ enum class BufferUsage : uint8_t
   Index = 1 << 1,
   Uniform = 1 << 2,
   TransferSrc = 1 << 3,
-  TransferDst = 1 << 4
+  TransferDst = 1 << 4,
+  Indirect = 1 << 5,
+  Storage = 1 << 6
 };
 
 constexpr auto operator|(BufferUsage lhs, BufferUsage rhs) -> BufferUsage
@@ -30,6 +32,10 @@ struct BufferDesc
   size_t Size {0};
   BufferUsage Usage {BufferUsage::Vertex};
   bool CPUVisible {true};
+  // Keep a CPU-visible buffer mapped for its whole lifetime. Map() then
+  // returns the same pointer every frame and Unmap() is a no-op; writes
+  // through that pointer must be followed by Flush() for the written range.
+  bool PersistentMap {false};
 };
 
 class RHIBuffer
@@ -47,6 +53,12 @@ public:
 
   virtual void Upload(const void* data, size_t size, size_t offset) = 0;
 
+  // Make CPU writes to [offset, offset + size) of a mapped buffer visible to
+  // the GPU. A no-op for coherent memory; Upload() flushes on its own.
+  virtual void Flush(size_t offset, size_t size) = 0;
+
+  [[nodiscard]] virtual auto IsPersistentlyMapped() const -> bool = 0;
+
   [[nodiscard]] virtual auto GetSize() const -> size_t = 0;
 
 protected:
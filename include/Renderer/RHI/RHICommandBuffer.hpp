@@ -1,6 +1,7 @@
 #ifndef RENDERER_RHI_RHICOMMANDBUFFER_HPP
 #define RENDERER_RHI_RHICOMMANDBUFFER_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <span>
 
@@ -10,8 +11,48 @@
 
 class RHIBuffer;
 class RHIDescriptorSet;
+class RHITexture;
 struct RenderPassInfo;
 
+// Matches VkDrawIndexedIndirectCommand and GL's DrawElementsIndirectCommand
+struct DrawIndexedIndirectCommand
+{
+  uint32_t IndexCount {0};
+  uint32_t InstanceCount {1};
+  uint32_t FirstIndex {0};
+  int32_t VertexOffset {0};
+  uint32_t FirstInstance {0};
+};
+
+// How a texture is accessed. Decides its layout and which earlier work a
+// transition into another state has to wait for.
+enum class TextureState : uint8_t
+{
+  Undefined,  // Not accessed yet
+  ColorAttachment,
+  DepthAttachment,
+  ShaderRead,  // Sampled by fragment shaders
+  DepthRead  // Depth sampled by fragment shaders
+};
+
+struct TextureBarrier
+{
+  RHITexture* Texture {nullptr};
+  TextureState Before {TextureState::Undefined};
+  TextureState After {TextureState::Undefined};
+  // Contents need not survive, e.g. an attachment about to be cleared
+  bool Discard {false};
+};
+
+// State and binding commands requested since the command buffer began
+// recording. Filtered commands matched what was already recorded and were
+// not passed on to the API.
+struct CommandStats
+{
+  uint32_t Emitted {0};
+  uint32_t Filtered {0};
+};
+
 class RHICommandBuffer
 {
 public:
@@ -26,6 +67,10 @@ public:
   virtual void BeginRenderPass(const RenderPassInfo& info) = 0;
   virtual void EndRenderPass() = 0;
 
+  // Transitions the textures together, outside a render pass. Backends that
+  // track hazards themselves ignore it.
+  virtual void Barrier(std::span<const TextureBarrier> /*barriers*/) {}
+
   // Drawing commands
   virtual void BindShaders(const RHIShaderModule* vertex_shader,
                            const RHIShaderModule* fragment_shader) = 0;
@@ -48,6 +93,29 @@ public:
                            uint32_t first_index,
                            int32_t vertex_offset,
                            uint32_t first_instance) = 0;
+
+  // draw_count DrawIndexedIndirectCommands read from args_buffer (created
+  // with BufferUsage::Indirect), stride bytes apart starting at offset
+  virtual void DrawIndexedIndirect(
+      const RHIBuffer& args_buffer,
+      size_t offset,
+      uint32_t draw_count,
+      uint32_t stride = sizeof(DrawIndexedIndirectCommand)) = 0;
+  // As above, with the draw count read as a uint32_t from count_buffer and
+  // clamped to max_draw_count
+  virtual void DrawIndexedIndirectCount(
+      const RHIBuffer& args_buffer,
+      size_t offset,
+      const RHIBuffer& count_buffer,
+      size_t count_offset,
+      uint32_t max_draw_count,
+      uint32_t stride = sizeof(DrawIndexedIndirectCommand)) = 0;
+
+  // Backends without redundant-state filtering report nothing
+  [[nodiscard]] virtual auto GetCommandStats() const -> CommandStats
+  {
+    return {};
+  }
 };
 
 #endif
@@ -1,8 +1,10 @@
 #ifndef RENDERER_RHI_RHIDEVICE_HPP
 #define RENDERER_RHI_RHIDEVICE_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <string_view>
 #include <vector>
 
 struct RendererConfig;
@@ -25,6 +27,47 @@ struct ShaderModuleDesc;
 struct GraphicsPipelineDesc;
 struct DescriptorSetLayoutDesc;
 
+// Data written through RHIDevice::UploadBuffer() and UploadTexture() since
+// the device was created
+struct UploadStats
+{
+  uint64_t Bytes {0};
+  uint64_t Copies {0};
+  // Copies that went into textures, included in Copies
+  uint64_t TextureCopies {0};
+  // Batches of copies handed to the GPU queue
+  uint64_t Submissions {0};
+  // Host time spent staging, recording and submitting copies
+  double HostSeconds {0.0};
+
+  [[nodiscard]] auto GetThroughputMBps() const -> double
+  {
+    constexpr double BYTES_PER_MB = 1024.0 * 1024.0;
+    return (HostSeconds > 0.0)
+        ? static_cast<double>(Bytes) / BYTES_PER_MB / HostSeconds
+        : 0.0;
+  }
+};
+
+// Device memory held by one of the backend's allocation pools
+struct MemoryPoolStats
+{
+  std::string_view Name;
+  // Memory objects allocated from the driver, each shared by many resources
+  uint32_t BlockCount {0};
+  uint32_t AllocationCount {0};
+  uint64_t BlockBytes {0};
+  // Bytes bound to resources; the rest of BlockBytes is free space
+  uint64_t AllocationBytes {0};
+  // Free ranges between allocations; more ranges means more fragmentation
+  uint32_t FreeRangeCount {0};
+
+  [[nodiscard]] auto GetWastedBytes() const -> uint64_t
+  {
+    return BlockBytes - AllocationBytes;
+  }
+};
+
 class RHIDevice
 {
 public:
@@ -40,6 +83,13 @@ public:
   virtual void Present() = 0;
   virtual void WaitIdle() = 0;
 
+  // Frames the CPU may record ahead of the GPU, and the slot of the frame
+  // being recorded. Once BeginFrame() returns, the GPU has finished with
+  // everything submitted the last time this slot was used, so per-frame
+  // resources indexed by it can be overwritten.
+  [[nodiscard]] virtual auto GetFramesInFlight() const -> uint32_t = 0;
+  [[nodiscard]] virtual auto GetFrameIndex() const -> uint32_t = 0;
+
   [[nodiscard]] virtual auto GetSwapchain() const -> RHISwapchain* = 0;
   [[nodiscard]] virtual auto GetCurrentCommandBuffer() -> RHICommandBuffer* = 0;
 
@@ -58,6 +108,38 @@ public:
       const GraphicsPipelineDesc& desc)
       -> std::unique_ptr<RHIGraphicsPipeline> = 0;
 
+  // Copies data into a buffer, including buffers created without
+  // CPUVisible that the CPU cannot map. Copies are batched and submitted
+  // before the next frame is, or earlier through FlushUploads(); the source
+  // data may be released as soon as the call returns.
+  virtual void UploadBuffer(RHIBuffer& buffer,
+                            const void* data,
+                            size_t size,
+                            size_t offset) = 0;
+  // Replaces the contents of a sampled texture. Like buffer uploads, the copy
+  // is batched and does not wait for the GPU.
+  virtual void UploadTexture(RHITexture& texture,
+                             const void* data,
+                             size_t size) = 0;
+  virtual void FlushUploads() = 0;
+  [[nodiscard]] virtual auto GetUploadStats() const -> UploadStats = 0;
+
+  // One entry per memory pool. Backends whose driver places resources itself
+  // have nothing to report.
+  [[nodiscard]] virtual auto GetMemoryStats() const
+      -> std::vector<MemoryPoolStats>
+  {
+    return {};
+  }
+
+  // Whether indirect draw commands may start at a nonzero FirstInstance.
+  // Where they may not, the instance data of every indirect draw has to
+  // start at index 0.
+  [[nodiscard]] virtual auto SupportsIndirectFirstInstance() const -> bool
+  {
+    return true;
+  }
+
   // Descriptor and pipeline layout creation
   [[nodiscard]] virtual auto CreateDescriptorSetLayout(
       const DescriptorSetLayoutDesc& desc)
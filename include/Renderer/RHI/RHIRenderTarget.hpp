@@ -13,6 +13,8 @@ struct RenderTargetDesc
   std::vector<TextureFormat> ColorFormats {TextureFormat::RGBA8Srgb};
   TextureFormat DepthFormat {TextureFormat::Depth32F};
   bool HasDepth {true};
+
+  auto operator==(const RenderTargetDesc&) const -> bool = default;
 };
 
 class RHIRenderTarget
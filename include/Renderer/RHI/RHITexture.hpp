@@ -19,6 +19,41 @@ enum class TextureFormat : uint8_t
   Depth32F
 };
 
+constexpr auto GetBytesPerPixel(TextureFormat format) -> size_t
+{
+  switch (format) {
+    case TextureFormat::R8Unorm:
+      return 1;
+    case TextureFormat::RG8Unorm:
+      return 2;
+    case TextureFormat::RGB8Unorm:
+    case TextureFormat::RGB8Srgb:
+      return 3;
+    case TextureFormat::RGBA8Unorm:
+    case TextureFormat::RGBA8Srgb:
+    case TextureFormat::BGRA8Unorm:
+    case TextureFormat::Depth24Stencil8:
+    case TextureFormat::Depth32F:
+      return 4;
+    case TextureFormat::RGBA16F:
+      return 8;
+    case TextureFormat::RGBA32F:
+      return 16;
+  }
+  return 4;
+}
+
+constexpr auto IsDepthFormat(TextureFormat format) -> bool
+{
+  return format == TextureFormat::Depth24Stencil8
+      || format == TextureFormat::Depth32F;
+}
+
+constexpr auto HasStencil(TextureFormat format) -> bool
+{
+  return format == TextureFormat::Depth24Stencil8;
+}
+
 enum class TextureUsage : uint8_t
 {
   Sampled = 1 << 0,
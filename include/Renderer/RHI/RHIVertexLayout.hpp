@@ -47,12 +47,16 @@ struct VertexAttribute
   uint32_t Location {0};
   VertexFormat Format {VertexFormat::Float3};
   uint32_t Offset {0};
+
+  auto operator==(const VertexAttribute&) const -> bool = default;
 };
 
 struct VertexInputLayout
 {
   uint32_t Stride {0};
   std::vector<VertexAttribute> Attributes;
+
+  auto operator==(const VertexInputLayout&) const -> bool = default;
 };
 
 #endif
@@ -59,6 +59,10 @@ struct RenderPassInfo
   DepthStencilInfo* DepthStencilAttachment {nullptr};  // nullptr = no depth
   uint32_t Width {0};
   uint32_t Height {0};
+  // The caller transitions the render target's textures through
+  // RHICommandBuffer::Barrier(). Otherwise the backend discards their
+  // contents on begin and makes them shader-readable on end.
+  bool ExplicitBarriers {false};
 };
 
 #endif
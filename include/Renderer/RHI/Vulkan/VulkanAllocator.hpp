@@ -0,0 +1,103 @@
+#ifndef RENDERER_RHI_VULKAN_VULKANALLOCATOR_HPP
+#define RENDERER_RHI_VULKAN_VULKANALLOCATOR_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <volk.h>
+#include <vk_mem_alloc.h>
+
+#include "Renderer/RHI/RHIDevice.hpp"
+
+// Where a resource's memory comes from. Each pool sub-allocates its
+// resources from a few large memory blocks of a single memory type.
+enum class VulkanMemoryPool : uint8_t
+{
+  // Sampled textures and anything else without a pool of its own
+  General,
+  // Color and depth attachments, including the swapchain depth buffer
+  RenderTarget,
+  // Device-local buffers filled through the uploader: vertices, indices and
+  // other static data
+  Geometry,
+  // Host-visible buffers the CPU writes: staging, uniforms and upload rings
+  Upload,
+};
+
+struct VulkanBufferAllocation
+{
+  VkBuffer Buffer {VK_NULL_HANDLE};
+  VmaAllocation Allocation {VK_NULL_HANDLE};
+};
+
+struct VulkanImageAllocation
+{
+  VkImage Image {VK_NULL_HANDLE};
+  VmaAllocation Allocation {VK_NULL_HANDLE};
+};
+
+// Places every buffer and image of the device in memory blocks shared with
+// other resources, instead of one vkAllocateMemory per resource.
+//
+// Built on the Vulkan Memory Allocator. Render targets, geometry and upload
+// memory get dedicated pools so their blocks are not interleaved with each
+// other and their footprint can be read separately; everything else uses the
+// allocator's default pools. A resource that does not fit its pool, because
+// it is larger than a block or needs another memory type, falls back to the
+// default pools as well.
+class VulkanAllocator
+{
+public:
+  static constexpr size_t RENDER_TARGET_BLOCK_SIZE = 64UZ * 1024 * 1024;
+  static constexpr size_t GEOMETRY_BLOCK_SIZE = 64UZ * 1024 * 1024;
+  static constexpr size_t UPLOAD_BLOCK_SIZE = 32UZ * 1024 * 1024;
+
+  VulkanAllocator(VkInstance instance,
+                  VkPhysicalDevice physical_device,
+                  VkDevice device);
+  ~VulkanAllocator();
+
+  VulkanAllocator(const VulkanAllocator&) = delete;
+  VulkanAllocator(VulkanAllocator&&) = delete;
+  auto operator=(const VulkanAllocator&) -> VulkanAllocator& = delete;
+  auto operator=(VulkanAllocator&&) -> VulkanAllocator& = delete;
+
+  // Create the resource and bind it to memory from the pool
+  [[nodiscard]] auto CreateBuffer(const VkBufferCreateInfo& info,
+                                  VulkanMemoryPool pool)
+      -> VulkanBufferAllocation;
+  [[nodiscard]] auto CreateImage(const VkImageCreateInfo& info,
+                                 VulkanMemoryPool pool)
+      -> VulkanImageAllocation;
+  void DestroyBuffer(const VulkanBufferAllocation& buffer);
+  void DestroyImage(const VulkanImageAllocation& image);
+
+  [[nodiscard]] auto Map(VmaAllocation allocation) -> void*;
+  void Unmap(VmaAllocation allocation);
+  // Makes host writes visible to the device; a no-op for coherent memory
+  void Flush(VmaAllocation allocation, VkDeviceSize offset, VkDeviceSize size);
+
+  [[nodiscard]] auto GetMemoryProperties(VmaAllocation allocation) const
+      -> VkMemoryPropertyFlags;
+
+  // One entry per dedicated pool, followed by the default pools
+  [[nodiscard]] auto GetStats() const -> std::vector<MemoryPoolStats>;
+  void LogStats() const;
+
+private:
+  static constexpr size_t POOL_COUNT = 4;
+
+  [[nodiscard]] static auto get_create_info(VulkanMemoryPool pool)
+      -> VmaAllocationCreateInfo;
+  void create_pool(VulkanMemoryPool pool,
+                   uint32_t memory_type_index,
+                   size_t block_size);
+
+  VmaAllocator m_Allocator {VK_NULL_HANDLE};
+  // Indexed by VulkanMemoryPool; General stays null
+  std::array<VmaPool, POOL_COUNT> m_Pools {};
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define RENDERER_RHI_VULKAN_VULKANBUFFER_HPP
 
 #include <volk.h>
+#include <vk_mem_alloc.h>
 
 #include "Renderer/RHI/RHIBuffer.hpp"
 
@@ -21,16 +22,28 @@ public:
   [[nodiscard]] auto Map() -> void* override;
   void Unmap() override;
   void Upload(const void* data, size_t size, size_t offset) override;
+  void Flush(size_t offset, size_t size) override;
   [[nodiscard]] auto GetSize() const -> size_t override;
 
+  [[nodiscard]] auto IsPersistentlyMapped() const -> bool override
+  {
+    return m_Persistent;
+  }
+
+  // Buffers created without CPUVisible live in device-local memory and are
+  // filled through the device's staging uploader
+  [[nodiscard]] auto IsHostVisible() const -> bool { return m_HostVisible; }
+
   [[nodiscard]] auto GetVkBuffer() const -> VkBuffer { return m_Buffer; }
 
 private:
   const VulkanDevice& m_Device;
   VkBuffer m_Buffer {VK_NULL_HANDLE};
-  VkDeviceMemory m_Memory {VK_NULL_HANDLE};
+  VmaAllocation m_Allocation {VK_NULL_HANDLE};
   size_t m_Size {0};
   bool m_Mapped {false};
+  bool m_Persistent {false};
+  bool m_HostVisible {true};
   void* m_MappedPtr {nullptr};
 };
 
@@ -1,7 +1,10 @@
 #ifndef RENDERER_RHI_VULKAN_VULKANCOMMANDBUFFER_HPP
 #define RENDERER_RHI_VULKAN_VULKANCOMMANDBUFFER_HPP
 
+#include <array>
+#include <optional>
 #include <span>
+#include <vector>
 
 #include <volk.h>
 
@@ -31,6 +34,7 @@ public:
   // RHICommandBuffer interface (render pass)
   void BeginRenderPass(const RenderPassInfo& info) override;
   void EndRenderPass() override;
+  void Barrier(std::span<const TextureBarrier> barriers) override;
 
   // RHICommandBuffer interface (drawing commands)
   void BindShaders(const RHIShaderModule* vertex_shader,
@@ -54,10 +58,74 @@ public:
                    uint32_t first_index,
                    int32_t vertex_offset,
                    uint32_t first_instance) override;
+  void DrawIndexedIndirect(
+      const RHIBuffer& args_buffer,
+      size_t offset,
+      uint32_t draw_count,
+      uint32_t stride = sizeof(DrawIndexedIndirectCommand)) override;
+  void DrawIndexedIndirectCount(
+      const RHIBuffer& args_buffer,
+      size_t offset,
+      const RHIBuffer& count_buffer,
+      size_t count_offset,
+      uint32_t max_draw_count,
+      uint32_t stride = sizeof(DrawIndexedIndirectCommand)) override;
+
+  [[nodiscard]] auto GetCommandStats() const -> CommandStats override
+  {
+    return m_Stats;
+  }
 
   [[nodiscard]] auto GetHandle() const -> VkCommandBuffer;
 
+  // Forgets the recorded state. Needed after commands were recorded into the
+  // handle directly, e.g. by the ImGui backend binding its own pipeline.
+  void InvalidateState();
+
 private:
+  static constexpr uint32_t MAX_VERTEX_BINDINGS = 4;
+  static constexpr uint32_t MAX_DESCRIPTOR_SETS = 4;
+  // Dynamic state that BindShaders() sets to the same value every time
+  static constexpr uint32_t FIXED_STATE_COMMANDS = 10;
+
+  struct Extent
+  {
+    uint32_t Width {0};
+    uint32_t Height {0};
+
+    auto operator==(const Extent&) const -> bool = default;
+  };
+
+  struct DescriptorBinding
+  {
+    VkDescriptorSet Set {VK_NULL_HANDLE};
+    std::vector<uint32_t> DynamicOffsets;
+  };
+
+  // Last state and bindings recorded into the command buffer. Dynamic state
+  // and bindings stay in effect across rendering scopes, so a request that
+  // matches its shadow is not recorded again. Unset values are unknown.
+  struct ShadowState
+  {
+    std::optional<std::array<VkShaderEXT, 2>> Shaders;
+    bool FixedState {false};
+    bool LineWidth {false};
+    std::optional<VkPolygonMode> PolygonMode;
+    std::optional<VkBool32> DepthTest;
+    bool DepthCompareOp {false};
+    std::optional<Extent> Viewport;
+    std::optional<uint32_t> BlendAttachments;
+    std::optional<VkPrimitiveTopology> Topology;
+    std::optional<VertexInputLayout> VertexInput;
+    std::array<VkBuffer, MAX_VERTEX_BINDINGS> VertexBuffers {};
+    VkBuffer IndexBuffer {VK_NULL_HANDLE};
+    VkPipelineLayout Layout {VK_NULL_HANDLE};
+    std::array<DescriptorBinding, MAX_DESCRIPTOR_SETS> DescriptorSets;
+  };
+
+  // Counts the requested commands; true when they have to be recorded
+  auto record(bool changed, uint32_t commands = 1) -> bool;
+
   const VulkanDevice* m_Device {nullptr};
   VkCommandBuffer m_CommandBuffer {VK_NULL_HANDLE};
   bool m_Recording {false};
@@ -65,6 +133,8 @@ private:
   bool m_IsSwapchainTarget {false};
   RenderPassInfo m_CurrentRenderPass {};
   PolygonMode m_PolygonMode {PolygonMode::Fill};
+  ShadowState m_State;
+  CommandStats m_Stats;
 };
 
 #endif
@@ -15,6 +15,8 @@
 #include "Renderer/RHI/Vulkan/VulkanSwapchain.hpp"
 
 struct RendererConfig;
+class VulkanAllocator;
+class VulkanUploader;
 
 class VulkanDevice final : public RHIDevice
 {
@@ -26,7 +28,7 @@ public:
   VulkanDevice(VulkanDevice&&) = delete;
   auto operator=(const VulkanDevice&) -> VulkanDevice& = delete;
   auto operator=(VulkanDevice&&) -> VulkanDevice& = delete;
-  ~VulkanDevice() override = default;
+  ~VulkanDevice() override;
 
   void Init(const RendererConfig& config, void* window) override;
   void CreateSwapchain(uint32_t width, uint32_t height) override;
@@ -37,6 +39,15 @@ public:
   void Present() override;
   void WaitIdle() override;
 
+  [[nodiscard]] auto GetFramesInFlight() const -> uint32_t override
+  {
+    return MAX_FRAMES_IN_FLIGHT;
+  }
+  [[nodiscard]] auto GetFrameIndex() const -> uint32_t override
+  {
+    return m_CurrentFrameIndex;
+  }
+
   [[nodiscard]] auto GetSwapchain() const -> RHISwapchain* override;
   [[nodiscard]] auto GetCurrentCommandBuffer() -> RHICommandBuffer* override;
 
@@ -52,6 +63,18 @@ public:
       -> std::unique_ptr<RHIShaderModule> override;
   [[nodiscard]] auto CreateGraphicsPipeline(const GraphicsPipelineDesc& desc)
       -> std::unique_ptr<RHIGraphicsPipeline> override;
+  void UploadBuffer(RHIBuffer& buffer,
+                    const void* data,
+                    size_t size,
+                    size_t offset) override;
+  void UploadTexture(RHITexture& texture,
+                     const void* data,
+                     size_t size) override;
+  void FlushUploads() override;
+  [[nodiscard]] auto GetUploadStats() const -> UploadStats override;
+  [[nodiscard]] auto GetMemoryStats() const
+      -> std::vector<MemoryPoolStats> override;
+
   [[nodiscard]] auto CreateDescriptorSetLayout(
       const DescriptorSetLayoutDesc& desc)
       -> std::shared_ptr<RHIDescriptorSetLayout> override;
@@ -110,6 +133,32 @@ public:
 
   [[nodiscard]] auto IsDepthEnabled() const -> bool { return m_DepthEnabled; }
 
+  [[nodiscard]] auto GetAllocator() const -> VulkanAllocator&
+  {
+    return *m_Allocator;
+  }
+
+  [[nodiscard]] auto GetUploader() const -> VulkanUploader&
+  {
+    return *m_Uploader;
+  }
+
+  // Optional features, enabled when the GPU has them
+  [[nodiscard]] auto SupportsMultiDrawIndirect() const -> bool
+  {
+    return m_MultiDrawIndirect;
+  }
+
+  [[nodiscard]] auto SupportsDrawIndirectCount() const -> bool
+  {
+    return m_DrawIndirectCount;
+  }
+
+  [[nodiscard]] auto SupportsIndirectFirstInstance() const -> bool override
+  {
+    return m_DrawIndirectFirstInstance;
+  }
+
 private:
   void pick_physical_device(VkSurfaceKHR surface);
   void create_logical_device(VkSurfaceKHR surface);
@@ -130,11 +179,17 @@ private:
   uint32_t m_PresentQueueFamily {0};
   VkDescriptorPool m_DescriptorPool {VK_NULL_HANDLE};
 
+  // Outlives every resource of the device, the swapchain included
+  std::unique_ptr<VulkanAllocator> m_Allocator;
   std::unique_ptr<VulkanSwapchain> m_Swapchain;
+  std::unique_ptr<VulkanUploader> m_Uploader;
   SDL_Window* m_Window {nullptr};
   bool m_Initialized {false};
   bool m_ValidationEnabled {false};
   bool m_DepthEnabled {false};
+  bool m_MultiDrawIndirect {false};
+  bool m_DrawIndirectCount {false};
+  bool m_DrawIndirectFirstInstance {false};
 
   std::array<VulkanFrame, MAX_FRAMES_IN_FLIGHT> m_FrameData;
   std::vector<VkSemaphore> m_RenderFinishedSemaphores;
@@ -5,6 +5,7 @@
 
 #include <SDL3/SDL.h>
 #include <volk.h>
+#include <vk_mem_alloc.h>
 
 #include "Renderer/RHI/RHISwapchain.hpp"
 
@@ -80,7 +81,7 @@ private:
 
   VkImage m_DepthImage {VK_NULL_HANDLE};
   VkImageView m_DepthImageView {VK_NULL_HANDLE};
-  VkDeviceMemory m_DepthImageMemory {VK_NULL_HANDLE};
+  VmaAllocation m_DepthAllocation {VK_NULL_HANDLE};
   VkFormat m_DepthFormat {VK_FORMAT_D32_SFLOAT};
 };
 
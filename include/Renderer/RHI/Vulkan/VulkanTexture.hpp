@@ -2,6 +2,7 @@
 #define RENDERER_RHI_VULKAN_VULKANTEXTURE_HPP
 
 #include <volk.h>
+#include <vk_mem_alloc.h>
 
 #include "Renderer/RHI/RHITexture.hpp"
 
@@ -34,11 +35,12 @@ private:
   const VulkanDevice& m_Device;
   VkImage m_Image {VK_NULL_HANDLE};
   VkImageView m_ImageView {VK_NULL_HANDLE};
-  VkDeviceMemory m_Memory {VK_NULL_HANDLE};
+  VmaAllocation m_Allocation {VK_NULL_HANDLE};
   uint32_t m_Width {0};
   uint32_t m_Height {0};
   TextureFormat m_Format {TextureFormat::RGBA8Unorm};
   VkFormat m_VkFormat {VK_FORMAT_R8G8B8A8_UNORM};
+  bool m_Uploaded {false};
 };
 
 #endif
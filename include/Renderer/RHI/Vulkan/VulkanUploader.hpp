@@ -0,0 +1,100 @@
+#ifndef RENDERER_RHI_VULKAN_VULKANUPLOADER_HPP
+#define RENDERER_RHI_VULKAN_VULKANUPLOADER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <volk.h>
+
+#include "Renderer/RHI/RHIDevice.hpp"
+
+class VulkanBuffer;
+class VulkanDevice;
+
+// Moves data into device-local memory through host-visible staging memory.
+//
+// Copies are recorded into the open batch: a command buffer, a fence and a
+// persistently mapped staging buffer. A batch is submitted when its staging
+// buffer fills up or on Flush(), and the batches form a ring, so staging
+// memory is reused once the fence of the batch that last used it has
+// passed. Data larger than a staging buffer is split across batches; images
+// are split on row boundaries.
+//
+// Copies in a batch wait for all earlier work on the graphics queue, so
+// memory that in-flight frames still read (e.g. a freed GeometryPool range
+// handed to a new mesh) is not overwritten under them. Every batch ends in
+// a barrier that makes the transfers visible to all later work on the
+// graphics queue, so anything submitted after Flush() may read the uploaded
+// data. Images written in the batch are moved to SHADER_READ_ONLY_OPTIMAL by
+// that same barrier.
+class VulkanUploader
+{
+public:
+  static constexpr size_t STAGING_SIZE = 8UZ * 1024 * 1024;
+  static constexpr uint32_t BATCH_COUNT = 3;
+
+  explicit VulkanUploader(const VulkanDevice& device);
+  ~VulkanUploader();
+
+  VulkanUploader(const VulkanUploader&) = delete;
+  VulkanUploader(VulkanUploader&&) = delete;
+  auto operator=(const VulkanUploader&) -> VulkanUploader& = delete;
+  auto operator=(VulkanUploader&&) -> VulkanUploader& = delete;
+
+  // Host-visible buffers are written directly; everything else is staged
+  void CopyToBuffer(VulkanBuffer& buffer,
+                    const void* data,
+                    size_t size,
+                    size_t offset);
+
+  // Fills mip 0 of a color image from tightly packed rows. current_layout is
+  // UNDEFINED for a fresh image and SHADER_READ_ONLY_OPTIMAL once it has
+  // been uploaded before.
+  void CopyToImage(VkImage image,
+                   uint32_t width,
+                   uint32_t height,
+                   VkImageLayout current_layout,
+                   const void* data,
+                   size_t size);
+
+  // Submits the open batch, if it recorded anything
+  void Flush();
+
+  // Called before an image is destroyed. Waits until no batch that copies
+  // into it is still pending or executing, submitting the open batch first
+  // if needed.
+  void ReleaseImage(VkImage image);
+
+  [[nodiscard]] auto GetStats() const -> const UploadStats& { return m_Stats; }
+
+private:
+  struct Batch
+  {
+    VkCommandBuffer CommandBuffer {VK_NULL_HANDLE};
+    VkFence Fence {VK_NULL_HANDLE};
+    std::unique_ptr<VulkanBuffer> Staging;
+    // Images written in the batch; they stay in TRANSFER_DST_OPTIMAL until
+    // it is submitted
+    std::vector<VkImage> Images;
+    size_t Used {0};
+    // Whether buffer copies already wait for earlier work
+    bool BuffersWait {false};
+    bool Recording {false};
+    bool Submitted {false};
+  };
+
+  // Opens the current batch for recording, waiting for its last submission
+  auto acquire_batch() -> Batch&;
+  void wait_batch(Batch& batch);
+
+  const VulkanDevice& m_Device;
+  VkCommandPool m_CommandPool {VK_NULL_HANDLE};
+  std::array<Batch, BATCH_COUNT> m_Batches;
+  uint32_t m_Current {0};
+  UploadStats m_Stats;
+};
+
+#endif
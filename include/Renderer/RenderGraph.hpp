@@ -4,15 +4,16 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "Renderer/RHI/RHICommandBuffer.hpp"
 #include "Renderer/RHI/RHIRenderTarget.hpp"
 #include "Renderer/RHI/RenderPassInfo.hpp"
 
 class RHIDevice;
-class RHICommandBuffer;
 
 class RenderGraph
 {
@@ -28,6 +29,12 @@ public:
     TextureFormat DepthFormat {TextureFormat::Depth32F};
     bool HasDepth {true};
     bool IsDepth {false};  // true = depth-only resource
+    // Read outside the graph (e.g. shown by the UI), so it stays intact until
+    // the end of the frame instead of handing its memory to later resources,
+    // and is left shader-readable
+    bool Exported {false};
+
+    auto operator==(const ResourceDesc&) const -> bool = default;
   };
 
   struct PassDesc
@@ -42,6 +49,28 @@ public:
     std::function<void(RHICommandBuffer&)> Execute;
   };
 
+  // Render target memory backing the graph's resources. Resources whose
+  // lifetimes do not overlap share a render target when their layouts match,
+  // so Allocated is the peak the graph actually needs and Required what it
+  // would need with a target per resource.
+  struct MemoryStats
+  {
+    uint32_t ResourceCount {0};
+    uint32_t TargetCount {0};
+    uint64_t RequiredBytes {0};
+    uint64_t AllocatedBytes {0};
+  };
+
+  // What the last Compile() did. Passes whose outputs never reach the
+  // backbuffer or an exported resource are culled, and a graph with the same
+  // structure as the compiled one reuses its plan and render targets.
+  struct CompileStats
+  {
+    uint32_t PassCount {0};
+    uint32_t CulledPassCount {0};
+    bool ReusedPlan {false};
+  };
+
   void AddResource(const ResourceDesc& desc);
   void AddPass(const PassDesc& desc);
 
@@ -55,15 +84,28 @@ public:
   [[nodiscard]] auto GetTexture(const std::string& name) -> RHITexture*;
   [[nodiscard]] auto GetRenderTarget(const std::string& name)
       -> RHIRenderTarget*;
+  [[nodiscard]] auto GetMemoryStats() const -> const MemoryStats&;
+  [[nodiscard]] auto GetCompileStats() const -> const CompileStats&;
 
   void Resize(RHIDevice& device, uint32_t width, uint32_t height);
+  // Drops the resources and passes so the graph can be described again. The
+  // compiled plan and render targets are kept until the next Compile(),
+  // which reuses them if the new description has the same structure.
+  void Reset();
+  // Drops everything, including the render targets
   void Clear();
 
 private:
   struct Resource
   {
     ResourceDesc Desc;
-    std::unique_ptr<RHIRenderTarget> Target;
+  };
+
+  // First and last position in m_ExecutionOrder a resource is used at
+  struct Lifetime
+  {
+    size_t First {0};
+    size_t Last {0};
   };
 
   struct Pass
@@ -71,12 +113,15 @@ private:
     PassDesc Desc;
     RenderPassInfo ResolvedInfo;
     DepthStencilInfo ResolvedDepthStencil;
+    // Transitions recorded right before the pass
+    std::vector<TextureBarrier> Barriers;
   };
 
   std::unordered_map<std::string, Resource> m_Resources;
   std::vector<Pass> m_Passes;
 
-  // MRT grouping: maps resource name -> (shared RT, attachment index)
+  // Maps resource name -> (backing RT, attachment index). Passes writing
+  // several outputs get one RT with an attachment per output.
   struct AttachmentMapping
   {
     RHIRenderTarget* SharedTarget {nullptr};
@@ -84,17 +129,57 @@ private:
     bool IsDepth {false};
   };
   std::unordered_map<std::string, AttachmentMapping> m_AttachmentMap;
-  // Shared render targets for MRT passes (owned here)
+  // Render targets backing the resources (owned here)
   std::vector<std::unique_ptr<RHIRenderTarget>> m_SharedTargets;
 
   std::vector<size_t> m_ExecutionOrder;
+  std::unordered_map<std::string, Lifetime> m_Lifetimes;
+  MemoryStats m_MemoryStats;
+  CompileStats m_CompileStats;
+
+  // Everything in the description the compiled plan depends on: the
+  // execution order, the render targets and the states textures are left
+  // in between frames
+  struct PlanKey
+  {
+    struct PassKey
+    {
+      std::vector<std::string> Inputs;
+      std::vector<std::string> Outputs;
+      uint32_t ColorAttachmentCount {1};
+      bool UseDepth {true};
+
+      auto operator==(const PassKey&) const -> bool = default;
+    };
+
+    std::vector<ResourceDesc> Resources;  // Sorted by name
+    std::vector<PassKey> Passes;
+
+    auto operator==(const PlanKey&) const -> bool = default;
+  };
+  // Key of the description the current plan was built from. The hash only
+  // rejects changed descriptions quickly; a match is confirmed on the key.
+  std::optional<PlanKey> m_PlanKey;
+  size_t m_PlanHash {0};
+
+  // The pass barriers assume every texture starts the frame in the state
+  // the previous frame left it in. New render targets are moved into that
+  // state once, on their first frame.
+  std::vector<TextureBarrier> m_InitialBarriers;
+  // Leaves exported resources readable after the last pass
+  std::vector<TextureBarrier> m_FinalBarriers;
   bool m_Compiled {false};
   uint32_t m_BackbufferWidth {0};
   uint32_t m_BackbufferHeight {0};
 
+  [[nodiscard]] auto makePlanKey() const -> PlanKey;
+  [[nodiscard]] static auto hashPlanKey(const PlanKey& key) -> size_t;
   void topologicalSort();
+  void cullPasses();
+  void computeLifetimes();
   void createResources(RHIDevice& device);
   void buildRenderPassInfos();
+  void buildBarriers();
 };
 
 #endif
@@ -6,9 +6,23 @@
 enum class RenderAPI : uint8_t
 {
   OpenGL,
-  Vulkan
+  Vulkan,
+  Null  // Headless: host-memory resources, recorded command streams
 };
 
+constexpr auto ToString(RenderAPI api) -> const char*
+{
+  switch (api) {
+    case RenderAPI::OpenGL:
+      return "OpenGL";
+    case RenderAPI::Vulkan:
+      return "Vulkan";
+    case RenderAPI::Null:
+      return "Null";
+  }
+  return "Unknown";
+}
+
 struct RendererConfig
 {
   RenderAPI API = RenderAPI::OpenGL;
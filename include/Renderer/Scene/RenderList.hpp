@@ -0,0 +1,66 @@
+#ifndef RENDERER_SCENE_RENDERLIST_HPP
+#define RENDERER_SCENE_RENDERLIST_HPP
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <linalg/mat4.hpp>
+
+#include "Renderer/Model/BoundingVolume.hpp"
+#include "Renderer/Scene/TransformStore.hpp"
+
+class Model;
+class SceneNode;
+
+struct RenderItem
+{
+  SceneNode* Node {nullptr};
+  const linalg::Mat4* WorldMatrix {nullptr};
+  Model* Asset {nullptr};
+  AABB Bounds {};  // World space
+};
+
+// Contiguous list of the visible nodes with models in a scene.
+//
+// Maintained incrementally from node events rather than rebuilt by walking
+// the tree: entries are added, refreshed and removed (swap-and-pop) by
+// transform handle, so the order is not the hierarchy order. Steady-state
+// frames cost no allocations and only touch entries that changed.
+class RenderList
+{
+public:
+  RenderList() = default;
+
+  // Add the node, or refresh its entry if it is already listed
+  void Add(SceneNode& node);
+  void Remove(const SceneNode& node);
+  void Clear();
+
+  // Recompute the world bounds of a node whose transform moved. Unknown
+  // handles are ignored.
+  void UpdateBounds(TransformHandle handle);
+
+  // Refetch world matrix pointers after the store layout changed
+  void RefreshMatrices(uint64_t layout_version);
+  [[nodiscard]] auto GetLayoutVersion() const -> uint64_t
+  {
+    return m_LayoutVersion;
+  }
+
+  [[nodiscard]] auto GetItems() const -> std::span<const RenderItem>
+  {
+    return m_Items;
+  }
+  [[nodiscard]] auto GetSize() const -> size_t { return m_Items.size(); }
+  [[nodiscard]] auto Contains(const SceneNode& node) const -> bool;
+
+private:
+  [[nodiscard]] auto index_of(TransformHandle handle) const -> uint32_t;
+
+  std::vector<RenderItem> m_Items;
+  std::vector<uint32_t> m_HandleItems;  // Transform handle -> item index
+  uint64_t m_LayoutVersion {0};
+};
+
+#endif
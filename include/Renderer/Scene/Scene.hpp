@@ -4,15 +4,22 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "Renderer/Model/BoundingVolume.hpp"
 #include "Renderer/Scene/LightData.hpp"
+#include "Renderer/Scene/RenderList.hpp"
+#include "Renderer/Scene/SceneBVH.hpp"
 #include "Renderer/Scene/SceneNode.hpp"
+#include "Renderer/Scene/TransformStore.hpp"
 
 class Model;
 class Camera;
+class ThreadPool;
 
 class Scene
 {
@@ -33,19 +40,39 @@ public:
   auto CreateNode(const std::string& name = "Node", SceneNode* parent = nullptr)
       -> SceneNode*;
 
-  // Find nodes by name
+  // Find a node by name through the name index. With duplicate names the
+  // earliest attached node is returned.
   [[nodiscard]] auto FindNode(const std::string& name) const -> SceneNode*;
 
   // Pick the closest visible node intersected by a ray
   [[nodiscard]] auto PickNode(const Ray& ray) const -> SceneNode*;
 
+  // Spatial queries over visible nodes with models, answered by the BVH
+  [[nodiscard]] auto QueryRay(const Ray& ray) const -> std::vector<SceneNode*>;
+  [[nodiscard]] auto QueryAABB(const AABB& bounds) const
+      -> std::vector<SceneNode*>;
+  [[nodiscard]] auto QuerySphere(const BoundingSphere& sphere) const
+      -> std::vector<SceneNode*>;
+
+  // Called by nodes attached to this scene
+  void OnNodeChanged(SceneNode& node, SceneNodeChange change);
+  void OnNodeRenamed(SceneNode& node, const std::string& old_name);
+
   // Scene properties
   void SetName(const std::string& name);
   [[nodiscard]] auto GetName() const -> const std::string&;
 
-  // Update all transforms in the scene
+  // Update all transforms in the scene with one sweep over the store and
+  // refit the BVH around the nodes that moved
   void UpdateTransforms();
 
+  [[nodiscard]] auto GetTransformStore() -> TransformStore&;
+
+  // Threads used by UpdateTransforms (1 = serial, the default). Results are
+  // identical for every thread count.
+  void SetTransformUpdateThreads(uint32_t thread_count);
+  [[nodiscard]] auto GetTransformUpdateThreads() const -> uint32_t;
+
   // Scene bounds (union of all visible node bounds)
   [[nodiscard]] auto GetBounds() const -> AABB;
 
@@ -53,9 +80,35 @@ public:
   void ForEachNode(const std::function<void(SceneNode&)>& callback);
   void ForEachNode(const std::function<void(const SceneNode&)>& callback) const;
 
+  // Inlinable traversals over an explicit stack, pre-order with children in
+  // order. Lambdas bind to these rather than the std::function overloads.
+  template<typename Fn>
+  void ForEachNode(Fn&& callback);
+  template<typename Fn>
+  void ForEachNode(Fn&& callback) const;
+
+  // callback returns false to skip the node's children
+  template<typename Fn>
+  void ForEachNodePruned(Fn&& callback);
+  template<typename Fn>
+  void ForEachNodePruned(Fn&& callback) const;
+
+  // Nodes visible in the hierarchy; hidden subtrees are skipped entirely
+  template<typename Fn>
+  void ForEachVisibleNode(Fn&& callback) const;
+
+  // Nodes with a light component that are visible in the hierarchy
+  template<typename Fn>
+  void ForEachLightNode(Fn&& callback) const;
+
   // Get all visible nodes with models (for rendering)
   [[nodiscard]] auto GetRenderableNodes() const -> std::vector<SceneNode*>;
 
+  // The same nodes as a persistent list maintained from node events, with
+  // world matrix, model and world bounds per entry. Order is unspecified.
+  // Valid until the hierarchy changes or transforms are next updated.
+  [[nodiscard]] auto GetRenderList() const -> std::span<const RenderItem>;
+
   // Light queries
   [[nodiscard]] auto GetPointLights() const -> std::vector<PointLightData>;
   [[nodiscard]] auto GetDirectionalLight() const
@@ -69,16 +122,123 @@ public:
   void SetActiveCamera(Camera* camera);
   [[nodiscard]] auto GetActiveCamera() const -> Camera*;
 
-  // Generate a unique node name (appends _1, _2, ... if name already exists)
+  // Generate a unique node name (appends _1, _2, ... if name already exists).
+  // Suffixes continue from the last one handed out for the same base name.
   [[nodiscard]] auto MakeUniqueName(const std::string& name) const
       -> std::string;
 
 private:
-  auto count_nodes(const SceneNode& node) const -> size_t;
+  template<typename NodeT, typename VisitFn>
+  static void traverse(NodeT& root, VisitFn&& visit);
+
+  // The BVH, rebuilt first if nodes were attached, detached or changed
+  auto spatial_index() const -> const SceneBVH&;
+  // Add or remove the subtree's entries to match visibility and models
+  void sync_render_list(SceneNode& node);
+  void remove_from_render_list(const SceneNode& node);
+  void index_names(SceneNode& node);
+  void unindex_names(const SceneNode& node);
+  void add_name(const std::string& name, SceneNode& node);
+  void remove_name(const std::string& name, const SceneNode& node);
 
   std::string m_Name;
+  // Declared before m_Root so nodes release their slots before it dies
+  std::unique_ptr<TransformStore> m_TransformStore;
   std::unique_ptr<SceneNode> m_Root;
+  std::unique_ptr<ThreadPool> m_UpdatePool;
   Camera* m_ActiveCamera {nullptr};
+
+  // Name -> nodes with that name, in attach order
+  std::unordered_map<std::string, std::vector<SceneNode*>> m_NameIndex;
+  // Base name -> next suffix MakeUniqueName will try
+  mutable std::unordered_map<std::string, uint32_t> m_NameSuffixes;
+
+  mutable RenderList m_RenderList;
+  mutable SceneBVH m_BVH;
+  mutable bool m_SpatialIndexDirty {true};
 };
 
+template<typename NodeT, typename VisitFn>
+void Scene::traverse(NodeT& root, VisitFn&& visit)
+{
+  constexpr size_t INITIAL_STACK_SIZE = 64;
+
+  std::vector<NodeT*> stack;
+  stack.reserve(INITIAL_STACK_SIZE);
+  stack.push_back(&root);
+  while (!stack.empty()) {
+    NodeT* node = stack.back();
+    stack.pop_back();
+    if (!visit(*node)) {
+      continue;
+    }
+
+    // Reversed so the first child is visited next
+    const auto& children = node->GetChildren();
+    for (auto iter = children.rbegin(); iter != children.rend(); ++iter) {
+      stack.push_back(iter->get());
+    }
+  }
+}
+
+template<typename Fn>
+void Scene::ForEachNode(Fn&& callback)
+{
+  traverse(*m_Root,
+           [&callback](SceneNode& node) -> bool
+           {
+             callback(node);
+             return true;
+           });
+}
+
+template<typename Fn>
+void Scene::ForEachNode(Fn&& callback) const
+{
+  traverse(std::as_const(*m_Root),
+           [&callback](const SceneNode& node) -> bool
+           {
+             callback(node);
+             return true;
+           });
+}
+
+template<typename Fn>
+void Scene::ForEachNodePruned(Fn&& callback)
+{
+  traverse(*m_Root, std::forward<Fn>(callback));
+}
+
+template<typename Fn>
+void Scene::ForEachNodePruned(Fn&& callback) const
+{
+  traverse(std::as_const(*m_Root), std::forward<Fn>(callback));
+}
+
+template<typename Fn>
+void Scene::ForEachVisibleNode(Fn&& callback) const
+{
+  traverse(std::as_const(*m_Root),
+           [&callback](const SceneNode& node) -> bool
+           {
+             if (!node.IsVisible()) {
+               return false;
+             }
+             callback(node);
+             return true;
+           });
+}
+
+template<typename Fn>
+void Scene::ForEachLightNode(Fn&& callback) const
+{
+  ForEachVisibleNode(
+      [&callback](const SceneNode& node) -> void
+      {
+        if (node.HasLight()) {
+          callback(node);
+        }
+      });
+}
+
 #endif
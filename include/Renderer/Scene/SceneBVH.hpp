@@ -0,0 +1,81 @@
+#ifndef RENDERER_SCENE_SCENEBVH_HPP
+#define RENDERER_SCENE_SCENEBVH_HPP
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Renderer/Model/BoundingVolume.hpp"
+#include "Renderer/Scene/TransformStore.hpp"
+
+class SceneNode;
+
+// Bounding volume hierarchy over the world bounds of scene nodes.
+//
+// Built top-down with median splits along the longest centroid axis. When
+// nodes move, MarkMoved() + Refit() recompute the moved leaves and only the
+// ancestors above them; the tree topology is kept until the next Build().
+class SceneBVH
+{
+public:
+  SceneBVH() = default;
+
+  void Build(std::span<SceneNode* const> nodes);
+  void Clear();
+
+  // Queue a node (identified by its transform handle) whose world bounds
+  // changed. Unknown handles are ignored.
+  void MarkMoved(TransformHandle handle);
+  void Refit();
+
+  // Closest node hit by the ray, or nullptr
+  [[nodiscard]] auto RayCast(const Ray& ray, float& t_hit) const -> SceneNode*;
+
+  // Append every node whose bounds are hit by / overlap the query
+  void QueryRay(const Ray& ray, std::vector<SceneNode*>& results) const;
+  void QueryAABB(const AABB& bounds, std::vector<SceneNode*>& results) const;
+  void QuerySphere(const BoundingSphere& sphere,
+                   std::vector<SceneNode*>& results) const;
+
+  // Union of all node bounds
+  [[nodiscard]] auto GetBounds() const -> AABB;
+  [[nodiscard]] auto GetNodeCount() const -> size_t { return m_Nodes.size(); }
+  [[nodiscard]] auto GetItemCount() const -> size_t { return m_Items.size(); }
+
+private:
+  struct Item
+  {
+    SceneNode* Node {nullptr};
+    AABB Bounds {};
+    TransformHandle Handle {kInvalidTransformHandle};
+  };
+
+  // Leaves cover Items[First, First + Count). Internal nodes have Count == 0
+  // and their children at First and First + 1.
+  struct Node
+  {
+    AABB Bounds {};
+    uint32_t First {0};
+    uint32_t Count {0};
+    uint32_t Parent {0};
+  };
+
+  void build_node(uint32_t index,
+                  uint32_t parent,
+                  uint32_t first,
+                  uint32_t count);
+  void refit_node(uint32_t index);
+
+  template<typename OverlapFn>
+  void query(OverlapFn&& overlaps, std::vector<SceneNode*>& results) const;
+
+  std::vector<Node> m_Nodes;
+  std::vector<Item> m_Items;
+  std::vector<uint32_t> m_ItemLeaves;  // Item index -> leaf node
+  std::vector<uint32_t> m_HandleItems;  // Transform handle -> item index
+
+  std::vector<uint8_t> m_NodeQueued;
+  std::vector<uint32_t> m_RefitQueue;
+};
+
+#endif
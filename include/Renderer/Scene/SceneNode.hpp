@@ -11,6 +11,16 @@
 #include "Renderer/Scene/Transform.hpp"
 
 class Model;
+class Scene;
+
+// Structural or render-relevant changes reported to the owning scene
+enum class SceneNodeChange : uint8_t
+{
+  Attached,  // The node and its subtree joined the scene
+  Detached,  // The node and its subtree are about to leave the scene
+  ModelChanged,
+  VisibilityChanged,
+};
 
 struct LightComponent
 {
@@ -83,6 +93,8 @@ public:
 
   void SetVisible(bool visible);
   [[nodiscard]] auto IsVisible() const -> bool;
+  // Visible and all ancestors visible. Cached and kept current by SetVisible
+  // and reparenting, so this is O(1).
   [[nodiscard]] auto IsVisibleInHierarchy() const -> bool;
 
   void SetEnabled(bool enabled);
@@ -92,15 +104,27 @@ public:
   [[nodiscard]] auto GetLocalBounds() const -> AABB;
   [[nodiscard]] auto GetWorldBounds() const -> AABB;
 
-  // Update hierarchy transforms (call once per frame before rendering)
+  // Recursively update hierarchy transforms. Scene::UpdateTransforms uses
+  // the flat TransformStore sweep instead; this path is kept for standalone
+  // hierarchies and for comparison.
   void UpdateTransforms();
 
+  // Attach this subtree to a scene (nullptr detaches). Transforms are bound
+  // to the scene's store and changes are reported to it. Children added
+  // later inherit the parent's scene automatically.
+  void SetScene(Scene* scene);
+  [[nodiscard]] auto GetScene() const -> Scene*;
+
 private:
   void set_parent(SceneNode* parent);
+  void notify_scene(SceneNodeChange change);
+  void update_hierarchy_visibility();
+  void update_transforms(bool parent_changed);
 
   std::string m_Name;
   Transform m_Transform;
   SceneNode* m_Parent {nullptr};
+  Scene* m_Scene {nullptr};
   std::vector<std::unique_ptr<SceneNode>> m_Children;
 
   std::shared_ptr<Model> m_Model;
@@ -108,6 +132,7 @@ private:
   std::optional<LightComponent> m_Light;
 
   bool m_Visible {true};
+  bool m_VisibleInHierarchy {true};
   bool m_Enabled {true};
 };
 
@@ -1,18 +1,26 @@
 #ifndef RENDERER_SCENE_SCENERENDERER_HPP
 #define RENDERER_SCENE_SCENERENDERER_HPP
 
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <linalg/mat4.hpp>
 #include <linalg/vec.hpp>
 
+#include "Renderer/DrawQueue.hpp"
+#include "Renderer/Frustum.hpp"
 #include "Renderer/RHI/RHIPipeline.hpp"
 #include "Renderer/ShaderCompiler.hpp"
 #include "Renderer/ShaderReflection.hpp"
 
+class Model;
 class Scene;
 class SceneNode;
+struct RenderItem;
 class Camera;
 class RHIDevice;
 class RHIBuffer;
@@ -21,6 +29,7 @@ class RHIDescriptorSetLayout;
 class RHIPipelineLayout;
 class RHIShaderModule;
 class RHICommandBuffer;
+class UploadRing;
 
 struct CameraUBO
 {
@@ -37,9 +46,51 @@ struct NodeUBO
   linalg::Mat4 NormalMatrix;
 };
 
+// Counters for the frame since the last BeginFrame()
+struct CullStats
+{
+  uint32_t NodesTested {0};
+  uint32_t NodesVisible {0};
+  uint32_t SubMeshesTested {0};
+  uint32_t SubMeshesCulled {0};
+  uint32_t DrawCalls {0};
+  uint32_t InstancedBatches {0};
+  // Draws recorded into indirect-args buffers; DrawCalls counts the calls
+  uint32_t IndirectCommands {0};
+
+  [[nodiscard]] auto GetNodesCulled() const -> uint32_t
+  {
+    return NodesTested - NodesVisible;
+  }
+};
+
+struct BindCounts
+{
+  uint32_t VertexBuffers {0};
+  uint32_t IndexBuffers {0};
+  uint32_t Materials {0};
+  uint32_t Nodes {0};
+
+  [[nodiscard]] auto GetTotal() const -> uint32_t
+  {
+    return VertexBuffers + IndexBuffers + Materials + Nodes;
+  }
+};
+
+// Binds issued since the last BeginFrame(), next to the binds the same draws
+// would need when recorded node by node in scene-graph order
+struct BindStats
+{
+  BindCounts SceneOrder;
+  BindCounts Sorted;
+};
+
 class SceneRenderer
 {
 public:
+  // Instances per draw; must match MAX_INSTANCES in the scene shaders
+  static constexpr uint32_t MAX_INSTANCES = 128;
+
   explicit SceneRenderer(RHIDevice& device, RenderAPI api,
                          const std::string& shader_path = "shaders/scene.slang");
   ~SceneRenderer();
@@ -55,6 +106,26 @@ public:
 
   void SetWireframe(bool wireframe);
 
+  // Draw visible nodes that share a model with one instanced draw per
+  // submesh (on by default). Instanced nodes skip per-submesh culling.
+  void SetInstancing(bool enabled);
+  [[nodiscard]] auto IsInstancing() const -> bool;
+
+  // Write draws into an indirect-args buffer and submit each run of draws
+  // sharing geometry and material with one DrawIndexedIndirect (off by
+  // default)
+  void SetIndirectDraws(bool enabled);
+  [[nodiscard]] auto IsIndirectDraws() const -> bool;
+
+  // Skip nodes and submeshes outside the camera frustum (on by default)
+  void SetFrustumCulling(bool enabled);
+  [[nodiscard]] auto IsFrustumCulling() const -> bool;
+  [[nodiscard]] auto GetCullStats() const -> const CullStats&;
+  [[nodiscard]] auto GetBindStats() const -> const BindStats&;
+
+  // Per-frame node uniforms; other per-draw data may share it
+  [[nodiscard]] auto GetUploadRing() -> UploadRing&;
+
   [[nodiscard]] auto GetSetLayout(const std::string& parameter_name) const
       -> std::shared_ptr<RHIDescriptorSetLayout>;
   [[nodiscard]] auto GetPipelineLayout() const
@@ -66,6 +137,24 @@ private:
   void create_shaders();
   void create_camera_resources();
   void update_camera_ubo(const Camera& camera);
+  // Descriptor set pointing at one page of the node upload ring
+  auto node_descriptor_set(RHIBuffer& page) -> RHIDescriptorSet&;
+  // Stores the node uniforms and queues a packet per visible submesh
+  void collect_node(const SceneNode& node);
+  // Stores the uniforms of nodes sharing a model in batches of
+  // MAX_INSTANCES and queues one instanced packet per submesh and batch
+  void collect_instances(const Model& model,
+                         std::span<SceneNode* const> nodes);
+  // world enables per-submesh culling for single nodes
+  void queue_draws(const Model& model,
+                   uint32_t first_instance,
+                   uint32_t instance_count,
+                   float depth,
+                   const linalg::Mat4* world);
+  [[nodiscard]] auto node_depth(const linalg::Mat4& world) const -> float;
+  // Sorts the queued packets, uploads their node data in draw order and
+  // records them, skipping redundant binds
+  void submit_draws(RHICommandBuffer& cmd);
 
   RHIDevice& m_Device;
   RenderAPI m_API;
@@ -79,16 +168,39 @@ private:
 
   std::shared_ptr<RHIPipelineLayout> m_PipelineLayout;
 
-  std::unique_ptr<RHIBuffer> m_CameraUBO;
-  std::unique_ptr<RHIDescriptorSet> m_CameraDescriptorSet;
+  // One camera buffer per frame in flight
+  std::vector<std::unique_ptr<RHIBuffer>> m_CameraUBOs;
+  std::vector<std::unique_ptr<RHIDescriptorSet>> m_CameraDescriptorSets;
+  uint32_t m_FrameIndex {0};
+
+  // Every node binding covers a full instance array
+  static constexpr uint32_t NODE_BINDING_RANGE =
+      MAX_INSTANCES * static_cast<uint32_t>(sizeof(NodeUBO));
 
-  std::unique_ptr<RHIBuffer> m_NodeDynamicBuffer;
-  std::unique_ptr<RHIDescriptorSet> m_NodeDescriptorSet;
+  std::unique_ptr<UploadRing> m_NodeRing;
+  std::unique_ptr<UploadRing> m_IndirectRing;
+  std::unordered_map<const RHIBuffer*, std::unique_ptr<RHIDescriptorSet>>
+      m_NodeDescriptorSets;
   uint32_t m_NodeSetIndex {0};
-  uint32_t m_NodeDynamicOffset {0};
   uint32_t m_NodeAlignment {256};
 
   bool m_Wireframe {false};
+  bool m_Instancing {true};
+  bool m_IndirectDraws {false};
+
+  DrawQueue m_DrawQueue;
+  // Node uniforms of the queued packets, indexed by DrawPacket::FirstInstance
+  std::vector<NodeUBO> m_InstanceData;
+  BindStats m_BindStats;
+  linalg::Vec3 m_CameraPosition {};
+
+  Frustum m_Frustum;
+  bool m_FrustumCulling {true};
+  CullStats m_CullStats;
+  std::vector<AABB> m_CullBounds;
+  std::vector<uint8_t> m_CullVisible;
+  std::vector<const RenderItem*> m_VisibleItems;
+  std::vector<SceneNode*> m_InstanceNodes;
 };
 
 #endif
@@ -6,10 +6,22 @@
 #include <linalg/quaternion.hpp>
 #include <linalg/vec.hpp>
 
+#include "Renderer/Scene/TransformStore.hpp"
+
+// A node's local TRS plus cached matrices. A Transform is either standalone
+// and owns its values, or bound to a TransformStore, in which case every
+// accessor reads and writes the store's arrays. Copies are always standalone.
 class Transform
 {
 public:
   Transform() = default;
+  ~Transform();
+
+  Transform(const Transform& other);
+  Transform(Transform&& other) noexcept;
+  // Assignment copies TRS values and keeps the destination's binding
+  auto operator=(const Transform& other) -> Transform&;
+  auto operator=(Transform&& other) noexcept -> Transform&;
 
   // Local transform setters
   void SetPosition(const linalg::Vec3& position);
@@ -50,8 +62,10 @@ public:
   void SetParent(Transform* parent);
   [[nodiscard]] auto GetParent() const -> Transform*;
 
-  // Dirty tracking
+  // Dirty tracking. When bound to a store, a dirty transform also refreshes
+  // its whole subtree on the next Scene::UpdateTransforms().
   void MarkDirty();
+  void MarkWorldDirty();
   [[nodiscard]] auto IsLocalDirty() const -> bool;
   [[nodiscard]] auto IsWorldDirty() const -> bool;
 
@@ -63,7 +77,31 @@ public:
   static auto Lerp(const Transform& from, const Transform& to, float t)
       -> Transform;
 
+  // Build a TRS matrix; shared with TransformStore so both paths agree
+  [[nodiscard]] static auto ComposeMatrix(const linalg::Vec3& position,
+                                          const linalg::Quat& rotation,
+                                          const linalg::Vec3& scale)
+      -> linalg::Mat4;
+
+  // Store binding. Binding copies the current values into the store and
+  // parents the new slot under the parent Transform if it shares the store.
+  // Binding to nullptr copies the values back out and frees the slot.
+  void Bind(TransformStore* store);
+  [[nodiscard]] auto GetStore() const -> TransformStore*;
+  [[nodiscard]] auto GetHandle() const -> TransformHandle;
+
 private:
+  [[nodiscard]] auto position() -> linalg::Vec3&;
+  [[nodiscard]] auto position() const -> const linalg::Vec3&;
+  [[nodiscard]] auto rotation() -> linalg::Quat&;
+  [[nodiscard]] auto rotation() const -> const linalg::Quat&;
+  [[nodiscard]] auto scale() -> linalg::Vec3&;
+  [[nodiscard]] auto scale() const -> const linalg::Vec3&;
+  [[nodiscard]] auto local_matrix() -> linalg::Mat4&;
+  [[nodiscard]] auto world_matrix() -> linalg::Mat4&;
+  [[nodiscard]] auto world_matrix() const -> const linalg::Mat4&;
+  void set_dirty(bool local_dirty, bool world_dirty);
+
   linalg::Vec3 m_Position {0.0F, 0.0F, 0.0F};
   linalg::Quat m_Rotation {0.0F, 0.0F, 0.0F, 1.0F};  // Identity quaternion
   linalg::Vec3 m_Scale {1.0F, 1.0F, 1.0F};
@@ -74,6 +112,9 @@ private:
   bool m_WorldDirty {true};
 
   Transform* m_Parent {nullptr};
+
+  TransformStore* m_Store {nullptr};
+  TransformHandle m_Handle {kInvalidTransformHandle};
 };
 
 #endif
@@ -0,0 +1,150 @@
+#ifndef RENDERER_SCENE_TRANSFORMSTORE_HPP
+#define RENDERER_SCENE_TRANSFORMSTORE_HPP
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <linalg/mat4.hpp>
+#include <linalg/quaternion.hpp>
+#include <linalg/vec.hpp>
+
+class ThreadPool;
+
+using TransformHandle = uint32_t;
+
+inline constexpr TransformHandle kInvalidTransformHandle =
+    std::numeric_limits<TransformHandle>::max();
+
+// Structure-of-arrays storage for every Transform in a Scene.
+//
+// Components live in dense arrays ordered depth-first, so every parent
+// precedes its children and each subtree occupies one contiguous range.
+// Marking a transform dirty queues it; UpdateWorldMatrices() then sweeps only
+// the subtree ranges under queued transforms, so its cost follows what moved
+// rather than the size of the scene. A dirty transform implies its whole
+// subtree is stale.
+//
+// Handles stay stable while the dense layout is rebuilt lazily after
+// hierarchy changes. References returned by the accessors are invalidated by
+// Allocate() and by the next update.
+class TransformStore
+{
+public:
+  TransformStore() = default;
+  ~TransformStore() = default;
+
+  TransformStore(const TransformStore&) = delete;
+  TransformStore(TransformStore&&) = delete;
+  auto operator=(const TransformStore&) -> TransformStore& = delete;
+  auto operator=(TransformStore&&) -> TransformStore& = delete;
+
+  // Hierarchy management
+  [[nodiscard]] auto Allocate(TransformHandle parent = kInvalidTransformHandle)
+      -> TransformHandle;
+  void Free(TransformHandle handle);
+  void SetParent(TransformHandle handle, TransformHandle parent);
+  [[nodiscard]] auto GetParent(TransformHandle handle) const -> TransformHandle;
+
+  // Component access
+  [[nodiscard]] auto Position(TransformHandle handle) -> linalg::Vec3&;
+  [[nodiscard]] auto Position(TransformHandle handle) const
+      -> const linalg::Vec3&;
+  [[nodiscard]] auto Rotation(TransformHandle handle) -> linalg::Quat&;
+  [[nodiscard]] auto Rotation(TransformHandle handle) const
+      -> const linalg::Quat&;
+  [[nodiscard]] auto Scale(TransformHandle handle) -> linalg::Vec3&;
+  [[nodiscard]] auto Scale(TransformHandle handle) const -> const linalg::Vec3&;
+  [[nodiscard]] auto LocalMatrix(TransformHandle handle) -> linalg::Mat4&;
+  [[nodiscard]] auto LocalMatrix(TransformHandle handle) const
+      -> const linalg::Mat4&;
+  [[nodiscard]] auto WorldMatrix(TransformHandle handle) -> linalg::Mat4&;
+  [[nodiscard]] auto WorldMatrix(TransformHandle handle) const
+      -> const linalg::Mat4&;
+
+  // Dirty tracking
+  void MarkDirty(TransformHandle handle);
+  void SetLocalDirty(TransformHandle handle, bool dirty);
+  void SetWorldDirty(TransformHandle handle, bool dirty);
+  [[nodiscard]] auto IsLocalDirty(TransformHandle handle) const -> bool;
+  [[nodiscard]] auto IsWorldDirty(TransformHandle handle) const -> bool;
+
+  // Recompute local and world matrices for every queued transform and its
+  // descendants, parents first. With a pool, large dirty ranges are split
+  // into sibling subtrees that are swept concurrently; each matrix is still
+  // computed by exactly the same operations, so results match the serial
+  // path bit for bit.
+  void UpdateWorldMatrices(ThreadPool* pool = nullptr);
+
+  [[nodiscard]] auto GetCount() const -> size_t { return m_LiveCount; }
+
+  // Changes whenever references returned by the accessors may have been
+  // invalidated, so callers caching matrix pointers know to refetch them
+  [[nodiscard]] auto GetLayoutVersion() const -> uint64_t
+  {
+    return m_LayoutVersion;
+  }
+
+  // Number of world matrices recomputed by the last UpdateWorldMatrices()
+  [[nodiscard]] auto GetLastUpdateCount() const -> size_t
+  {
+    return m_LastUpdateCount;
+  }
+
+  // Call fn(handle) for every transform whose world matrix was recomputed by
+  // the last UpdateWorldMatrices(), in slot order
+  template<typename Fn>
+  void ForEachUpdatedHandle(Fn&& fn) const
+  {
+    for (const auto& range : m_UpdatedRanges) {
+      for (uint32_t slot = range.First; slot < range.Last; ++slot) {
+        if (m_SlotHandles[slot] != kInvalidTransformHandle) {
+          fn(m_SlotHandles[slot]);
+        }
+      }
+    }
+  }
+
+private:
+  [[nodiscard]] auto slot_of(TransformHandle handle) const -> uint32_t;
+  void queue_dirty(uint32_t slot);
+  void update_range(uint32_t first, uint32_t last);
+  void split_ranges(size_t grain_size);
+  void rebuild_layout();
+
+  // Dense components, indexed by slot
+  std::vector<linalg::Vec3> m_Positions;
+  std::vector<linalg::Quat> m_Rotations;
+  std::vector<linalg::Vec3> m_Scales;
+  std::vector<linalg::Mat4> m_LocalMatrices;
+  std::vector<linalg::Mat4> m_WorldMatrices;
+  std::vector<uint32_t> m_ParentSlots;
+  std::vector<uint32_t> m_SubtreeSizes;  // Including the node itself
+  std::vector<TransformHandle> m_SlotHandles;  // kInvalid marks a freed hole
+  std::vector<uint8_t> m_LocalDirty;
+  std::vector<uint8_t> m_WorldDirty;  // Also marks "already queued"
+
+  // Sparse handle table
+  std::vector<uint32_t> m_HandleSlots;
+  std::vector<TransformHandle> m_FreeHandles;
+
+  // Handles queued by MarkDirty(); resolved to sorted slots on update
+  std::vector<TransformHandle> m_DirtyHandles;
+  std::vector<uint32_t> m_DirtySlots;
+
+  struct SlotRange
+  {
+    uint32_t First {0};
+    uint32_t Last {0};
+  };
+  std::vector<SlotRange> m_DirtyRanges;
+  std::vector<SlotRange> m_SplitRanges;
+  std::vector<SlotRange> m_UpdatedRanges;  // Unsplit copy of the last update
+
+  size_t m_LiveCount {0};
+  size_t m_LastUpdateCount {0};
+  uint64_t m_LayoutVersion {0};
+  bool m_LayoutDirty {false};
+};
+
+#endif
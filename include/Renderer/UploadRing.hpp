@@ -0,0 +1,88 @@
+#ifndef RENDERER_UPLOADRING_HPP
+#define RENDERER_UPLOADRING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Renderer/RHI/RHIBuffer.hpp"
+
+class RHIDevice;
+
+struct UploadAllocation
+{
+  RHIBuffer* Buffer {nullptr};
+  size_t Offset {0};
+  size_t Size {0};
+};
+
+// Linear allocator for data written once per frame, such as per-draw
+// uniforms.
+//
+// Memory is split into one partition per frame in flight. Each partition is
+// a list of persistently mapped pages that is bumped through during the
+// frame and rewound when its slot comes around again; RHIDevice::BeginFrame() has
+// waited on that slot's fence by then, so the GPU is done reading it. A
+// partition that runs out appends another page instead of wrapping, so a
+// frame never overwrites data still in use. Pages are kept for reuse.
+//
+// Call BeginFrame() once per frame, after RHIDevice::BeginFrame().
+//
+// binding_range is the size of a fixed-range binding (such as a dynamic
+// uniform buffer descriptor) that will read from allocation offsets. Every
+// allocation then has at least that many bytes of page behind its offset,
+// even when the allocation itself is smaller.
+class UploadRing
+{
+public:
+  static constexpr size_t DEFAULT_PAGE_SIZE = 4UZ * 1024 * 1024;
+
+  UploadRing(RHIDevice& device,
+             BufferUsage usage,
+             size_t page_size = DEFAULT_PAGE_SIZE,
+             size_t binding_range = 0);
+  ~UploadRing();
+
+  UploadRing(const UploadRing&) = delete;
+  UploadRing(UploadRing&&) = delete;
+  auto operator=(const UploadRing&) -> UploadRing& = delete;
+  auto operator=(UploadRing&&) -> UploadRing& = delete;
+
+  void BeginFrame();
+
+  // alignment must be a power of two
+  [[nodiscard]] auto Allocate(size_t size, size_t alignment) -> UploadAllocation;
+  auto Upload(const void* data, size_t size, size_t alignment)
+      -> UploadAllocation;
+
+  // Bytes allocated in the current frame, including alignment padding
+  [[nodiscard]] auto GetFrameUsage() const -> size_t;
+  // Bytes of pages owned across all partitions
+  [[nodiscard]] auto GetCapacity() const -> size_t;
+  [[nodiscard]] auto GetPageCount() const -> size_t;
+
+private:
+  struct Page
+  {
+    std::unique_ptr<RHIBuffer> Buffer;
+    size_t Offset {0};
+  };
+
+  struct Partition
+  {
+    std::vector<Page> Pages;
+    size_t Current {0};
+  };
+
+  auto add_page(Partition& partition, size_t min_size) -> Page&;
+
+  RHIDevice& m_Device;
+  BufferUsage m_Usage;
+  size_t m_PageSize;
+  size_t m_BindingRange;
+  std::vector<Partition> m_Partitions;
+  uint32_t m_FrameIndex {0};
+};
+
+#endif
@@ -26,7 +26,7 @@ void Application::Init()
 
   m_RendererConfig = ConfigLoader::LoadRendererConfig("config.toml");
 
-  InitSdl();
+  InitSdl(m_RendererConfig.API);
 
   WindowProps props;
   props.API = m_RendererConfig.API;
@@ -82,10 +82,15 @@ void Application::Destroy()
   Logger::Info("Application shutdown complete");
 }
 
-void Application::InitSdl()
+void Application::InitSdl(RenderAPI api)
 {
   Logger::Info("Initializing SDL3");
 
+  // The Null backend never presents, so it must not require a display
+  if (api == RenderAPI::Null) {
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+  }
+
   if (!SDL_Init(SDL_INIT_VIDEO)) {
     Logger::Critical("Failed to initialize SDL: {}", SDL_GetError());
     throw std::runtime_error("SDL_Init failed.");
@@ -128,8 +133,7 @@ void Application::OnEvent(void* event)
 
 void Application::SwitchBackend(RenderAPI new_api)
 {
-  Logger::Info("Switching backend to {}",
-               new_api == RenderAPI::Vulkan ? "Vulkan" : "OpenGL");
+  Logger::Info("Switching backend to {}", ToString(new_api));
 
   const uint32_t width = m_Window->GetWidth();
   const uint32_t height = m_Window->GetHeight();
@@ -34,6 +34,8 @@ auto ConfigLoader::LoadRendererConfig(const std::filesystem::path& config_path)
           config.API = RenderAPI::Vulkan;
         } else if (api_str == "OpenGL") {
           config.API = RenderAPI::OpenGL;
+        } else if (api_str == "Null") {
+          config.API = RenderAPI::Null;
         } else {
           Logger::Warn("Unknown API '{}', defaulting to OpenGL", api_str);
           config.API = RenderAPI::OpenGL;
@@ -50,8 +52,7 @@ auto ConfigLoader::LoadRendererConfig(const std::filesystem::path& config_path)
     }
 
     Logger::Info("Loaded config from: {}", config_path.string());
-    Logger::Info("  API: {}",
-                 config.API == RenderAPI::Vulkan ? "Vulkan" : "OpenGL");
+    Logger::Info("  API: {}", ToString(config.API));
     Logger::Info("  Validation: {}",
                  config.EnableValidation ? "enabled" : "disabled");
     Logger::Info("  Depth: {}", config.EnableDepth ? "enabled" : "disabled");
@@ -101,8 +102,7 @@ void ConfigLoader::SaveRendererConfig(const RendererConfig& config,
   toml::table toml_config;
 
   toml::table renderer;
-  renderer.insert_or_assign(
-      "api", config.API == RenderAPI::Vulkan ? "Vulkan" : "OpenGL");
+  renderer.insert_or_assign("api", ToString(config.API));
   renderer.insert_or_assign("validation", config.EnableValidation);
   renderer.insert_or_assign("depth", config.EnableDepth);
 
@@ -0,0 +1,89 @@
+#include <algorithm>
+
+#include "Core/ThreadPool.hpp"
+
+#include "Core/Logger.hpp"
+
+ThreadPool::ThreadPool(uint32_t thread_count)
+{
+  const uint32_t worker_count = std::max(thread_count, 1U) - 1;
+  m_Workers.reserve(worker_count);
+  for (uint32_t i = 0; i < worker_count; ++i) {
+    m_Workers.emplace_back([this](const std::stop_token& stop_token) -> void
+                           { worker_loop(stop_token); });
+  }
+
+  Logger::Trace("Created thread pool with {} worker(s)", worker_count);
+}
+
+ThreadPool::~ThreadPool()
+{
+  for (auto& worker : m_Workers) {
+    worker.request_stop();
+  }
+  m_WakeCondition.notify_all();
+  m_Workers.clear();
+}
+
+void ThreadPool::ParallelFor(size_t count,
+                             const std::function<void(size_t)>& task)
+{
+  if (m_Workers.empty() || count <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      task(i);
+    }
+    return;
+  }
+
+  {
+    const std::scoped_lock lock(m_Mutex);
+    m_Task = &task;
+    m_TaskCount = count;
+    m_NextIndex.store(0, std::memory_order_relaxed);
+    m_ActiveWorkers = static_cast<uint32_t>(m_Workers.size());
+    ++m_Generation;
+  }
+  m_WakeCondition.notify_all();
+
+  run_tasks();
+
+  std::unique_lock lock(m_Mutex);
+  m_DoneCondition.wait(lock, [this]() -> bool { return m_ActiveWorkers == 0; });
+  m_Task = nullptr;
+}
+
+void ThreadPool::worker_loop(const std::stop_token& stop_token)
+{
+  uint64_t seen_generation = 0;
+  while (true) {
+    {
+      std::unique_lock lock(m_Mutex);
+      const bool has_work = m_WakeCondition.wait(
+          lock,
+          stop_token,
+          [this, seen_generation]() -> bool
+          { return m_Generation != seen_generation; });
+      if (!has_work) {
+        return;
+      }
+      seen_generation = m_Generation;
+    }
+
+    run_tasks();
+
+    const std::scoped_lock lock(m_Mutex);
+    if (--m_ActiveWorkers == 0) {
+      m_DoneCondition.notify_one();
+    }
+  }
+}
+
+void ThreadPool::run_tasks()
+{
+  for (size_t i = m_NextIndex.fetch_add(1, std::memory_order_relaxed);
+       i < m_TaskCount;
+       i = m_NextIndex.fetch_add(1, std::memory_order_relaxed))
+  {
+    (*m_Task)(i);
+  }
+}
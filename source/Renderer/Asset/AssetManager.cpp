@@ -6,6 +6,7 @@
 #include <stb_image.h>
 
 #include "Core/Logger.hpp"
+#include "Renderer/Model/GeometryPool.hpp"
 #include "Renderer/Model/Model.hpp"
 #include "Renderer/Model/ModelLoader.hpp"
 #include "Renderer/RHI/RHIDescriptorSet.hpp"
@@ -15,6 +16,7 @@
 
 AssetManager::AssetManager(RHIDevice& device)
     : m_Device(device)
+    , m_GeometryPool(std::make_unique<GeometryPool>(device))
 {
   create_default_resources();
 }
@@ -61,7 +63,8 @@ auto AssetManager::LoadTexture(const std::filesystem::path& path,
   desc.MipLevels = 1;
 
   auto texture = m_Device.CreateTexture(desc);
-  texture->Upload(data, static_cast<size_t>(width * height) * 4);
+  m_Device.UploadTexture(
+      *texture, data, static_cast<size_t>(width * height) * 4);
 
   stbi_image_free(data);
 
@@ -104,6 +107,8 @@ auto AssetManager::LoadModel(const std::filesystem::path& path,
     return iter->second;
   }
 
+  // Covers the textures the loader pulls in as well as the mesh data
+  const UploadStats uploads_before = m_Device.GetUploadStats();
   auto model =
       ModelLoaderRegistry::Instance().Load(resolved_path, *this, options);
   if (!model) {
@@ -117,15 +122,28 @@ auto AssetManager::LoadModel(const std::filesystem::path& path,
                          m_MaterialDescriptorSetLayout,
                          m_DefaultSampler.get(),
                          m_DefaultTexture.get(),
-                         m_DefaultNormalMap.get());
+                         m_DefaultNormalMap.get(),
+                         m_GeometryPool.get());
+  m_Device.FlushUploads();
+  const UploadStats uploads_after = m_Device.GetUploadStats();
 
   auto shared_model = std::shared_ptr<Model>(std::move(model));
   m_ModelCache[key] = shared_model;
 
-  Logger::Info("Loaded model: {} ({} meshes, {} materials)",
+  const double uploaded_mb =
+      static_cast<double>(uploads_after.Bytes - uploads_before.Bytes)
+      / (1024.0 * 1024.0);
+  const double upload_seconds =
+      uploads_after.HostSeconds - uploads_before.HostSeconds;
+  Logger::Info("Loaded model: {} ({} meshes, {} materials, {} textures, "
+               "{:.2f} MB in {} upload submissions, {:.1f} MB/s)",
                resolved_path.string(),
                shared_model->GetMeshCount(),
-               shared_model->GetMaterialCount());
+               shared_model->GetMaterialCount(),
+               uploads_after.TextureCopies - uploads_before.TextureCopies,
+               uploaded_mb,
+               uploads_after.Submissions - uploads_before.Submissions,
+               (upload_seconds > 0.0) ? uploaded_mb / upload_seconds : 0.0);
 
   return shared_model;
 }
@@ -226,6 +244,11 @@ auto AssetManager::GetDevice() -> RHIDevice&
   return m_Device;
 }
 
+auto AssetManager::GetGeometryPool() -> GeometryPool&
+{
+  return *m_GeometryPool;
+}
+
 void AssetManager::create_default_resources()
 {
   {
@@ -238,7 +261,7 @@ void AssetManager::create_default_resources()
 
     m_DefaultTexture = m_Device.CreateTexture(desc);
     std::array<uint8_t, 4> white = {255, 255, 255, 255};
-    m_DefaultTexture->Upload(white.data(), white.size());
+    m_Device.UploadTexture(*m_DefaultTexture, white.data(), white.size());
   }
 
   {
@@ -251,7 +274,8 @@ void AssetManager::create_default_resources()
 
     m_DefaultNormalMap = m_Device.CreateTexture(desc);
     std::array<uint8_t, 4> normal = {128, 128, 255, 255};
-    m_DefaultNormalMap->Upload(normal.data(), normal.size());
+    m_Device.UploadTexture(
+        *m_DefaultNormalMap, normal.data(), normal.size());
   }
 
   {
@@ -0,0 +1,110 @@
+#include <array>
+#include <bit>
+#include <cmath>
+#include <utility>
+
+#include "Renderer/DrawQueue.hpp"
+
+namespace
+{
+
+constexpr uint32_t PASS_BITS = 4;
+constexpr uint32_t FIELD_BITS = 20;
+constexpr uint64_t FIELD_MASK = (1ULL << FIELD_BITS) - 1;
+constexpr uint32_t PASS_SHIFT = 3 * FIELD_BITS;
+constexpr uint64_t PASS_MASK = (1ULL << PASS_BITS) - 1;
+
+constexpr size_t RADIX_BITS = 8;
+constexpr size_t RADIX_SIZE = 1UZ << RADIX_BITS;
+constexpr size_t DIGIT_COUNT = 64 / RADIX_BITS;
+
+// Non-negative floats order like their bit patterns. Keep the top 20 bits
+// below the (always clear) sign bit.
+auto QuantizeDepth(float depth) -> uint64_t
+{
+  const float clamped = (std::isnan(depth) || depth < 0.0F) ? 0.0F : depth;
+  return (std::bit_cast<uint32_t>(clamped) >> (31 - FIELD_BITS)) & FIELD_MASK;
+}
+
+auto Digit(uint64_t key, size_t digit) -> size_t
+{
+  return static_cast<size_t>(key >> (digit * RADIX_BITS)) & (RADIX_SIZE - 1);
+}
+
+}  // namespace
+
+auto DrawQueue::MakeSortKey(DrawPass pass,
+                            uint64_t material_id,
+                            uint64_t mesh_id,
+                            float depth) -> uint64_t
+{
+  const uint64_t pass_bits =
+      (static_cast<uint64_t>(pass) & PASS_MASK) << PASS_SHIFT;
+  const uint64_t material = material_id & FIELD_MASK;
+  const uint64_t mesh = mesh_id & FIELD_MASK;
+  const uint64_t quantized = QuantizeDepth(depth);
+
+  if (pass == DrawPass::Transparent) {
+    const uint64_t back_to_front = FIELD_MASK - quantized;
+    return pass_bits | (back_to_front << (2 * FIELD_BITS))
+        | (material << FIELD_BITS) | mesh;
+  }
+  return pass_bits | (material << (2 * FIELD_BITS)) | (mesh << FIELD_BITS)
+      | quantized;
+}
+
+void DrawQueue::Clear()
+{
+  m_Packets.clear();
+}
+
+void DrawQueue::Add(const DrawPacket& packet)
+{
+  m_Packets.push_back(packet);
+}
+
+void DrawQueue::Sort()
+{
+  const size_t count = m_Packets.size();
+  if (count < 2) {
+    return;
+  }
+
+  m_Entries.resize(count);
+  m_Scratch.resize(count);
+
+  // One pass builds the histograms of every digit
+  std::array<std::array<uint32_t, RADIX_SIZE>, DIGIT_COUNT> histograms {};
+  for (size_t i = 0; i < count; ++i) {
+    const uint64_t key = m_Packets[i].SortKey;
+    m_Entries[i] = {key, static_cast<uint32_t>(i)};
+    for (size_t digit = 0; digit < DIGIT_COUNT; ++digit) {
+      ++histograms[digit][Digit(key, digit)];
+    }
+  }
+
+  for (size_t digit = 0; digit < DIGIT_COUNT; ++digit) {
+    auto& histogram = histograms[digit];
+
+    // Every key has the same value here, so the pass would not move anything
+    if (histogram[Digit(m_Entries[0].Key, digit)] == count) {
+      continue;
+    }
+
+    uint32_t offset = 0;
+    for (auto& bucket : histogram) {
+      offset += std::exchange(bucket, offset);
+    }
+
+    for (const auto& entry : m_Entries) {
+      m_Scratch[histogram[Digit(entry.Key, digit)]++] = entry;
+    }
+    m_Entries.swap(m_Scratch);
+  }
+
+  m_Sorted.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    m_Sorted[i] = m_Packets[m_Entries[i].Index];
+  }
+  m_Packets.swap(m_Sorted);
+}
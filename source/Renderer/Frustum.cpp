@@ -0,0 +1,249 @@
+#include <cmath>
+
+#include "Renderer/Frustum.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#  include <xmmintrin.h>
+#  define LUMINA_FRUSTUM_SSE
+#endif
+
+namespace
+{
+
+constexpr size_t BATCH_SIZE = 4;
+constexpr uint32_t BATCH_MASK = (1U << BATCH_SIZE) - 1;
+
+// Four volumes as center/extent lanes. Spheres keep their radius in ExtentX.
+struct Batch
+{
+  alignas(16) std::array<float, BATCH_SIZE> CenterX {};
+  alignas(16) std::array<float, BATCH_SIZE> CenterY {};
+  alignas(16) std::array<float, BATCH_SIZE> CenterZ {};
+  alignas(16) std::array<float, BATCH_SIZE> ExtentX {};
+  alignas(16) std::array<float, BATCH_SIZE> ExtentY {};
+  alignas(16) std::array<float, BATCH_SIZE> ExtentZ {};
+  uint32_t ValidMask {0};
+};
+
+auto MatrixRow(const linalg::Mat4& matrix, size_t row) -> linalg::Vec4
+{
+  return linalg::Vec4 {
+      matrix(row, 0), matrix(row, 1), matrix(row, 2), matrix(row, 3)};
+}
+
+auto NormalizePlane(const linalg::Vec4& plane) -> linalg::Vec4
+{
+  const float length = std::sqrt(plane.x() * plane.x() + plane.y() * plane.y()
+                                 + plane.z() * plane.z());
+  return (length > 0.0F) ? plane * (1.0F / length) : plane;
+}
+
+auto PlaneDistance(const linalg::Vec4& plane, const linalg::Vec3& point)
+    -> float
+{
+  return plane.x() * point.x() + plane.y() * point.y() + plane.z() * point.z()
+      + plane.w();
+}
+
+// Visible lanes: for every plane, distance(center) + radius term >= 0, where
+// the radius term is |n| . extent for boxes and the radius for spheres
+template<bool IsSphere>
+auto TestBatch(const std::array<linalg::Vec4, Frustum::PlaneCount>& planes,
+               const Batch& batch) -> uint32_t
+{
+#ifdef LUMINA_FRUSTUM_SSE
+  const __m128 center_x = _mm_load_ps(batch.CenterX.data());
+  const __m128 center_y = _mm_load_ps(batch.CenterY.data());
+  const __m128 center_z = _mm_load_ps(batch.CenterZ.data());
+  const __m128 extent_x = _mm_load_ps(batch.ExtentX.data());
+  const __m128 extent_y = _mm_load_ps(batch.ExtentY.data());
+  const __m128 extent_z = _mm_load_ps(batch.ExtentZ.data());
+  const __m128 zero = _mm_setzero_ps();
+
+  __m128 inside = _mm_cmpeq_ps(zero, zero);
+  for (const auto& plane : planes) {
+    const __m128 normal_x = _mm_set1_ps(plane.x());
+    const __m128 normal_y = _mm_set1_ps(plane.y());
+    const __m128 normal_z = _mm_set1_ps(plane.z());
+
+    __m128 distance = _mm_add_ps(_mm_mul_ps(normal_x, center_x),
+                                 _mm_mul_ps(normal_y, center_y));
+    distance = _mm_add_ps(distance, _mm_mul_ps(normal_z, center_z));
+    distance = _mm_add_ps(distance, _mm_set1_ps(plane.w()));
+
+    __m128 radius = extent_x;
+    if constexpr (!IsSphere) {
+      radius = _mm_add_ps(
+          _mm_mul_ps(_mm_set1_ps(std::abs(plane.x())), extent_x),
+          _mm_mul_ps(_mm_set1_ps(std::abs(plane.y())), extent_y));
+      radius = _mm_add_ps(
+          radius, _mm_mul_ps(_mm_set1_ps(std::abs(plane.z())), extent_z));
+    }
+
+    inside = _mm_and_ps(inside,
+                        _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+  }
+
+  return static_cast<uint32_t>(_mm_movemask_ps(inside)) & batch.ValidMask;
+#else
+  uint32_t mask = batch.ValidMask;
+  for (const auto& plane : planes) {
+    for (size_t lane = 0; lane < BATCH_SIZE; ++lane) {
+      const float distance = plane.x() * batch.CenterX[lane]
+          + plane.y() * batch.CenterY[lane] + plane.z() * batch.CenterZ[lane]
+          + plane.w();
+      float radius = batch.ExtentX[lane];
+      if constexpr (!IsSphere) {
+        radius = std::abs(plane.x()) * batch.ExtentX[lane]
+            + std::abs(plane.y()) * batch.ExtentY[lane]
+            + std::abs(plane.z()) * batch.ExtentZ[lane];
+      }
+      if (distance + radius < 0.0F) {
+        mask &= ~(1U << lane);
+      }
+    }
+  }
+  return mask;
+#endif
+}
+
+// Writes the per-volume bytes for a batch and returns how many were visible
+auto StoreBatch(uint32_t mask, std::span<uint8_t> visible, size_t first)
+    -> size_t
+{
+  size_t count = 0;
+  for (size_t lane = 0; lane < BATCH_SIZE; ++lane) {
+    const bool lane_visible = ((mask >> lane) & 1U) != 0;
+    visible[first + lane] = static_cast<uint8_t>(lane_visible);
+    count += static_cast<size_t>(lane_visible);
+  }
+  return count;
+}
+
+}  // namespace
+
+auto Frustum::FromMatrix(const linalg::Mat4& view_projection) -> Frustum
+{
+  const linalg::Vec4 row_x = MatrixRow(view_projection, 0);
+  const linalg::Vec4 row_y = MatrixRow(view_projection, 1);
+  const linalg::Vec4 row_z = MatrixRow(view_projection, 2);
+  const linalg::Vec4 row_w = MatrixRow(view_projection, 3);
+
+  // The near plane uses the -w <= z convention. For [0, 1] depth projections
+  // it lies slightly behind the true near plane, which is still conservative.
+  Frustum frustum;
+  frustum.m_Planes[Left] = NormalizePlane(row_w + row_x);
+  frustum.m_Planes[Right] = NormalizePlane(row_w - row_x);
+  frustum.m_Planes[Bottom] = NormalizePlane(row_w + row_y);
+  frustum.m_Planes[Top] = NormalizePlane(row_w - row_y);
+  frustum.m_Planes[Near] = NormalizePlane(row_w + row_z);
+  frustum.m_Planes[Far] = NormalizePlane(row_w - row_z);
+  return frustum;
+}
+
+auto Frustum::Intersects(const AABB& aabb) const -> bool
+{
+  if (!aabb.IsValid()) {
+    return false;
+  }
+
+  const linalg::Vec3 center = aabb.GetCenter();
+  const linalg::Vec3 extents = aabb.GetExtents();
+  for (const auto& plane : m_Planes) {
+    const float radius = std::abs(plane.x()) * extents.x()
+        + std::abs(plane.y()) * extents.y() + std::abs(plane.z()) * extents.z();
+    if (PlaneDistance(plane, center) + radius < 0.0F) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto Frustum::Intersects(const BoundingSphere& sphere) const -> bool
+{
+  if (!sphere.IsValid()) {
+    return false;
+  }
+
+  for (const auto& plane : m_Planes) {
+    if (PlaneDistance(plane, sphere.Center) + sphere.Radius < 0.0F) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto Frustum::CullAABBs(std::span<const AABB> boxes,
+                        std::span<uint8_t> visible) const -> size_t
+{
+  size_t visible_count = 0;
+  size_t index = 0;
+  for (; index + BATCH_SIZE <= boxes.size(); index += BATCH_SIZE) {
+    const uint32_t mask = test_aabb_batch(&boxes[index]);
+    visible_count += StoreBatch(mask, visible, index);
+  }
+
+  for (; index < boxes.size(); ++index) {
+    const bool box_visible = Intersects(boxes[index]);
+    visible[index] = static_cast<uint8_t>(box_visible);
+    visible_count += static_cast<size_t>(box_visible);
+  }
+  return visible_count;
+}
+
+auto Frustum::CullSpheres(std::span<const BoundingSphere> spheres,
+                          std::span<uint8_t> visible) const -> size_t
+{
+  size_t visible_count = 0;
+  size_t index = 0;
+  for (; index + BATCH_SIZE <= spheres.size(); index += BATCH_SIZE) {
+    const uint32_t mask = test_sphere_batch(&spheres[index]);
+    visible_count += StoreBatch(mask, visible, index);
+  }
+
+  for (; index < spheres.size(); ++index) {
+    const bool sphere_visible = Intersects(spheres[index]);
+    visible[index] = static_cast<uint8_t>(sphere_visible);
+    visible_count += static_cast<size_t>(sphere_visible);
+  }
+  return visible_count;
+}
+
+auto Frustum::test_aabb_batch(const AABB* boxes) const -> uint32_t
+{
+  Batch batch;
+  for (size_t lane = 0; lane < BATCH_SIZE; ++lane) {
+    const AABB& box = boxes[lane];
+    if (!box.IsValid()) {
+      continue;
+    }
+    const linalg::Vec3 center = box.GetCenter();
+    const linalg::Vec3 extents = box.GetExtents();
+    batch.CenterX[lane] = center.x();
+    batch.CenterY[lane] = center.y();
+    batch.CenterZ[lane] = center.z();
+    batch.ExtentX[lane] = extents.x();
+    batch.ExtentY[lane] = extents.y();
+    batch.ExtentZ[lane] = extents.z();
+    batch.ValidMask |= 1U << lane;
+  }
+  return TestBatch<false>(m_Planes, batch) & BATCH_MASK;
+}
+
+auto Frustum::test_sphere_batch(const BoundingSphere* spheres) const
+    -> uint32_t
+{
+  Batch batch;
+  for (size_t lane = 0; lane < BATCH_SIZE; ++lane) {
+    const BoundingSphere& sphere = spheres[lane];
+    if (!sphere.IsValid()) {
+      continue;
+    }
+    batch.CenterX[lane] = sphere.Center.x();
+    batch.CenterY[lane] = sphere.Center.y();
+    batch.CenterZ[lane] = sphere.Center.z();
+    batch.ExtentX[lane] = sphere.Radius;
+    batch.ValidMask |= 1U << lane;
+  }
+  return TestBatch<true>(m_Planes, batch) & BATCH_MASK;
+}
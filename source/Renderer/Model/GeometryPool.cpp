@@ -0,0 +1,328 @@
+#include <algorithm>
+#include <format>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "Renderer/Model/GeometryPool.hpp"
+
+#include "Core/Logger.hpp"
+#include "Renderer/RHI/RHIBuffer.hpp"
+#include "Renderer/RHI/RHIDevice.hpp"
+
+FreeListAllocator::FreeListAllocator(uint32_t capacity)
+    : m_Capacity(capacity)
+{
+  if (capacity > 0) {
+    m_FreeBlocks.push_back({0, capacity});
+  }
+}
+
+auto FreeListAllocator::Allocate(uint32_t count) -> std::optional<uint32_t>
+{
+  if (count == 0) {
+    return 0U;
+  }
+
+  // First fit keeps live data packed towards the start of the range
+  const auto iter = std::ranges::find_if(
+      m_FreeBlocks, [count](const Block& block) -> bool
+      { return block.Count >= count; });
+  if (iter == m_FreeBlocks.end()) {
+    return std::nullopt;
+  }
+
+  const uint32_t offset = iter->Offset;
+  if (iter->Count == count) {
+    m_FreeBlocks.erase(iter);
+  } else {
+    iter->Offset += count;
+    iter->Count -= count;
+  }
+  m_Used += count;
+  return offset;
+}
+
+void FreeListAllocator::Free(uint32_t offset, uint32_t count)
+{
+  if (count == 0) {
+    return;
+  }
+  if (offset + count > m_Capacity || count > m_Used) {
+    throw std::runtime_error(std::format(
+        "Free list range {} + {} is out of bounds", offset, count));
+  }
+
+  auto next = std::ranges::lower_bound(
+      m_FreeBlocks, offset, {}, [](const Block& block) -> uint32_t
+      { return block.Offset; });
+
+  const bool merge_next = next != m_FreeBlocks.end()
+      && offset + count == next->Offset;
+  const bool merge_prev = next != m_FreeBlocks.begin()
+      && std::prev(next)->Offset + std::prev(next)->Count == offset;
+
+  if (merge_prev && merge_next) {
+    std::prev(next)->Count += count + next->Count;
+    m_FreeBlocks.erase(next);
+  } else if (merge_prev) {
+    std::prev(next)->Count += count;
+  } else if (merge_next) {
+    next->Offset = offset;
+    next->Count += count;
+  } else {
+    m_FreeBlocks.insert(next, {offset, count});
+  }
+  m_Used -= count;
+}
+
+auto FreeListAllocator::GetLargestFreeBlock() const -> uint32_t
+{
+  uint32_t largest = 0;
+  for (const auto& block : m_FreeBlocks) {
+    largest = std::max(largest, block.Count);
+  }
+  return largest;
+}
+
+GeometryAllocation::GeometryAllocation(GeometryPool& pool,
+                                       const GeometryRange& range)
+    : m_Pool(pool.m_Handle)
+    , m_Range(range)
+{
+}
+
+GeometryAllocation::~GeometryAllocation()
+{
+  Reset();
+}
+
+GeometryAllocation::GeometryAllocation(GeometryAllocation&& other) noexcept
+    : m_Pool(std::exchange(other.m_Pool, nullptr))
+    , m_Range(other.m_Range)
+{
+}
+
+auto GeometryAllocation::operator=(GeometryAllocation&& other) noexcept
+    -> GeometryAllocation&
+{
+  if (this != &other) {
+    Reset();
+    m_Pool = std::exchange(other.m_Pool, nullptr);
+    m_Range = other.m_Range;
+  }
+  return *this;
+}
+
+void GeometryAllocation::Reset()
+{
+  if (auto* pool = get_pool()) {
+    pool->free_range(m_Range);
+  }
+  m_Pool.reset();
+  m_Range = {};
+}
+
+auto GeometryAllocation::GetVertexBuffer() const -> RHIBuffer*
+{
+  const auto* pool = get_pool();
+  return (pool != nullptr) ? pool->GetVertexBuffer(m_Range.Page) : nullptr;
+}
+
+auto GeometryAllocation::GetIndexBuffer() const -> RHIBuffer*
+{
+  const auto* pool = get_pool();
+  return (pool != nullptr) ? pool->GetIndexBuffer(m_Range.Page) : nullptr;
+}
+
+GeometryPool::GeometryPool(RHIDevice& device,
+                           uint32_t page_vertices,
+                           uint32_t page_indices)
+    : m_Device(device)
+    , m_PageVertices(page_vertices)
+    , m_PageIndices(page_indices)
+    , m_Handle(std::make_shared<GeometryPool*>(this))
+{
+}
+
+GeometryPool::~GeometryPool()
+{
+  // Live allocations are detached instead of freeing into a dead pool
+  *m_Handle = nullptr;
+  if (m_AllocationCount > 0) {
+    Logger::Warn("[GeometryPool] Destroyed with {} live allocations",
+                 m_AllocationCount);
+  }
+}
+
+auto GeometryPool::Allocate(std::span<const Vertex> vertices,
+                            std::span<const uint32_t> indices)
+    -> GeometryAllocation
+{
+  if (vertices.empty()) {
+    return {};
+  }
+
+  const auto vertex_count = static_cast<uint32_t>(vertices.size());
+  const auto index_count = static_cast<uint32_t>(indices.size());
+
+  GeometryRange range {};
+  bool found = false;
+  for (uint32_t page = 0; page < m_Pages.size() && !found; ++page) {
+    if (m_Pages[page]) {
+      range.Page = page;
+      found = try_allocate(*m_Pages[page], vertex_count, index_count, range);
+    }
+  }
+  if (!found) {
+    range.Page = add_page(vertex_count, index_count);
+    try_allocate(*m_Pages[range.Page], vertex_count, index_count, range);
+  }
+
+  Page& page = *m_Pages[range.Page];
+  m_Device.UploadBuffer(*page.VertexBuffer,
+                        vertices.data(),
+                        vertices.size_bytes(),
+                        sizeof(Vertex) * range.FirstVertex);
+  if (!indices.empty()) {
+    m_Device.UploadBuffer(*page.IndexBuffer,
+                          indices.data(),
+                          indices.size_bytes(),
+                          sizeof(uint32_t) * range.FirstIndex);
+  }
+
+  ++m_AllocationCount;
+  return {*this, range};
+}
+
+auto GeometryPool::GetVertexBuffer(uint32_t page) const -> RHIBuffer*
+{
+  return (page < m_Pages.size() && m_Pages[page])
+      ? m_Pages[page]->VertexBuffer.get()
+      : nullptr;
+}
+
+auto GeometryPool::GetIndexBuffer(uint32_t page) const -> RHIBuffer*
+{
+  return (page < m_Pages.size() && m_Pages[page])
+      ? m_Pages[page]->IndexBuffer.get()
+      : nullptr;
+}
+
+auto GeometryPool::GetPageCount() const -> size_t
+{
+  return static_cast<size_t>(std::ranges::count_if(
+      m_Pages, [](const auto& page) -> bool { return page != nullptr; }));
+}
+
+auto GeometryPool::GetUsedVertices() const -> size_t
+{
+  size_t used = 0;
+  for (const auto& page : m_Pages) {
+    used += page ? page->Vertices.GetUsed() : 0;
+  }
+  return used;
+}
+
+auto GeometryPool::GetUsedIndices() const -> size_t
+{
+  size_t used = 0;
+  for (const auto& page : m_Pages) {
+    used += page ? page->Indices.GetUsed() : 0;
+  }
+  return used;
+}
+
+auto GeometryPool::GetFreeBlockCount() const -> size_t
+{
+  size_t blocks = 0;
+  for (const auto& page : m_Pages) {
+    if (page) {
+      blocks += page->Vertices.GetFreeBlockCount()
+          + page->Indices.GetFreeBlockCount();
+    }
+  }
+  return blocks;
+}
+
+void GeometryPool::free_range(const GeometryRange& range)
+{
+  Page& page = *m_Pages.at(range.Page);
+  page.Vertices.Free(range.FirstVertex, range.VertexCount);
+  page.Indices.Free(range.FirstIndex, range.IndexCount);
+  --m_AllocationCount;
+
+  // Keep the first page around so loading a new model after unloading
+  // everything does not reallocate
+  if (range.Page > 0 && page.Vertices.GetUsed() == 0
+      && page.Indices.GetUsed() == 0)
+  {
+    Logger::Trace("[GeometryPool] Released page {}", range.Page);
+    m_Pages[range.Page].reset();
+    while (!m_Pages.empty() && !m_Pages.back()) {
+      m_Pages.pop_back();
+    }
+  }
+}
+
+auto GeometryPool::try_allocate(Page& page,
+                                uint32_t vertex_count,
+                                uint32_t index_count,
+                                GeometryRange& range) -> bool
+{
+  const auto first_vertex = page.Vertices.Allocate(vertex_count);
+  if (!first_vertex) {
+    return false;
+  }
+  const auto first_index = page.Indices.Allocate(index_count);
+  if (!first_index) {
+    page.Vertices.Free(*first_vertex, vertex_count);
+    return false;
+  }
+
+  range.FirstVertex = *first_vertex;
+  range.VertexCount = vertex_count;
+  range.FirstIndex = *first_index;
+  range.IndexCount = index_count;
+  return true;
+}
+
+auto GeometryPool::add_page(uint32_t min_vertices, uint32_t min_indices)
+    -> uint32_t
+{
+  const uint32_t vertex_capacity = std::max(m_PageVertices, min_vertices);
+  const uint32_t index_capacity =
+      std::max({m_PageIndices, min_indices, 1U});
+
+  BufferDesc vertex_desc {};
+  vertex_desc.Size = sizeof(Vertex) * vertex_capacity;
+  vertex_desc.Usage = BufferUsage::Vertex;
+  vertex_desc.CPUVisible = false;
+
+  BufferDesc index_desc {};
+  index_desc.Size = sizeof(uint32_t) * index_capacity;
+  index_desc.Usage = BufferUsage::Index;
+  index_desc.CPUVisible = false;
+
+  auto page = std::make_unique<Page>(Page {
+      .VertexBuffer = m_Device.CreateBuffer(vertex_desc),
+      .IndexBuffer = m_Device.CreateBuffer(index_desc),
+      .Vertices = FreeListAllocator(vertex_capacity),
+      .Indices = FreeListAllocator(index_capacity),
+  });
+
+  // Reuse the slot of a released page before growing the list
+  const auto slot = std::ranges::find(m_Pages, nullptr);
+  const auto index = static_cast<uint32_t>(slot - m_Pages.begin());
+  if (slot == m_Pages.end()) {
+    m_Pages.push_back(std::move(page));
+  } else {
+    *slot = std::move(page);
+  }
+
+  Logger::Trace("[GeometryPool] Added page {} ({} vertices, {} indices)",
+                index,
+                vertex_capacity,
+                index_capacity);
+  return index;
+}
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "Renderer/Model/Mesh.hpp"
 
 #include "Renderer/RHI/RHIBuffer.hpp"
@@ -35,7 +37,10 @@ void Mesh::SetIndices(std::vector<uint32_t> indices)
 
 void Mesh::AddSubMesh(const SubMesh& submesh)
 {
-  m_SubMeshes.push_back(submesh);
+  SubMesh rebased = submesh;
+  rebased.IndexOffset += get_base_index();
+  rebased.VertexOffset += get_base_vertex();
+  m_SubMeshes.push_back(rebased);
 }
 
 void Mesh::AddSubMesh(uint32_t index_offset,
@@ -43,11 +48,11 @@ void Mesh::AddSubMesh(uint32_t index_offset,
                       uint32_t material_index)
 {
   SubMesh submesh {};
-  submesh.IndexOffset = index_offset;
+  submesh.IndexOffset = get_base_index() + index_offset;
   submesh.IndexCount = index_count;
-  submesh.VertexOffset = 0;
+  submesh.VertexOffset = get_base_vertex();
   submesh.MaterialIndex = material_index;
-  submesh.LocalBounds = m_Bounds;  // TODO: compute per-submesh bounds
+  submesh.LocalBounds = compute_submesh_bounds(submesh);
   m_SubMeshes.push_back(submesh);
 }
 
@@ -56,9 +61,9 @@ void Mesh::CreateSingleSubMesh(uint32_t material_index)
   m_SubMeshes.clear();
 
   SubMesh submesh {};
-  submesh.IndexOffset = 0;
+  submesh.IndexOffset = get_base_index();
   submesh.IndexCount = static_cast<uint32_t>(m_Indices.size());
-  submesh.VertexOffset = 0;
+  submesh.VertexOffset = get_base_vertex();
   submesh.MaterialIndex = material_index;
   submesh.LocalBounds = m_Bounds;
   m_SubMeshes.push_back(submesh);
@@ -70,29 +75,46 @@ void Mesh::CreateBuffers(RHIDevice& device)
     return;
   }
 
-  // Create vertex buffer
+  // Static geometry lives in device-local memory, filled through staging
   BufferDesc vertex_buffer_desc {};
   vertex_buffer_desc.Size = sizeof(Vertex) * m_Vertices.size();
   vertex_buffer_desc.Usage = BufferUsage::Vertex;
-  vertex_buffer_desc.CPUVisible = true;
+  vertex_buffer_desc.CPUVisible = false;
   m_VertexBuffer = device.CreateBuffer(vertex_buffer_desc);
-  m_VertexBuffer->Upload(m_Vertices.data(), vertex_buffer_desc.Size, 0);
+  device.UploadBuffer(
+      *m_VertexBuffer, m_Vertices.data(), vertex_buffer_desc.Size, 0);
 
   // Create index buffer if we have indices
   if (!m_Indices.empty()) {
     BufferDesc index_buffer_desc {};
     index_buffer_desc.Size = sizeof(uint32_t) * m_Indices.size();
     index_buffer_desc.Usage = BufferUsage::Index;
-    index_buffer_desc.CPUVisible = true;
+    index_buffer_desc.CPUVisible = false;
     m_IndexBuffer = device.CreateBuffer(index_buffer_desc);
-    m_IndexBuffer->Upload(m_Indices.data(), index_buffer_desc.Size, 0);
+    device.UploadBuffer(
+        *m_IndexBuffer, m_Indices.data(), index_buffer_desc.Size, 0);
+  }
+
+  m_BuffersCreated = true;
+}
+
+void Mesh::CreateBuffers(GeometryPool& pool)
+{
+  if (m_BuffersCreated || m_Vertices.empty()) {
+    return;
   }
 
+  m_Geometry = pool.Allocate(m_Vertices, m_Indices);
+  rebase_submeshes({}, m_Geometry.GetRange());
   m_BuffersCreated = true;
 }
 
 void Mesh::DestroyBuffers()
 {
+  if (m_Geometry.IsValid()) {
+    rebase_submeshes(m_Geometry.GetRange(), {});
+    m_Geometry.Reset();
+  }
   m_VertexBuffer.reset();
   m_IndexBuffer.reset();
   m_BuffersCreated = false;
@@ -105,11 +127,15 @@ auto Mesh::GetName() const -> const std::string&
 
 auto Mesh::GetVertexBuffer() const -> RHIBuffer*
 {
-  return m_VertexBuffer.get();
+  return m_Geometry.IsValid() ? m_Geometry.GetVertexBuffer()
+                              : m_VertexBuffer.get();
 }
 
 auto Mesh::GetIndexBuffer() const -> RHIBuffer*
 {
+  if (m_Geometry.IsValid()) {
+    return m_Indices.empty() ? nullptr : m_Geometry.GetIndexBuffer();
+  }
   return m_IndexBuffer.get();
 }
 
@@ -153,6 +179,11 @@ auto Mesh::AreBuffersCreated() const -> bool
   return m_BuffersCreated;
 }
 
+auto Mesh::IsPooled() const -> bool
+{
+  return m_Geometry.IsValid();
+}
+
 auto Mesh::GetVertices() const -> const std::vector<Vertex>&
 {
   return m_Vertices;
@@ -172,10 +203,53 @@ void Mesh::ComputeBounds()
 
   // Update submesh bounds as well
   for (auto& submesh : m_SubMeshes) {
-    submesh.LocalBounds = m_Bounds;
+    submesh.LocalBounds = compute_submesh_bounds(submesh);
+  }
+}
+
+auto Mesh::compute_submesh_bounds(const SubMesh& submesh) const -> AABB
+{
+  // Without index data a submesh can only be bounded by the whole mesh
+  if (m_Indices.empty()) {
+    return m_Bounds;
+  }
+
+  // Pooled submeshes address the page, the CPU copy starts at zero
+  const size_t index_offset = submesh.IndexOffset - get_base_index();
+  const size_t vertex_offset = submesh.VertexOffset - get_base_vertex();
+
+  AABB bounds;
+  const size_t end =
+      std::min(m_Indices.size(), index_offset + submesh.IndexCount);
+  for (size_t i = index_offset; i < end; ++i) {
+    const size_t vertex = vertex_offset + m_Indices[i];
+    if (vertex < m_Vertices.size()) {
+      bounds.Expand(m_Vertices[vertex].Position);
+    }
+  }
+  return bounds;
+}
+
+void Mesh::rebase_submeshes(const GeometryRange& from,
+                            const GeometryRange& to)
+{
+  for (auto& submesh : m_SubMeshes) {
+    submesh.IndexOffset = submesh.IndexOffset - from.FirstIndex + to.FirstIndex;
+    submesh.VertexOffset =
+        submesh.VertexOffset - from.FirstVertex + to.FirstVertex;
   }
 }
 
+auto Mesh::get_base_vertex() const -> uint32_t
+{
+  return m_Geometry.IsValid() ? m_Geometry.GetRange().FirstVertex : 0;
+}
+
+auto Mesh::get_base_index() const -> uint32_t
+{
+  return m_Geometry.IsValid() ? m_Geometry.GetRange().FirstIndex : 0;
+}
+
 void Mesh::ComputeTangents()
 {
   if (!m_Indices.empty() && !m_Vertices.empty()) {
@@ -33,7 +33,8 @@ void Model::CreateResources(
     const std::shared_ptr<RHIDescriptorSetLayout>& material_layout,
     RHISampler* default_sampler,
     RHITexture* default_texture,
-    RHITexture* default_normal)
+    RHITexture* default_normal,
+    GeometryPool* geometry_pool)
 {
   if (m_ResourcesCreated) {
     return;
@@ -41,7 +42,11 @@ void Model::CreateResources(
 
   // Create mesh buffers
   for (auto& mesh : m_Meshes) {
-    mesh->CreateBuffers(device);
+    if (geometry_pool != nullptr) {
+      mesh->CreateBuffers(*geometry_pool);
+    } else {
+      mesh->CreateBuffers(device);
+    }
   }
 
   // Create material descriptor sets
@@ -0,0 +1,56 @@
+#include <cstring>
+#include <format>
+#include <stdexcept>
+
+#include "Renderer/RHI/Null/NullBuffer.hpp"
+
+#include "Core/Logger.hpp"
+
+NullBuffer::NullBuffer(const BufferDesc& desc)
+    : m_Data(desc.Size)
+    , m_Usage(desc.Usage)
+    , m_Persistent(desc.CPUVisible && desc.PersistentMap)
+    , m_CPUVisible(desc.CPUVisible)
+{
+  Logger::Trace("[Null] Created buffer with size {}", desc.Size);
+}
+
+auto NullBuffer::Map() -> void*
+{
+  // Matches the GPU backends, which cannot map device-local memory
+  if (!m_CPUVisible) {
+    throw std::runtime_error("Cannot map a Null buffer created without "
+                             "CPUVisible");
+  }
+  return m_Data.data();
+}
+
+void NullBuffer::Unmap() {}
+
+void NullBuffer::Upload(const void* data, size_t size, size_t offset)
+{
+  if (offset + size > m_Data.size()) {
+    throw std::runtime_error(
+        std::format("Null buffer upload out of range: {} + {} > {}",
+                    offset,
+                    size,
+                    m_Data.size()));
+  }
+  std::memcpy(m_Data.data() + offset, data, size);
+}
+
+void NullBuffer::Flush(size_t offset, size_t size)
+{
+  if (offset + size > m_Data.size()) {
+    throw std::runtime_error(
+        std::format("Null buffer flush out of range: {} + {} > {}",
+                    offset,
+                    size,
+                    m_Data.size()));
+  }
+}
+
+auto NullBuffer::GetSize() const -> size_t
+{
+  return m_Data.size();
+}
@@ -0,0 +1,178 @@
+#include <bit>
+
+#include "Renderer/RHI/Null/NullCommandBuffer.hpp"
+
+void NullCommandBuffer::Begin()
+{
+  m_Commands.clear();
+  m_DynamicOffsets.clear();
+  m_Barriers.clear();
+  m_CommandCounts.fill(0);
+  m_Recording = true;
+  m_InRenderPass = false;
+}
+
+void NullCommandBuffer::End()
+{
+  m_Recording = false;
+}
+
+void NullCommandBuffer::BeginRenderPass(const RenderPassInfo& info)
+{
+  auto& command = record(NullCommandType::BeginRenderPass);
+  command.Object = info.RenderTarget;
+  command.Args = {info.Width,
+                  info.Height,
+                  info.ColorAttachmentCount,
+                  info.DepthStencilAttachment != nullptr ? 1U : 0U,
+                  0};
+  m_InRenderPass = true;
+}
+
+void NullCommandBuffer::EndRenderPass()
+{
+  record(NullCommandType::EndRenderPass);
+  m_InRenderPass = false;
+}
+
+void NullCommandBuffer::Barrier(std::span<const TextureBarrier> barriers)
+{
+  auto& command = record(NullCommandType::Barrier);
+  command.Args[0] = static_cast<uint32_t>(m_Barriers.size());
+  command.Args[1] = static_cast<uint32_t>(barriers.size());
+  m_Barriers.insert(m_Barriers.end(), barriers.begin(), barriers.end());
+}
+
+void NullCommandBuffer::BindShaders(const RHIShaderModule* vertex_shader,
+                                    const RHIShaderModule* fragment_shader)
+{
+  auto& command = record(NullCommandType::BindShaders);
+  command.Object = vertex_shader;
+  command.SecondaryObject = fragment_shader;
+}
+
+void NullCommandBuffer::BindVertexBuffer(const RHIBuffer& buffer,
+                                         uint32_t binding)
+{
+  auto& command = record(NullCommandType::BindVertexBuffer);
+  command.Object = &buffer;
+  command.Args[0] = binding;
+}
+
+void NullCommandBuffer::BindIndexBuffer(const RHIBuffer& buffer)
+{
+  record(NullCommandType::BindIndexBuffer).Object = &buffer;
+}
+
+void NullCommandBuffer::SetVertexInput(const VertexInputLayout& layout)
+{
+  auto& command = record(NullCommandType::SetVertexInput);
+  command.Args[0] = layout.Stride;
+  command.Args[1] = static_cast<uint32_t>(layout.Attributes.size());
+}
+
+void NullCommandBuffer::SetPrimitiveTopology(PrimitiveTopology topology)
+{
+  record(NullCommandType::SetPrimitiveTopology).Args[0] =
+      static_cast<uint32_t>(topology);
+}
+
+void NullCommandBuffer::SetPolygonMode(PolygonMode mode)
+{
+  record(NullCommandType::SetPolygonMode).Args[0] =
+      static_cast<uint32_t>(mode);
+}
+
+void NullCommandBuffer::BindDescriptorSet(
+    uint32_t set_index,
+    const RHIDescriptorSet& descriptor_set,
+    const RHIPipelineLayout& layout,
+    std::span<const uint32_t> dynamic_offsets)
+{
+  auto& command = record(NullCommandType::BindDescriptorSet);
+  command.Object = &descriptor_set;
+  command.SecondaryObject = &layout;
+  command.Args[0] = set_index;
+  command.Args[1] = static_cast<uint32_t>(m_DynamicOffsets.size());
+  command.Args[2] = static_cast<uint32_t>(dynamic_offsets.size());
+  m_DynamicOffsets.insert(
+      m_DynamicOffsets.end(), dynamic_offsets.begin(), dynamic_offsets.end());
+}
+
+void NullCommandBuffer::Draw(uint32_t vertex_count,
+                             uint32_t instance_count,
+                             uint32_t first_vertex,
+                             uint32_t first_instance)
+{
+  record(NullCommandType::Draw).Args = {
+      vertex_count, instance_count, first_vertex, first_instance, 0};
+}
+
+void NullCommandBuffer::DrawIndexed(uint32_t index_count,
+                                    uint32_t instance_count,
+                                    uint32_t first_index,
+                                    int32_t vertex_offset,
+                                    uint32_t first_instance)
+{
+  record(NullCommandType::DrawIndexed).Args = {
+      index_count,
+      instance_count,
+      first_index,
+      std::bit_cast<uint32_t>(vertex_offset),
+      first_instance};
+}
+
+void NullCommandBuffer::DrawIndexedIndirect(const RHIBuffer& args_buffer,
+                                            size_t offset,
+                                            uint32_t draw_count,
+                                            uint32_t stride)
+{
+  auto& command = record(NullCommandType::DrawIndexedIndirect);
+  command.Object = &args_buffer;
+  command.Args = {static_cast<uint32_t>(offset), draw_count, stride, 0, 0};
+}
+
+void NullCommandBuffer::DrawIndexedIndirectCount(const RHIBuffer& args_buffer,
+                                                 size_t offset,
+                                                 const RHIBuffer& count_buffer,
+                                                 size_t count_offset,
+                                                 uint32_t max_draw_count,
+                                                 uint32_t stride)
+{
+  auto& command = record(NullCommandType::DrawIndexedIndirectCount);
+  command.Object = &args_buffer;
+  command.SecondaryObject = &count_buffer;
+  command.Args = {static_cast<uint32_t>(offset),
+                  max_draw_count,
+                  stride,
+                  static_cast<uint32_t>(count_offset),
+                  0};
+}
+
+auto NullCommandBuffer::GetDynamicOffsets(const NullCommand& command) const
+    -> std::span<const uint32_t>
+{
+  if (command.Type != NullCommandType::BindDescriptorSet) {
+    return {};
+  }
+  return std::span<const uint32_t>(m_DynamicOffsets)
+      .subspan(command.Args[1], command.Args[2]);
+}
+
+auto NullCommandBuffer::GetBarriers(const NullCommand& command) const
+    -> std::span<const TextureBarrier>
+{
+  if (command.Type != NullCommandType::Barrier) {
+    return {};
+  }
+  return std::span<const TextureBarrier>(m_Barriers)
+      .subspan(command.Args[0], command.Args[1]);
+}
+
+auto NullCommandBuffer::record(NullCommandType type) -> NullCommand&
+{
+  ++m_CommandCounts.at(static_cast<size_t>(type));
+  auto& command = m_Commands.emplace_back();
+  command.Type = type;
+  return command;
+}
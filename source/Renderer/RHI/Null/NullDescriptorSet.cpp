@@ -0,0 +1,50 @@
+#include "Renderer/RHI/Null/NullDescriptorSet.hpp"
+
+#include "Core/Logger.hpp"
+
+NullDescriptorSetLayout::NullDescriptorSetLayout(
+    const DescriptorSetLayoutDesc& desc)
+    : m_Bindings(desc.Bindings)
+{
+  Logger::Trace("[Null] Created descriptor set layout with {} bindings",
+                m_Bindings.size());
+}
+
+auto NullDescriptorSetLayout::GetBindings() const
+    -> const std::vector<DescriptorBinding>&
+{
+  return m_Bindings;
+}
+
+NullDescriptorSet::NullDescriptorSet(
+    const std::shared_ptr<RHIDescriptorSetLayout>& layout)
+    : m_Layout(layout)
+{
+}
+
+void NullDescriptorSet::WriteBuffer(uint32_t binding,
+                                    RHIBuffer* buffer,
+                                    size_t offset,
+                                    size_t range)
+{
+  auto& write = m_Writes[binding];
+  write.Buffer = buffer;
+  write.Offset = offset;
+  write.Range = range;
+}
+
+void NullDescriptorSet::WriteCombinedImageSampler(uint32_t binding,
+                                                  RHITexture* texture,
+                                                  RHISampler* sampler)
+{
+  auto& write = m_Writes[binding];
+  write.Texture = texture;
+  write.Sampler = sampler;
+}
+
+auto NullDescriptorSet::GetWrite(uint32_t binding) const
+    -> const NullDescriptorWrite*
+{
+  const auto iter = m_Writes.find(binding);
+  return iter != m_Writes.end() ? &iter->second : nullptr;
+}
@@ -0,0 +1,187 @@
+#include <chrono>
+
+#include "Renderer/RHI/Null/NullDevice.hpp"
+
+#include "Core/Logger.hpp"
+#include "Renderer/RHI/Null/NullBuffer.hpp"
+#include "Renderer/RHI/Null/NullDescriptorSet.hpp"
+#include "Renderer/RHI/Null/NullPipelineLayout.hpp"
+#include "Renderer/RHI/Null/NullRenderTarget.hpp"
+#include "Renderer/RHI/Null/NullSampler.hpp"
+#include "Renderer/RHI/Null/NullShaderModule.hpp"
+#include "Renderer/RHI/Null/NullTexture.hpp"
+#include "Renderer/RendererConfig.hpp"
+
+void NullDevice::Init([[maybe_unused]] const RendererConfig& config,
+                      void* window)
+{
+  if (m_Initialized) {
+    return;
+  }
+
+  Logger::Info("Initializing Null device");
+
+  m_Window = window;
+  m_CommandBuffer = std::make_unique<NullCommandBuffer>();
+  m_FrameCount = 0;
+
+  m_Initialized = true;
+  Logger::Info("Null device initialized successfully");
+}
+
+void NullDevice::CreateSwapchain(uint32_t width, uint32_t height)
+{
+  m_Swapchain = std::make_unique<NullSwapchain>(width, height);
+  Logger::Info("Null swapchain created ({}x{})", width, height);
+}
+
+void NullDevice::Destroy()
+{
+  if (!m_Initialized) {
+    return;
+  }
+
+  Logger::Trace("Null device shutting down");
+  m_CommandBuffer.reset();
+  m_Swapchain.reset();
+  m_Window = nullptr;
+
+  m_Initialized = false;
+}
+
+void NullDevice::BeginFrame()
+{
+  if (!m_CommandBuffer) {
+    return;
+  }
+
+  m_CommandBuffer->Begin();
+}
+
+void NullDevice::EndFrame()
+{
+  if (!m_CommandBuffer) {
+    return;
+  }
+
+  m_CommandBuffer->End();
+  FlushUploads();
+}
+
+void NullDevice::Present()
+{
+  ++m_FrameCount;
+}
+
+void NullDevice::WaitIdle() {}
+
+auto NullDevice::GetSwapchain() const -> RHISwapchain*
+{
+  return m_Swapchain.get();
+}
+
+auto NullDevice::GetCurrentCommandBuffer() -> RHICommandBuffer*
+{
+  return m_CommandBuffer.get();
+}
+
+auto NullDevice::CreateRenderTarget(const RenderTargetDesc& desc)
+    -> std::unique_ptr<RHIRenderTarget>
+{
+  return std::make_unique<NullRenderTarget>(desc);
+}
+
+void NullDevice::UploadBuffer(RHIBuffer& buffer,
+                              const void* data,
+                              size_t size,
+                              size_t offset)
+{
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
+
+  buffer.Upload(data, size, offset);
+
+  m_UploadStats.Bytes += size;
+  ++m_UploadStats.Copies;
+  m_UploadStats.HostSeconds +=
+      std::chrono::duration<double>(Clock::now() - start).count();
+  ++m_PendingUploads;
+}
+
+void NullDevice::UploadTexture(RHITexture& texture,
+                               const void* data,
+                               size_t size)
+{
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
+
+  texture.Upload(data, size);
+
+  m_UploadStats.Bytes += size;
+  ++m_UploadStats.Copies;
+  ++m_UploadStats.TextureCopies;
+  m_UploadStats.HostSeconds +=
+      std::chrono::duration<double>(Clock::now() - start).count();
+  ++m_PendingUploads;
+}
+
+void NullDevice::FlushUploads()
+{
+  if (m_PendingUploads == 0) {
+    return;
+  }
+  ++m_UploadStats.Submissions;
+  m_PendingUploads = 0;
+}
+
+auto NullDevice::CreateBuffer(const BufferDesc& desc)
+    -> std::unique_ptr<RHIBuffer>
+{
+  return std::make_unique<NullBuffer>(desc);
+}
+
+auto NullDevice::CreateTexture(const TextureDesc& desc)
+    -> std::unique_ptr<RHITexture>
+{
+  return std::make_unique<NullTexture>(desc);
+}
+
+auto NullDevice::CreateSampler(const SamplerDesc& desc)
+    -> std::unique_ptr<RHISampler>
+{
+  return std::make_unique<NullSampler>(desc);
+}
+
+auto NullDevice::CreateShaderModule(const ShaderModuleDesc& desc)
+    -> std::unique_ptr<RHIShaderModule>
+{
+  return std::make_unique<NullShaderModule>(desc);
+}
+
+auto NullDevice::CreateGraphicsPipeline(
+    [[maybe_unused]] const GraphicsPipelineDesc& desc)
+    -> std::unique_ptr<RHIGraphicsPipeline>
+{
+  // Matches the other backends, which bind shaders directly
+  return nullptr;
+}
+
+auto NullDevice::CreateDescriptorSetLayout(const DescriptorSetLayoutDesc& desc)
+    -> std::shared_ptr<RHIDescriptorSetLayout>
+{
+  return std::make_shared<NullDescriptorSetLayout>(desc);
+}
+
+auto NullDevice::CreateDescriptorSet(
+    const std::shared_ptr<RHIDescriptorSetLayout>& layout)
+    -> std::unique_ptr<RHIDescriptorSet>
+{
+  return std::make_unique<NullDescriptorSet>(layout);
+}
+
+auto NullDevice::CreatePipelineLayout(
+    const std::vector<std::shared_ptr<RHIDescriptorSetLayout>>& set_layouts)
+    -> std::shared_ptr<RHIPipelineLayout>
+{
+  return std::make_shared<NullPipelineLayout>(set_layouts);
+}
@@ -0,0 +1,79 @@
+#include "Renderer/RHI/Null/NullImGui.hpp"
+
+#include <imgui.h>
+#include <imgui_impl_sdl3.h>
+
+#include "Core/Logger.hpp"
+#include "Core/Window.hpp"
+#include "Renderer/RHI/Null/NullDevice.hpp"
+#include "Renderer/RHI/RHISwapchain.hpp"
+#include "UI/ImGuiStyle.hpp"
+
+NullImGui::NullImGui(NullDevice& device)
+    : m_Device(device)
+{
+}
+
+void NullImGui::Init(Window& window)
+{
+  Logger::Info("Initializing Null ImGui backend");
+
+  IMGUI_CHECKVERSION();
+  ImGui::CreateContext();
+
+  ImGuiIO& imgui_io = ImGui::GetIO();
+  imgui_io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+
+  // No renderer backend uploads the atlas, so build it here; NewFrame
+  // asserts otherwise.
+  imgui_io.Fonts->AddFontDefault();
+  imgui_io.Fonts->Build();
+
+  UIStyle::ApplyFlatTheme();
+
+  auto* sdl_window = static_cast<SDL_Window*>(window.GetNativeWindow());
+  if (sdl_window != nullptr) {
+    m_HasPlatformBackend = ImGui_ImplSDL3_InitForOther(sdl_window);
+  }
+
+  Logger::Info("Null ImGui backend initialized");
+}
+
+void NullImGui::Shutdown()
+{
+  Logger::Info("Shutting down Null ImGui backend");
+
+  if (m_HasPlatformBackend) {
+    ImGui_ImplSDL3_Shutdown();
+    m_HasPlatformBackend = false;
+  }
+  ImGui::DestroyContext();
+}
+
+void NullImGui::BeginFrame()
+{
+  if (m_HasPlatformBackend) {
+    ImGui_ImplSDL3_NewFrame();
+  } else {
+    constexpr float FIXED_DELTA_TIME = 1.0F / 60.0F;
+    ImGuiIO& imgui_io = ImGui::GetIO();
+    imgui_io.DeltaTime = FIXED_DELTA_TIME;
+    if (const auto* swapchain = m_Device.GetSwapchain(); swapchain != nullptr)
+    {
+      imgui_io.DisplaySize = ImVec2(static_cast<float>(swapchain->GetWidth()),
+                                    static_cast<float>(swapchain->GetHeight()));
+    }
+  }
+  ImGui::NewFrame();
+}
+
+void NullImGui::EndFrame()
+{
+  // Finalize the draw lists so UI cost is still measured, then drop them
+  ImGui::Render();
+}
+
+auto NullImGui::RegisterTexture(RHITexture* texture) -> void*
+{
+  return texture;
+}
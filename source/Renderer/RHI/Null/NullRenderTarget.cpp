@@ -0,0 +1,61 @@
+#include "Renderer/RHI/Null/NullRenderTarget.hpp"
+
+#include "Core/Logger.hpp"
+#include "Renderer/RHI/Null/NullTexture.hpp"
+
+NullRenderTarget::NullRenderTarget(const RenderTargetDesc& desc)
+    : m_Width(desc.Width)
+    , m_Height(desc.Height)
+{
+  for (const auto format : desc.ColorFormats) {
+    TextureDesc color_desc;
+    color_desc.Width = desc.Width;
+    color_desc.Height = desc.Height;
+    color_desc.Format = format;
+    color_desc.Usage = TextureUsage::ColorAttachment | TextureUsage::Sampled;
+    m_ColorTextures.push_back(std::make_unique<NullTexture>(color_desc));
+  }
+
+  if (desc.HasDepth) {
+    TextureDesc depth_desc;
+    depth_desc.Width = desc.Width;
+    depth_desc.Height = desc.Height;
+    depth_desc.Format = desc.DepthFormat;
+    depth_desc.Usage =
+        TextureUsage::DepthStencilAttachment | TextureUsage::Sampled;
+    m_DepthTexture = std::make_unique<NullTexture>(depth_desc);
+  }
+
+  Logger::Trace("[Null] Created render target {}x{} with {} color attachment(s)",
+                desc.Width,
+                desc.Height,
+                m_ColorTextures.size());
+}
+
+NullRenderTarget::~NullRenderTarget() = default;
+
+auto NullRenderTarget::GetWidth() const -> uint32_t
+{
+  return m_Width;
+}
+
+auto NullRenderTarget::GetHeight() const -> uint32_t
+{
+  return m_Height;
+}
+
+auto NullRenderTarget::GetColorTexture(size_t index) -> RHITexture*
+{
+  return index < m_ColorTextures.size() ? m_ColorTextures[index].get()
+                                        : nullptr;
+}
+
+auto NullRenderTarget::GetColorTextureCount() const -> size_t
+{
+  return m_ColorTextures.size();
+}
+
+auto NullRenderTarget::GetDepthTexture() -> RHITexture*
+{
+  return m_DepthTexture.get();
+}
@@ -0,0 +1,10 @@
+#include "Renderer/RHI/Null/NullShaderModule.hpp"
+
+#include "Core/Logger.hpp"
+
+NullShaderModule::NullShaderModule(const ShaderModuleDesc& desc)
+    : m_Stage(desc.Stage)
+    , m_EntryPoint(desc.EntryPoint)
+{
+  Logger::Trace("[Null] Created {} shader module", ToString(m_Stage));
+}
@@ -0,0 +1,13 @@
+#include "Renderer/RHI/Null/NullSwapchain.hpp"
+
+NullSwapchain::NullSwapchain(uint32_t width, uint32_t height)
+{
+  m_Width = width;
+  m_Height = height;
+}
+
+void NullSwapchain::Resize(uint32_t width, uint32_t height)
+{
+  m_Width = width;
+  m_Height = height;
+}
@@ -0,0 +1,36 @@
+#include <algorithm>
+#include <cstring>
+
+#include "Renderer/RHI/Null/NullTexture.hpp"
+
+#include "Core/Logger.hpp"
+
+NullTexture::NullTexture(const TextureDesc& desc)
+    : m_Data(static_cast<size_t>(desc.Width) * desc.Height
+             * GetBytesPerPixel(desc.Format))
+    , m_Width(desc.Width)
+    , m_Height(desc.Height)
+    , m_Format(desc.Format)
+{
+  Logger::Trace("[Null] Created texture {}x{}", m_Width, m_Height);
+}
+
+auto NullTexture::GetWidth() const -> uint32_t
+{
+  return m_Width;
+}
+
+auto NullTexture::GetHeight() const -> uint32_t
+{
+  return m_Height;
+}
+
+auto NullTexture::GetFormat() const -> TextureFormat
+{
+  return m_Format;
+}
+
+void NullTexture::Upload(const void* data, size_t size)
+{
+  std::memcpy(m_Data.data(), data, std::min(size, m_Data.size()));
+}
@@ -1,46 +1,89 @@
+#include <cstddef>
+#include <cstring>
+#include <format>
 #include <stdexcept>
+#include <utility>
 
 #include "Renderer/RHI/OpenGL/OpenGLBuffer.hpp"
 
 #include "Core/Logger.hpp"
+#include "Renderer/RHI/OpenGL/OpenGLVertexArrayCache.hpp"
 #include "Renderer/RHI/RHIBuffer.hpp"
 
-OpenGLBuffer::OpenGLBuffer(const BufferDesc& desc)
-    : m_Size(desc.Size)
+// All storage calls go through the buffer name rather than a binding point:
+// binding an index buffer to GL_ELEMENT_ARRAY_BUFFER would change whichever
+// vertex array is bound at the time
+OpenGLBuffer::OpenGLBuffer(
+    const BufferDesc& desc,
+    std::weak_ptr<OpenGLVertexArrayCache> vertex_array_cache)
+    : m_VertexArrayCache(std::move(vertex_array_cache))
+    , m_Size(desc.Size)
 {
   // Determine primary target based on usage
   if ((desc.Usage & BufferUsage::Index) != BufferUsage {}) {
     m_Target = GL_ELEMENT_ARRAY_BUFFER;
   } else if ((desc.Usage & BufferUsage::Uniform) != BufferUsage {}) {
     m_Target = GL_UNIFORM_BUFFER;
+  } else if ((desc.Usage & BufferUsage::Indirect) != BufferUsage {}) {
+    m_Target = GL_DRAW_INDIRECT_BUFFER;
+  } else if ((desc.Usage & BufferUsage::Storage) != BufferUsage {}) {
+    m_Target = GL_SHADER_STORAGE_BUFFER;
   } else {
     m_Target = GL_ARRAY_BUFFER;
   }
 
-  glGenBuffers(1, &m_Buffer);
+  glCreateBuffers(1, &m_Buffer);
   if (m_Buffer == 0) {
     throw std::runtime_error("Failed to create OpenGL buffer");
   }
 
-  glBindBuffer(m_Target, m_Buffer);
-
-  const GLenum usage_hint = desc.CPUVisible ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW;
-
-  glBufferData(
-      m_Target, static_cast<GLsizeiptr>(desc.Size), nullptr, usage_hint);
-
-  glBindBuffer(m_Target, 0);
+  if (desc.CPUVisible && desc.PersistentMap) {
+    // Immutable storage mapped once; coherent writes need no explicit flush
+    constexpr GLbitfield MAP_FLAGS =
+        GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glNamedBufferStorage(m_Buffer,
+                         static_cast<GLsizeiptr>(desc.Size),
+                         nullptr,
+                         MAP_FLAGS | GL_DYNAMIC_STORAGE_BIT);
+    m_MappedPtr = glMapNamedBufferRange(
+        m_Buffer, 0, static_cast<GLsizeiptr>(desc.Size), MAP_FLAGS);
+    if (m_MappedPtr == nullptr) {
+      glDeleteBuffers(1, &m_Buffer);
+      throw std::runtime_error("Failed to persistently map OpenGL buffer");
+    }
+    m_Persistent = true;
+  } else if (!desc.CPUVisible) {
+    // Immutable storage the CPU never maps lets the driver keep it in video
+    // memory; glNamedBufferSubData() still updates it
+    glNamedBufferStorage(m_Buffer,
+                         static_cast<GLsizeiptr>(desc.Size),
+                         nullptr,
+                         GL_DYNAMIC_STORAGE_BIT);
+    m_DeviceLocal = true;
+  } else {
+    glNamedBufferData(m_Buffer,
+                      static_cast<GLsizeiptr>(desc.Size),
+                      nullptr,
+                      GL_DYNAMIC_DRAW);
+  }
 
-  Logger::Trace("[OpenGL] Created buffer with size {}", desc.Size);
+  Logger::Trace("[OpenGL] Created buffer with size {}{}",
+                desc.Size,
+                m_Persistent ? " (persistently mapped)" : "");
 }
 
 OpenGLBuffer::~OpenGLBuffer()
 {
-  if (m_Mapped) {
+  if (m_Persistent) {
+    glUnmapNamedBuffer(m_Buffer);
+  } else if (m_Mapped) {
     Unmap();
   }
 
   if (m_Buffer != 0) {
+    if (auto vertex_array_cache = m_VertexArrayCache.lock()) {
+      vertex_array_cache->Invalidate(m_Buffer);
+    }
     glDeleteBuffers(1, &m_Buffer);
   }
 
@@ -49,16 +92,20 @@ OpenGLBuffer::~OpenGLBuffer()
 
 auto OpenGLBuffer::Map() -> void*
 {
+  if (m_Persistent) {
+    return m_MappedPtr;
+  }
+  if (m_DeviceLocal) {
+    throw std::runtime_error("Cannot map a device-local OpenGL buffer");
+  }
+
   if (m_Mapped) {
-    glBindBuffer(m_Target, m_Buffer);
-    return glMapBuffer(m_Target, GL_READ_WRITE);
+    return glMapNamedBuffer(m_Buffer, GL_READ_WRITE);
   }
 
-  glBindBuffer(m_Target, m_Buffer);
-  void* ptr = glMapBuffer(m_Target, GL_READ_WRITE);  // NOLINT
+  void* ptr = glMapNamedBuffer(m_Buffer, GL_READ_WRITE);  // NOLINT
 
   if (ptr == nullptr) {
-    glBindBuffer(m_Target, 0);
     throw std::runtime_error("Failed to map OpenGL buffer");
   }
 
@@ -68,23 +115,37 @@ auto OpenGLBuffer::Map() -> void*
 
 void OpenGLBuffer::Upload(const void* data, size_t size, size_t offset)
 {
-  glBindBuffer(m_Target, m_Buffer);
-  glBufferSubData(m_Target,
-                  static_cast<GLintptr>(offset),
-                  static_cast<GLsizeiptr>(size),
-                  data);
-  glBindBuffer(m_Target, 0);
+  if (m_Persistent) {
+    if (offset + size > m_Size) {
+      throw std::runtime_error(
+          std::format("OpenGL buffer upload out of range: {} + {} > {}",
+                      offset,
+                      size,
+                      m_Size));
+    }
+    std::memcpy(static_cast<std::byte*>(m_MappedPtr) + offset, data, size);
+    return;
+  }
+
+  glNamedBufferSubData(m_Buffer,
+                       static_cast<GLintptr>(offset),
+                       static_cast<GLsizeiptr>(size),
+                       data);
+}
+
+// Persistent mappings are coherent, so writes need no flush
+void OpenGLBuffer::Flush([[maybe_unused]] size_t offset,
+                         [[maybe_unused]] size_t size)
+{
 }
 
 void OpenGLBuffer::Unmap()
 {
-  if (!m_Mapped) {
+  if (!m_Mapped || m_Persistent) {
     return;
   }
 
-  glBindBuffer(m_Target, m_Buffer);
-  glUnmapBuffer(m_Target);
-  glBindBuffer(m_Target, 0);
+  glUnmapNamedBuffer(m_Buffer);
   m_Mapped = false;
 }
 
@@ -1,4 +1,3 @@
-#include <format>
 #include <stdexcept>
 
 #include "Renderer/RHI/OpenGL/OpenGLCommandBuffer.hpp"
@@ -8,13 +7,24 @@
 #include "Core/Logger.hpp"
 #include "Renderer/RHI/OpenGL/OpenGLBuffer.hpp"
 #include "Renderer/RHI/OpenGL/OpenGLDescriptorSet.hpp"
+#include "Renderer/RHI/OpenGL/OpenGLProgramCache.hpp"
 #include "Renderer/RHI/OpenGL/OpenGLRenderTarget.hpp"
 #include "Renderer/RHI/OpenGL/OpenGLShaderModule.hpp"
 
+OpenGLCommandBuffer::OpenGLCommandBuffer(
+    OpenGLProgramCache& program_cache,
+    OpenGLVertexArrayCache& vertex_array_cache)
+    : m_ProgramCache(program_cache)
+    , m_VertexArrayCache(vertex_array_cache)
+{
+}
+
 void OpenGLCommandBuffer::Begin()
 {
   Logger::Trace("[OpenGL] Begin command buffer recording");
   m_Recording = true;
+  // Other code may have bound its own VAO since the last frame
+  m_VertexArrayDirty = true;
 }
 
 void OpenGLCommandBuffer::End()
@@ -87,15 +97,7 @@ void OpenGLCommandBuffer::EndRenderPass()
   m_CurrentRenderPass = {};
 }
 
-OpenGLCommandBuffer::~OpenGLCommandBuffer()
-{
-  if (m_CurrentProgram != 0) {
-    glDeleteProgram(m_CurrentProgram);
-  }
-  if (m_VAO != 0) {
-    glDeleteVertexArrays(1, &m_VAO);
-  }
-}
+OpenGLCommandBuffer::~OpenGLCommandBuffer() = default;
 
 void OpenGLCommandBuffer::BindShaders(const RHIShaderModule* vertex_shader,
                                       const RHIShaderModule* fragment_shader)
@@ -109,30 +111,9 @@ void OpenGLCommandBuffer::BindShaders(const RHIShaderModule* vertex_shader,
     throw std::runtime_error("Both vertex and fragment shaders are required");
   }
 
-  if (m_CurrentProgram != 0) {
-    glDeleteProgram(m_CurrentProgram);
-  }
-
-  m_CurrentProgram = glCreateProgram();
-  glAttachShader(m_CurrentProgram, gl_vertex->GetGLShader());
-  glAttachShader(m_CurrentProgram, gl_fragment->GetGLShader());
-  glLinkProgram(m_CurrentProgram);
-
-  GLint success = 0;
-  glGetProgramiv(m_CurrentProgram, GL_LINK_STATUS, &success);
-  if (success == 0) {
-    GLint log_length = 0;
-    glGetProgramiv(m_CurrentProgram, GL_INFO_LOG_LENGTH, &log_length);
-
-    std::string info_log(static_cast<size_t>(log_length), '\0');
-    glGetProgramInfoLog(m_CurrentProgram, log_length, nullptr, info_log.data());
-
-    glDeleteProgram(m_CurrentProgram);
-    m_CurrentProgram = 0;
-    throw std::runtime_error(
-        std::format("Failed to link shader program: {}", info_log));
-  }
-
+  // Linked on the first bind of the pair, reused afterwards
+  m_CurrentProgram = m_ProgramCache.GetProgram(gl_vertex->GetGLShader(),
+                                               gl_fragment->GetGLShader());
   glUseProgram(m_CurrentProgram);
   Logger::Trace("[OpenGL] Bound shader program");
 }
@@ -141,68 +122,42 @@ void OpenGLCommandBuffer::BindVertexBuffer(const RHIBuffer& buffer,
                                            uint32_t /*binding*/)
 {
   const auto& gl_buffer = dynamic_cast<const OpenGLBuffer&>(buffer);
-
-  if (m_VAO == 0) {
-    glGenVertexArrays(1, &m_VAO);
-  }
-  glBindVertexArray(m_VAO);
-  glBindBuffer(GL_ARRAY_BUFFER, gl_buffer.GetGLBuffer());
-
-  if (m_HasPendingLayout) {
-    applyVertexLayout();
+  if (m_VertexArrayKey.VertexBuffer != gl_buffer.GetGLBuffer()) {
+    m_VertexArrayKey.VertexBuffer = gl_buffer.GetGLBuffer();
+    m_VertexArrayDirty = true;
   }
 }
 
 void OpenGLCommandBuffer::BindIndexBuffer(const RHIBuffer& buffer)
 {
   const auto& gl_buffer = dynamic_cast<const OpenGLBuffer&>(buffer);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gl_buffer.GetGLBuffer());
+  if (m_VertexArrayKey.IndexBuffer != gl_buffer.GetGLBuffer()) {
+    m_VertexArrayKey.IndexBuffer = gl_buffer.GetGLBuffer();
+    m_VertexArrayDirty = true;
+  }
 }
 
 void OpenGLCommandBuffer::SetVertexInput(const VertexInputLayout& layout)
 {
-  m_PendingLayout = layout;
-  m_HasPendingLayout = true;
+  if (m_VertexArrayKey.Layout != layout) {
+    m_VertexArrayKey.Layout = layout;
+    m_VertexArrayDirty = true;
+  }
 }
 
-void OpenGLCommandBuffer::applyVertexLayout()
+void OpenGLCommandBuffer::bind_vertex_array()
 {
-  for (const auto& attr : m_PendingLayout.Attributes) {
-    GLint size = 3;
-    GLenum type = GL_FLOAT;
-
-    switch (attr.Format) {
-      case VertexFormat::Float:
-        size = 1;
-        type = GL_FLOAT;
-        break;
-      case VertexFormat::Float2:
-        size = 2;
-        type = GL_FLOAT;
-        break;
-      case VertexFormat::Float3:
-        size = 3;
-        type = GL_FLOAT;
-        break;
-      case VertexFormat::Float4:
-        size = 4;
-        type = GL_FLOAT;
-        break;
-      default:
-        size = 3;
-        type = GL_FLOAT;
-        break;
-    }
-
-    glEnableVertexAttribArray(attr.Location);
-    glVertexAttribPointer(
-        attr.Location,
-        size,
-        type,
-        GL_FALSE,
-        static_cast<GLsizei>(m_PendingLayout.Stride),
-        reinterpret_cast<const void*>(static_cast<uintptr_t>(attr.Offset)));
+  // Core profile requires a bound VAO even for attribute-less draws (e.g.
+  // fullscreen triangle), which get the VAO of their empty layout
+  if (!m_VertexArrayDirty
+      && m_VertexArrayGeneration == m_VertexArrayCache.GetGeneration())
+  {
+    return;
   }
+
+  glBindVertexArray(m_VertexArrayCache.GetVertexArray(m_VertexArrayKey));
+  m_VertexArrayDirty = false;
+  m_VertexArrayGeneration = m_VertexArrayCache.GetGeneration();
 }
 
 void OpenGLCommandBuffer::SetPrimitiveTopology(PrimitiveTopology topology)
@@ -257,12 +212,7 @@ void OpenGLCommandBuffer::Draw(uint32_t vertex_count,
                                uint32_t first_vertex,
                                uint32_t first_instance)
 {
-  // Core profile requires a bound VAO even for attribute-less draws (e.g.
-  // fullscreen triangle)
-  if (m_VAO == 0) {
-    glGenVertexArrays(1, &m_VAO);
-    glBindVertexArray(m_VAO);
-  }
+  bind_vertex_array();
 
   if (instance_count == 1 && first_instance == 0) {
     glDrawArrays(m_PrimitiveMode,
@@ -280,28 +230,68 @@ void OpenGLCommandBuffer::Draw(uint32_t vertex_count,
 void OpenGLCommandBuffer::DrawIndexed(uint32_t index_count,
                                       uint32_t instance_count,
                                       uint32_t first_index,
-                                      int32_t /*vertex_offset*/,
+                                      int32_t vertex_offset,
                                       uint32_t first_instance)
 {
-  if (m_VAO == 0) {
-    glGenVertexArrays(1, &m_VAO);
-    glBindVertexArray(m_VAO);
-  }
+  bind_vertex_array();
 
   const auto* indices = reinterpret_cast<const void*>(
       static_cast<uintptr_t>(first_index) * sizeof(uint32_t));
 
   if (instance_count <= 1 && first_instance == 0) {
-    glDrawElements(m_PrimitiveMode,
-                   static_cast<GLsizei>(index_count),
-                   GL_UNSIGNED_INT,
-                   indices);
+    glDrawElementsBaseVertex(m_PrimitiveMode,
+                             static_cast<GLsizei>(index_count),
+                             GL_UNSIGNED_INT,
+                             indices,
+                             vertex_offset);
   } else {
-    glDrawElementsInstancedBaseInstance(m_PrimitiveMode,
-                                        static_cast<GLsizei>(index_count),
-                                        GL_UNSIGNED_INT,
-                                        indices,
-                                        static_cast<GLsizei>(instance_count),
-                                        first_instance);
+    glDrawElementsInstancedBaseVertexBaseInstance(
+        m_PrimitiveMode,
+        static_cast<GLsizei>(index_count),
+        GL_UNSIGNED_INT,
+        indices,
+        static_cast<GLsizei>(instance_count),
+        vertex_offset,
+        first_instance);
   }
 }
+
+void OpenGLCommandBuffer::DrawIndexedIndirect(const RHIBuffer& args_buffer,
+                                              size_t offset,
+                                              uint32_t draw_count,
+                                              uint32_t stride)
+{
+  bind_vertex_array();
+
+  const auto& gl_buffer = dynamic_cast<const OpenGLBuffer&>(args_buffer);
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, gl_buffer.GetGLBuffer());
+  glMultiDrawElementsIndirect(
+      m_PrimitiveMode,
+      GL_UNSIGNED_INT,
+      reinterpret_cast<const void*>(static_cast<uintptr_t>(offset)),
+      static_cast<GLsizei>(draw_count),
+      static_cast<GLsizei>(stride));
+}
+
+void OpenGLCommandBuffer::DrawIndexedIndirectCount(
+    const RHIBuffer& args_buffer,
+    size_t offset,
+    const RHIBuffer& count_buffer,
+    size_t count_offset,
+    uint32_t max_draw_count,
+    uint32_t stride)
+{
+  bind_vertex_array();
+
+  const auto& gl_args = dynamic_cast<const OpenGLBuffer&>(args_buffer);
+  const auto& gl_count = dynamic_cast<const OpenGLBuffer&>(count_buffer);
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, gl_args.GetGLBuffer());
+  glBindBuffer(GL_PARAMETER_BUFFER, gl_count.GetGLBuffer());
+  glMultiDrawElementsIndirectCount(
+      m_PrimitiveMode,
+      GL_UNSIGNED_INT,
+      reinterpret_cast<const void*>(static_cast<uintptr_t>(offset)),
+      static_cast<GLintptr>(count_offset),
+      static_cast<GLsizei>(max_draw_count),
+      static_cast<GLsizei>(stride));
+}
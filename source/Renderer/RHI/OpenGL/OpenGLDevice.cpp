@@ -1,3 +1,4 @@
+#include <chrono>
 #include <stdexcept>
 
 #include "Renderer/RHI/OpenGL/OpenGLDevice.hpp"
@@ -10,8 +11,10 @@
 #include "Renderer/RHI/OpenGL/OpenGLPipelineLayout.hpp"
 #include "Renderer/RHI/OpenGL/OpenGLRenderTarget.hpp"
 #include "Renderer/RHI/OpenGL/OpenGLSampler.hpp"
+#include "Renderer/RHI/OpenGL/OpenGLProgramCache.hpp"
 #include "Renderer/RHI/OpenGL/OpenGLShaderModule.hpp"
 #include "Renderer/RHI/OpenGL/OpenGLTexture.hpp"
+#include "Renderer/RHI/OpenGL/OpenGLVertexArrayCache.hpp"
 #include "Renderer/RHI/RHIBuffer.hpp"
 #include "Renderer/RHI/RHIDescriptorSet.hpp"
 #include "Renderer/RHI/RHIPipeline.hpp"
@@ -21,6 +24,7 @@
 
 constexpr uint32_t OPENGL_VERSION_MAJOR = 4;
 constexpr uint32_t OPENGL_VERSION_MINOR = 6;
+constexpr GLuint64 FENCE_TIMEOUT_NS = 1'000'000'000;
 
 void OpenGLDevice::Init(const RendererConfig& config, void* window)
 {
@@ -70,7 +74,10 @@ void OpenGLDevice::Init(const RendererConfig& config, void* window)
   SDL_GL_SetSwapInterval(1);
 
   // Create command buffer
-  m_CommandBuffer = std::make_unique<OpenGLCommandBuffer>();
+  m_ProgramCache = std::make_shared<OpenGLProgramCache>();
+  m_VertexArrayCache = std::make_shared<OpenGLVertexArrayCache>();
+  m_CommandBuffer = std::make_unique<OpenGLCommandBuffer>(*m_ProgramCache,
+                                                          *m_VertexArrayCache);
 
   m_Initialized = true;
   Logger::Info("OpenGL device initialized successfully");
@@ -94,7 +101,27 @@ void OpenGLDevice::Destroy()
   }
 
   Logger::Trace("OpenGL device shutting down");
+  for (auto& fence : m_FrameFences) {
+    if (fence != nullptr) {
+      glDeleteSync(fence);
+      fence = nullptr;
+    }
+  }
   m_CommandBuffer.reset();
+  if (m_ProgramCache) {
+    Logger::Info("OpenGL program cache: {} programs, {} links, {} hits",
+                 m_ProgramCache->GetProgramCount(),
+                 m_ProgramCache->GetLinks(),
+                 m_ProgramCache->GetHits());
+    m_ProgramCache.reset();
+  }
+  if (m_VertexArrayCache) {
+    Logger::Info("OpenGL vertex array cache: {} VAOs, {} created, {} hits",
+                 m_VertexArrayCache->GetVertexArrayCount(),
+                 m_VertexArrayCache->GetCreates(),
+                 m_VertexArrayCache->GetHits());
+    m_VertexArrayCache.reset();
+  }
   m_Swapchain.reset();
 
   if (m_GLContext != nullptr) {
@@ -121,6 +148,7 @@ void OpenGLDevice::BeginFrame()
                         static_cast<uint32_t>(height));
   }
 
+  wait_frame_fence(m_FrameIndex);
   m_CommandBuffer->Begin();
 }
 
@@ -131,6 +159,31 @@ void OpenGLDevice::EndFrame()
   }
 
   m_CommandBuffer->End();
+  FlushUploads();
+
+  m_FrameFences[m_FrameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  m_FrameIndex = (m_FrameIndex + 1) % FRAMES_IN_FLIGHT;
+}
+
+void OpenGLDevice::wait_frame_fence(uint32_t index)
+{
+  GLsync& fence = m_FrameFences[index];
+  if (fence == nullptr) {
+    return;
+  }
+
+  GLenum status = glClientWaitSync(
+      fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT_NS);
+  while (status == GL_TIMEOUT_EXPIRED) {
+    Logger::Warn("[OpenGL] Frame {} fence timed out, waiting again", index);
+    status = glClientWaitSync(fence, 0, FENCE_TIMEOUT_NS);
+  }
+  if (status == GL_WAIT_FAILED) {
+    Logger::Error("[OpenGL] Waiting on frame {} fence failed", index);
+  }
+
+  glDeleteSync(fence);
+  fence = nullptr;
 }
 
 void OpenGLDevice::Present()
@@ -155,6 +208,50 @@ void OpenGLDevice::WaitIdle()
   glFinish();
 }
 
+void OpenGLDevice::UploadBuffer(RHIBuffer& buffer,
+                                const void* data,
+                                size_t size,
+                                size_t offset)
+{
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
+
+  buffer.Upload(data, size, offset);
+
+  m_UploadStats.Bytes += size;
+  ++m_UploadStats.Copies;
+  m_UploadStats.HostSeconds +=
+      std::chrono::duration<double>(Clock::now() - start).count();
+  ++m_PendingUploads;
+}
+
+void OpenGLDevice::UploadTexture(RHITexture& texture,
+                                 const void* data,
+                                 size_t size)
+{
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
+
+  texture.Upload(data, size);
+
+  m_UploadStats.Bytes += size;
+  ++m_UploadStats.Copies;
+  ++m_UploadStats.TextureCopies;
+  m_UploadStats.HostSeconds +=
+      std::chrono::duration<double>(Clock::now() - start).count();
+  ++m_PendingUploads;
+}
+
+void OpenGLDevice::FlushUploads()
+{
+  if (m_PendingUploads == 0) {
+    return;
+  }
+  glFlush();
+  ++m_UploadStats.Submissions;
+  m_PendingUploads = 0;
+}
+
 auto OpenGLDevice::CreateRenderTarget(const RenderTargetDesc& desc)
     -> std::unique_ptr<RHIRenderTarget>
 {
@@ -164,7 +261,7 @@ auto OpenGLDevice::CreateRenderTarget(const RenderTargetDesc& desc)
 auto OpenGLDevice::CreateBuffer(const BufferDesc& desc)
     -> std::unique_ptr<RHIBuffer>
 {
-  return std::make_unique<OpenGLBuffer>(desc);
+  return std::make_unique<OpenGLBuffer>(desc, m_VertexArrayCache);
 }
 
 auto OpenGLDevice::CreateTexture(const TextureDesc& desc)
@@ -182,7 +279,7 @@ auto OpenGLDevice::CreateSampler(const SamplerDesc& desc)
 auto OpenGLDevice::CreateShaderModule(const ShaderModuleDesc& desc)
     -> std::unique_ptr<RHIShaderModule>
 {
-  return std::make_unique<OpenGLShaderModule>(desc);
+  return std::make_unique<OpenGLShaderModule>(desc, m_ProgramCache);
 }
 
 auto OpenGLDevice::CreateGraphicsPipeline(
@@ -0,0 +1,91 @@
+#include <format>
+#include <stdexcept>
+#include <string>
+
+#include "Renderer/RHI/OpenGL/OpenGLProgramCache.hpp"
+
+#include "Core/Logger.hpp"
+
+namespace
+{
+
+constexpr auto MakeKey(GLuint vertex_shader, GLuint fragment_shader)
+    -> uint64_t
+{
+  return (static_cast<uint64_t>(vertex_shader) << 32U) | fragment_shader;
+}
+
+constexpr auto UsesShader(uint64_t key, GLuint shader) -> bool
+{
+  return static_cast<GLuint>(key >> 32U) == shader
+      || static_cast<GLuint>(key & 0xFFFFFFFFU) == shader;
+}
+
+}  // namespace
+
+OpenGLProgramCache::~OpenGLProgramCache()
+{
+  for (const auto& [key, program] : m_Programs) {
+    glDeleteProgram(program);
+  }
+}
+
+auto OpenGLProgramCache::GetProgram(GLuint vertex_shader,
+                                    GLuint fragment_shader) -> GLuint
+{
+  const uint64_t key = MakeKey(vertex_shader, fragment_shader);
+  if (auto iter = m_Programs.find(key); iter != m_Programs.end()) {
+    ++m_Hits;
+    return iter->second;
+  }
+
+  const GLuint program = glCreateProgram();
+  glAttachShader(program, vertex_shader);
+  glAttachShader(program, fragment_shader);
+  glLinkProgram(program);
+
+  GLint success = 0;
+  glGetProgramiv(program, GL_LINK_STATUS, &success);
+  if (success == 0) {
+    GLint log_length = 0;
+    glGetProgramiv(program, GL_INFO_LOG_LENGTH, &log_length);
+
+    std::string info_log(static_cast<size_t>(log_length), '\0');
+    glGetProgramInfoLog(program, log_length, nullptr, info_log.data());
+
+    glDeleteProgram(program);
+    throw std::runtime_error(
+        std::format("Failed to link shader program: {}", info_log));
+  }
+
+  // The program keeps its own copy of the linked code
+  glDetachShader(program, vertex_shader);
+  glDetachShader(program, fragment_shader);
+
+  m_Programs.emplace(key, program);
+  ++m_Links;
+  Logger::Trace("[OpenGL] Linked program {} from shaders {} and {}",
+                program,
+                vertex_shader,
+                fragment_shader);
+  return program;
+}
+
+void OpenGLProgramCache::Invalidate(GLuint shader)
+{
+  const auto removed = std::erase_if(
+      m_Programs,
+      [shader](const auto& entry) -> bool
+      {
+        if (!UsesShader(entry.first, shader)) {
+          return false;
+        }
+        glDeleteProgram(entry.second);
+        return true;
+      });
+
+  if (removed > 0) {
+    Logger::Trace(
+        "[OpenGL] Dropped {} program(s) using shader {}", removed, shader);
+  }
+}
@@ -1,9 +1,11 @@
 #include <format>
 #include <stdexcept>
+#include <utility>
 
 #include "Renderer/RHI/OpenGL/OpenGLShaderModule.hpp"
 
 #include "Core/Logger.hpp"
+#include "Renderer/RHI/OpenGL/OpenGLProgramCache.hpp"
 
 static auto ShaderStageToGL(ShaderStage stage) -> GLenum
 {
@@ -18,8 +20,11 @@ static auto ShaderStageToGL(ShaderStage stage) -> GLenum
   return GL_VERTEX_SHADER;
 }
 
-OpenGLShaderModule::OpenGLShaderModule(const ShaderModuleDesc& desc)
-    : m_Stage(desc.Stage)
+OpenGLShaderModule::OpenGLShaderModule(
+    const ShaderModuleDesc& desc,
+    std::weak_ptr<OpenGLProgramCache> program_cache)
+    : m_ProgramCache(std::move(program_cache))
+    , m_Stage(desc.Stage)
 {
   if (desc.GLSLCode.empty()) {
     throw std::runtime_error("No GLSL code provided for OpenGL shader");
@@ -56,6 +61,9 @@ OpenGLShaderModule::OpenGLShaderModule(const ShaderModuleDesc& desc)
 OpenGLShaderModule::~OpenGLShaderModule()
 {
   if (m_Shader != 0) {
+    if (auto program_cache = m_ProgramCache.lock()) {
+      program_cache->Invalidate(m_Shader);
+    }
     glDeleteShader(m_Shader);
   }
 
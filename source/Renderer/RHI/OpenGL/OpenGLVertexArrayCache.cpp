@@ -0,0 +1,147 @@
+#include <functional>
+
+#include "Renderer/RHI/OpenGL/OpenGLVertexArrayCache.hpp"
+
+#include "Core/Logger.hpp"
+
+namespace
+{
+
+// The layouts describe a single interleaved stream
+constexpr GLuint VERTEX_BINDING = 0;
+
+struct AttributeFormat
+{
+  GLint Size {3};
+  GLenum Type {GL_FLOAT};
+};
+
+constexpr auto ToGLFormat(VertexFormat format) -> AttributeFormat
+{
+  switch (format) {
+    case VertexFormat::Float:
+      return {.Size = 1, .Type = GL_FLOAT};
+    case VertexFormat::Float2:
+      return {.Size = 2, .Type = GL_FLOAT};
+    case VertexFormat::Float3:
+      return {.Size = 3, .Type = GL_FLOAT};
+    case VertexFormat::Float4:
+      return {.Size = 4, .Type = GL_FLOAT};
+    case VertexFormat::Int:
+      return {.Size = 1, .Type = GL_INT};
+    case VertexFormat::Int2:
+      return {.Size = 2, .Type = GL_INT};
+    case VertexFormat::Int3:
+      return {.Size = 3, .Type = GL_INT};
+    case VertexFormat::Int4:
+      return {.Size = 4, .Type = GL_INT};
+    case VertexFormat::UInt:
+      return {.Size = 1, .Type = GL_UNSIGNED_INT};
+    case VertexFormat::UInt2:
+      return {.Size = 2, .Type = GL_UNSIGNED_INT};
+    case VertexFormat::UInt3:
+      return {.Size = 3, .Type = GL_UNSIGNED_INT};
+    case VertexFormat::UInt4:
+      return {.Size = 4, .Type = GL_UNSIGNED_INT};
+  }
+  return {};
+}
+
+}  // namespace
+
+auto VertexArrayKeyHash::operator()(const VertexArrayKey& key) const -> size_t
+{
+  size_t seed = 0;
+  auto hash_combine = [&seed](auto value) -> auto
+  {
+    seed ^= std::hash<decltype(value)> {}(value) + 0x9e3779b9 + (seed << 6)
+        + (seed >> 2);
+  };
+
+  hash_combine(key.Layout.Stride);
+  for (const auto& attr : key.Layout.Attributes) {
+    hash_combine(attr.Location);
+    hash_combine(static_cast<uint8_t>(attr.Format));
+    hash_combine(attr.Offset);
+  }
+  hash_combine(key.VertexBuffer);
+  hash_combine(key.IndexBuffer);
+  return seed;
+}
+
+OpenGLVertexArrayCache::~OpenGLVertexArrayCache()
+{
+  for (const auto& [key, vertex_array] : m_VertexArrays) {
+    glDeleteVertexArrays(1, &vertex_array);
+  }
+}
+
+auto OpenGLVertexArrayCache::GetVertexArray(const VertexArrayKey& key)
+    -> GLuint
+{
+  if (auto iter = m_VertexArrays.find(key); iter != m_VertexArrays.end()) {
+    ++m_Hits;
+    return iter->second;
+  }
+
+  GLuint vertex_array = 0;
+  glCreateVertexArrays(1, &vertex_array);
+
+  for (const auto& attr : key.Layout.Attributes) {
+    const AttributeFormat format = ToGLFormat(attr.Format);
+    glEnableVertexArrayAttrib(vertex_array, attr.Location);
+    if (format.Type == GL_FLOAT) {
+      glVertexArrayAttribFormat(vertex_array,
+                                attr.Location,
+                                format.Size,
+                                format.Type,
+                                GL_FALSE,
+                                attr.Offset);
+    } else {
+      glVertexArrayAttribIFormat(
+          vertex_array, attr.Location, format.Size, format.Type, attr.Offset);
+    }
+    glVertexArrayAttribBinding(vertex_array, attr.Location, VERTEX_BINDING);
+  }
+
+  if (key.VertexBuffer != 0) {
+    glVertexArrayVertexBuffer(vertex_array,
+                              VERTEX_BINDING,
+                              key.VertexBuffer,
+                              0,
+                              static_cast<GLsizei>(key.Layout.Stride));
+  }
+  if (key.IndexBuffer != 0) {
+    glVertexArrayElementBuffer(vertex_array, key.IndexBuffer);
+  }
+
+  m_VertexArrays.emplace(key, vertex_array);
+  ++m_Creates;
+  Logger::Trace("[OpenGL] Created vertex array {} for buffers {} and {}",
+                vertex_array,
+                key.VertexBuffer,
+                key.IndexBuffer);
+  return vertex_array;
+}
+
+void OpenGLVertexArrayCache::Invalidate(GLuint buffer)
+{
+  const auto removed = std::erase_if(
+      m_VertexArrays,
+      [buffer](const auto& entry) -> bool
+      {
+        if (entry.first.VertexBuffer != buffer
+            && entry.first.IndexBuffer != buffer)
+        {
+          return false;
+        }
+        glDeleteVertexArrays(1, &entry.second);
+        return true;
+      });
+
+  if (removed > 0) {
+    ++m_Generation;
+    Logger::Trace(
+        "[OpenGL] Dropped {} vertex array(s) using buffer {}", removed, buffer);
+  }
+}
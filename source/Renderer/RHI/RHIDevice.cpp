@@ -2,6 +2,7 @@
 
 #include "Renderer/RHI/RHIDevice.hpp"
 
+#include "Renderer/RHI/Null/NullDevice.hpp"
 #include "Renderer/RHI/OpenGL/OpenGLDevice.hpp"
 #include "Renderer/RHI/Vulkan/VulkanDevice.hpp"
 #include "Renderer/RendererConfig.hpp"
@@ -16,6 +17,9 @@ auto RHIDevice::Create(const RendererConfig& config)
     case RenderAPI::Vulkan:
       return std::make_unique<VulkanDevice>();
 
+    case RenderAPI::Null:
+      return std::make_unique<NullDevice>();
+
     default:
       throw std::runtime_error("Unsupported render API");
   }
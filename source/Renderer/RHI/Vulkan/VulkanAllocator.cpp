@@ -0,0 +1,362 @@
+// The allocator implementation is compiled into this file. volk defines no
+// Vulkan prototypes, so VMA fetches its entry points at runtime through the
+// loader functions passed in the constructor.
+#define VMA_STATIC_VULKAN_FUNCTIONS 0
+#define VMA_DYNAMIC_VULKAN_FUNCTIONS 1
+#define VMA_IMPLEMENTATION
+
+#include <format>
+#include <stdexcept>
+#include <string_view>
+
+#include "Renderer/RHI/Vulkan/VulkanAllocator.hpp"
+
+#include "Core/Logger.hpp"
+#include "Renderer/RHI/Vulkan/VulkanDevice.hpp"
+#include "Renderer/RHI/Vulkan/VulkanUtils.hpp"
+
+namespace
+{
+
+constexpr auto POOL_NAMES = std::to_array<std::string_view>({
+    "General",
+    "RenderTarget",
+    "Geometry",
+    "Upload",
+});
+
+constexpr double BYTES_PER_MB = 1024.0 * 1024.0;
+
+constexpr auto ToIndex(VulkanMemoryPool pool) -> size_t
+{
+  return static_cast<size_t>(pool);
+}
+
+auto ToMB(uint64_t bytes) -> double
+{
+  return static_cast<double>(bytes) / BYTES_PER_MB;
+}
+
+auto ToPoolStats(std::string_view name, const VmaDetailedStatistics& stats)
+    -> MemoryPoolStats
+{
+  return {
+      .Name = name,
+      .BlockCount = stats.statistics.blockCount,
+      .AllocationCount = stats.statistics.allocationCount,
+      .BlockBytes = stats.statistics.blockBytes,
+      .AllocationBytes = stats.statistics.allocationBytes,
+      .FreeRangeCount = stats.unusedRangeCount,
+  };
+}
+
+}  // namespace
+
+VulkanAllocator::VulkanAllocator(VkInstance instance,
+                                 VkPhysicalDevice physical_device,
+                                 VkDevice device)
+{
+  VmaVulkanFunctions functions = {};
+  functions.vkGetInstanceProcAddr = vkGetInstanceProcAddr;
+  functions.vkGetDeviceProcAddr = vkGetDeviceProcAddr;
+
+  VmaAllocatorCreateInfo create_info = {};
+  create_info.vulkanApiVersion = VulkanDevice::GetApiVersion();
+  create_info.instance = instance;
+  create_info.physicalDevice = physical_device;
+  create_info.device = device;
+  create_info.pVulkanFunctions = &functions;
+
+  if (auto result =
+          VkUtils::Check(vmaCreateAllocator(&create_info, &m_Allocator));
+      !result)
+  {
+    throw std::runtime_error(
+        std::format("Failed to create Vulkan memory allocator: {}",
+                    VkUtils::ToString(result.error())));
+  }
+
+  // Each pool is tied to one memory type, picked for a resource typical of
+  // what the pool holds
+  VkImageCreateInfo image_info = {};
+  image_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+  image_info.imageType = VK_IMAGE_TYPE_2D;
+  image_info.format = VK_FORMAT_R8G8B8A8_UNORM;
+  image_info.extent = {.width = 1, .height = 1, .depth = 1};
+  image_info.mipLevels = 1;
+  image_info.arrayLayers = 1;
+  image_info.samples = VK_SAMPLE_COUNT_1_BIT;
+  image_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+  image_info.usage =
+      VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+  image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+  image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+  VkBufferCreateInfo buffer_info = {};
+  buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+  buffer_info.size = 1;
+  buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+  uint32_t memory_type = 0;
+  VmaAllocationCreateInfo alloc_info =
+      get_create_info(VulkanMemoryPool::RenderTarget);
+  if (vmaFindMemoryTypeIndexForImageInfo(
+          m_Allocator, &image_info, &alloc_info, &memory_type)
+      == VK_SUCCESS)
+  {
+    create_pool(
+        VulkanMemoryPool::RenderTarget, memory_type, RENDER_TARGET_BLOCK_SIZE);
+  }
+
+  buffer_info.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT
+      | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+  alloc_info = get_create_info(VulkanMemoryPool::Geometry);
+  if (vmaFindMemoryTypeIndexForBufferInfo(
+          m_Allocator, &buffer_info, &alloc_info, &memory_type)
+      == VK_SUCCESS)
+  {
+    create_pool(VulkanMemoryPool::Geometry, memory_type, GEOMETRY_BLOCK_SIZE);
+  }
+
+  buffer_info.usage =
+      VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+  alloc_info = get_create_info(VulkanMemoryPool::Upload);
+  if (vmaFindMemoryTypeIndexForBufferInfo(
+          m_Allocator, &buffer_info, &alloc_info, &memory_type)
+      == VK_SUCCESS)
+  {
+    create_pool(VulkanMemoryPool::Upload, memory_type, UPLOAD_BLOCK_SIZE);
+  }
+
+  Logger::Info("[Vulkan] Created memory allocator");
+}
+
+VulkanAllocator::~VulkanAllocator()
+{
+  for (VmaPool pool : m_Pools) {
+    if (pool != VK_NULL_HANDLE) {
+      vmaDestroyPool(m_Allocator, pool);
+    }
+  }
+  vmaDestroyAllocator(m_Allocator);
+}
+
+auto VulkanAllocator::CreateBuffer(const VkBufferCreateInfo& info,
+                                   VulkanMemoryPool pool)
+    -> VulkanBufferAllocation
+{
+  VmaAllocationCreateInfo alloc_info = get_create_info(pool);
+  alloc_info.pool = m_Pools.at(ToIndex(pool));
+
+  VulkanBufferAllocation buffer;
+  VkResult result = vmaCreateBuffer(m_Allocator,
+                                    &info,
+                                    &alloc_info,
+                                    &buffer.Buffer,
+                                    &buffer.Allocation,
+                                    nullptr);
+  if (result != VK_SUCCESS && alloc_info.pool != VK_NULL_HANDLE) {
+    Logger::Trace("[Vulkan] Buffer of {} bytes does not fit the {} pool",
+                  info.size,
+                  POOL_NAMES.at(ToIndex(pool)));
+    alloc_info.pool = VK_NULL_HANDLE;
+    result = vmaCreateBuffer(m_Allocator,
+                             &info,
+                             &alloc_info,
+                             &buffer.Buffer,
+                             &buffer.Allocation,
+                             nullptr);
+  }
+
+  if (auto checked = VkUtils::Check(result); !checked) {
+    throw std::runtime_error(
+        std::format("Failed to allocate buffer memory: {}",
+                    VkUtils::ToString(checked.error())));
+  }
+  return buffer;
+}
+
+auto VulkanAllocator::CreateImage(const VkImageCreateInfo& info,
+                                  VulkanMemoryPool pool)
+    -> VulkanImageAllocation
+{
+  VmaAllocationCreateInfo alloc_info = get_create_info(pool);
+  alloc_info.pool = m_Pools.at(ToIndex(pool));
+
+  VulkanImageAllocation image;
+  VkResult result = vmaCreateImage(m_Allocator,
+                                   &info,
+                                   &alloc_info,
+                                   &image.Image,
+                                   &image.Allocation,
+                                   nullptr);
+  if (result != VK_SUCCESS && alloc_info.pool != VK_NULL_HANDLE) {
+    Logger::Trace("[Vulkan] Image {}x{} does not fit the {} pool",
+                  info.extent.width,
+                  info.extent.height,
+                  POOL_NAMES.at(ToIndex(pool)));
+    alloc_info.pool = VK_NULL_HANDLE;
+    result = vmaCreateImage(m_Allocator,
+                            &info,
+                            &alloc_info,
+                            &image.Image,
+                            &image.Allocation,
+                            nullptr);
+  }
+
+  if (auto checked = VkUtils::Check(result); !checked) {
+    throw std::runtime_error(
+        std::format("Failed to allocate image memory: {}",
+                    VkUtils::ToString(checked.error())));
+  }
+  return image;
+}
+
+void VulkanAllocator::DestroyBuffer(const VulkanBufferAllocation& buffer)
+{
+  vmaDestroyBuffer(m_Allocator, buffer.Buffer, buffer.Allocation);
+}
+
+void VulkanAllocator::DestroyImage(const VulkanImageAllocation& image)
+{
+  vmaDestroyImage(m_Allocator, image.Image, image.Allocation);
+}
+
+auto VulkanAllocator::Map(VmaAllocation allocation) -> void*
+{
+  void* data = nullptr;
+  if (auto result =
+          VkUtils::Check(vmaMapMemory(m_Allocator, allocation, &data));
+      !result)
+  {
+    throw std::runtime_error(std::format("Failed to map memory: {}",
+                                         VkUtils::ToString(result.error())));
+  }
+  return data;
+}
+
+void VulkanAllocator::Unmap(VmaAllocation allocation)
+{
+  vmaUnmapMemory(m_Allocator, allocation);
+}
+
+void VulkanAllocator::Flush(VmaAllocation allocation,
+                            VkDeviceSize offset,
+                            VkDeviceSize size)
+{
+  // Rounded out to nonCoherentAtomSize by the allocator
+  if (auto result = VkUtils::Check(
+          vmaFlushAllocation(m_Allocator, allocation, offset, size));
+      !result)
+  {
+    throw std::runtime_error(std::format("Failed to flush memory: {}",
+                                         VkUtils::ToString(result.error())));
+  }
+}
+
+auto VulkanAllocator::GetMemoryProperties(VmaAllocation allocation) const
+    -> VkMemoryPropertyFlags
+{
+  VkMemoryPropertyFlags flags = 0;
+  vmaGetAllocationMemoryProperties(m_Allocator, allocation, &flags);
+  return flags;
+}
+
+auto VulkanAllocator::GetStats() const -> std::vector<MemoryPoolStats>
+{
+  std::vector<MemoryPoolStats> stats;
+
+  VmaTotalStatistics total = {};
+  vmaCalculateStatistics(m_Allocator, &total);
+  MemoryPoolStats general =
+      ToPoolStats(POOL_NAMES.at(ToIndex(VulkanMemoryPool::General)),
+                  total.total);
+
+  // The totals include the dedicated pools; what remains is the default
+  // pools
+  for (size_t i = 0; i < POOL_COUNT; ++i) {
+    if (m_Pools.at(i) == VK_NULL_HANDLE) {
+      continue;
+    }
+
+    VmaDetailedStatistics detailed = {};
+    vmaCalculatePoolStatistics(m_Allocator, m_Pools.at(i), &detailed);
+    const MemoryPoolStats& pool =
+        stats.emplace_back(ToPoolStats(POOL_NAMES.at(i), detailed));
+
+    general.BlockCount -= pool.BlockCount;
+    general.AllocationCount -= pool.AllocationCount;
+    general.BlockBytes -= pool.BlockBytes;
+    general.AllocationBytes -= pool.AllocationBytes;
+    general.FreeRangeCount -= pool.FreeRangeCount;
+  }
+
+  stats.push_back(general);
+  return stats;
+}
+
+void VulkanAllocator::LogStats() const
+{
+  for (const auto& pool : GetStats()) {
+    Logger::Info(
+        "[Vulkan] {} memory: {} blocks, {} allocations, {:.2f} of {:.2f} MB "
+        "used, {:.2f} MB free in {} ranges",
+        pool.Name,
+        pool.BlockCount,
+        pool.AllocationCount,
+        ToMB(pool.AllocationBytes),
+        ToMB(pool.BlockBytes),
+        ToMB(pool.GetWastedBytes()),
+        pool.FreeRangeCount);
+  }
+}
+
+auto VulkanAllocator::get_create_info(VulkanMemoryPool pool)
+    -> VmaAllocationCreateInfo
+{
+  VmaAllocationCreateInfo info = {};
+  switch (pool) {
+    case VulkanMemoryPool::General:
+    case VulkanMemoryPool::RenderTarget:
+    case VulkanMemoryPool::Geometry:
+      info.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+      info.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+      break;
+    case VulkanMemoryPool::Upload:
+      // Non-coherent memory is accepted; writes are made visible through
+      // Flush()
+      info.usage = VMA_MEMORY_USAGE_AUTO;
+      info.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+      info.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+      info.preferredFlags = VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+      break;
+  }
+  return info;
+}
+
+void VulkanAllocator::create_pool(VulkanMemoryPool pool,
+                                  uint32_t memory_type_index,
+                                  size_t block_size)
+{
+  VmaPoolCreateInfo create_info = {};
+  create_info.memoryTypeIndex = memory_type_index;
+  create_info.blockSize = block_size;
+
+  VmaPool& handle = m_Pools.at(ToIndex(pool));
+  if (auto result =
+          VkUtils::Check(vmaCreatePool(m_Allocator, &create_info, &handle));
+      !result)
+  {
+    // Resources meant for this pool go to the default pools instead
+    Logger::Warn("[Vulkan] Failed to create {} memory pool: {}",
+                 POOL_NAMES.at(ToIndex(pool)),
+                 VkUtils::ToString(result.error()));
+    handle = VK_NULL_HANDLE;
+    return;
+  }
+
+  Logger::Trace("[Vulkan] Created {} memory pool (type {}, {} MB blocks)",
+                POOL_NAMES.at(ToIndex(pool)),
+                memory_type_index,
+                block_size / (1024 * 1024));
+}
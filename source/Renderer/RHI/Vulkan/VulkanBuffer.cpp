@@ -5,15 +5,14 @@
 #include "Renderer/RHI/Vulkan/VulkanBuffer.hpp"
 
 #include "Core/Logger.hpp"
+#include "Renderer/RHI/Vulkan/VulkanAllocator.hpp"
 #include "Renderer/RHI/Vulkan/VulkanDevice.hpp"
-#include "Renderer/RHI/Vulkan/VulkanUtils.hpp"
+#include "Renderer/RHI/Vulkan/VulkanUploader.hpp"
 
 VulkanBuffer::VulkanBuffer(const VulkanDevice& device, const BufferDesc& desc)
     : m_Device(device)
     , m_Size(desc.Size)
 {
-  VkDevice vk_device = m_Device.GetVkDevice();
-
   // Convert BufferUsage to VkBufferUsageFlags
   VkBufferUsageFlags usage_flags = 0;
   if ((desc.Usage & BufferUsage::Vertex) != BufferUsage {}) {
@@ -31,6 +30,16 @@ VulkanBuffer::VulkanBuffer(const VulkanDevice& device, const BufferDesc& desc)
   if ((desc.Usage & BufferUsage::TransferDst) != BufferUsage {}) {
     usage_flags |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
   }
+  if ((desc.Usage & BufferUsage::Indirect) != BufferUsage {}) {
+    usage_flags |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+  }
+  if ((desc.Usage & BufferUsage::Storage) != BufferUsage {}) {
+    usage_flags |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+  }
+  // Device-local buffers can only be written by transfers
+  if (!desc.CPUVisible) {
+    usage_flags |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+  }
 
   // Create buffer
   VkBufferCreateInfo buffer_info = {};
@@ -39,90 +48,38 @@ VulkanBuffer::VulkanBuffer(const VulkanDevice& device, const BufferDesc& desc)
   buffer_info.usage = usage_flags;
   buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-  if (auto result = VkUtils::Check(
-          vkCreateBuffer(vk_device, &buffer_info, nullptr, &m_Buffer));
-      !result)
-  {
-    throw std::runtime_error(std::format("Failed to create Vulkan buffer: {}",
-                                         VkUtils::ToString(result.error())));
-  }
-
-  // Get memory requirements
-  VkMemoryRequirements mem_requirements;
-  vkGetBufferMemoryRequirements(vk_device, m_Buffer, &mem_requirements);
-
-  // Determine memory properties
-  VkMemoryPropertyFlags properties = 0;
-  if (desc.CPUVisible) {
-    properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
-        | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-  } else {
-    properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
-  }
-
-  // Find suitable memory type
-  VkPhysicalDeviceMemoryProperties mem_properties;
-  vkGetPhysicalDeviceMemoryProperties(m_Device.GetVkPhysicalDevice(),
-                                      &mem_properties);
-
-  uint32_t memory_type_index = UINT32_MAX;
-  for (uint32_t i = 0; i < mem_properties.memoryTypeCount; ++i) {
-    if ((mem_requirements.memoryTypeBits & (1 << i)) != 0
-        && (mem_properties.memoryTypes[i].propertyFlags & properties)
-            == properties)
-    {
-      memory_type_index = i;
-      break;
-    }
-  }
-
-  if (memory_type_index == UINT32_MAX) {
-    throw std::runtime_error("Failed to find suitable memory type for buffer");
-  }
-
-  // Allocate memory
-  VkMemoryAllocateInfo alloc_info = {};
-  alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-  alloc_info.allocationSize = mem_requirements.size;
-  alloc_info.memoryTypeIndex = memory_type_index;
-
-  if (auto result = VkUtils::Check(
-          vkAllocateMemory(vk_device, &alloc_info, nullptr, &m_Memory));
-      !result)
-  {
-    vkDestroyBuffer(vk_device, m_Buffer, nullptr);
-    throw std::runtime_error(std::format("Failed to allocate buffer memory: {}",
-                                         VkUtils::ToString(result.error())));
-  }
-
-  // Bind buffer to memory
-  if (auto result =
-          VkUtils::Check(vkBindBufferMemory(vk_device, m_Buffer, m_Memory, 0));
-      !result)
-  {
-    vkFreeMemory(vk_device, m_Memory, nullptr);
-    vkDestroyBuffer(vk_device, m_Buffer, nullptr);
-    throw std::runtime_error(std::format("Failed to bind buffer memory: {}",
-                                         VkUtils::ToString(result.error())));
-  }
-
-  Logger::Trace("[Vulkan] Created buffer with size {}", desc.Size);
+  // Host-visible buffers are written by the CPU every frame or used as
+  // staging; everything else is static data filled through the uploader
+  const VulkanMemoryPool pool =
+      desc.CPUVisible ? VulkanMemoryPool::Upload : VulkanMemoryPool::Geometry;
+  const VulkanBufferAllocation allocation =
+      m_Device.GetAllocator().CreateBuffer(buffer_info, pool);
+  m_Buffer = allocation.Buffer;
+  m_Allocation = allocation.Allocation;
+
+  const VkMemoryPropertyFlags memory_flags =
+      m_Device.GetAllocator().GetMemoryProperties(m_Allocation);
+  m_HostVisible = (memory_flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+
+  if (desc.CPUVisible && desc.PersistentMap) {
+    (void)Map();
+    m_Persistent = true;
+  }
+
+  Logger::Trace("[Vulkan] Created buffer with size {}{}",
+                desc.Size,
+                m_Persistent ? " (persistently mapped)" : "");
 }
 
 VulkanBuffer::~VulkanBuffer()
 {
-  VkDevice vk_device = m_Device.GetVkDevice();
-
   if (m_Mapped) {
+    m_Persistent = false;
     Unmap();
   }
 
-  if (m_Memory != VK_NULL_HANDLE) {
-    vkFreeMemory(vk_device, m_Memory, nullptr);
-  }
-
   if (m_Buffer != VK_NULL_HANDLE) {
-    vkDestroyBuffer(vk_device, m_Buffer, nullptr);
+    m_Device.GetAllocator().DestroyBuffer({m_Buffer, m_Allocation});
   }
 
   Logger::Trace("[Vulkan] Destroyed buffer");
@@ -133,38 +90,58 @@ auto VulkanBuffer::Map() -> void*
   if (m_Mapped) {
     return m_MappedPtr;
   }
-
-  VkDevice vk_device = m_Device.GetVkDevice();
-
-  if (auto result = VkUtils::Check(
-          vkMapMemory(vk_device, m_Memory, 0, m_Size, 0, &m_MappedPtr));
-      !result)
-  {
-    throw std::runtime_error(std::format("Failed to map buffer memory: {}",
-                                         VkUtils::ToString(result.error())));
+  if (!m_HostVisible) {
+    throw std::runtime_error("Cannot map a device-local Vulkan buffer");
   }
 
+  m_MappedPtr = m_Device.GetAllocator().Map(m_Allocation);
   m_Mapped = true;
   return m_MappedPtr;
 }
 
 void VulkanBuffer::Upload(const void* data, size_t size, size_t offset)
 {
+  if (offset + size > m_Size) {
+    throw std::runtime_error(
+        std::format("Vulkan buffer upload out of range: {} + {} > {}",
+                    offset,
+                    size,
+                    m_Size));
+  }
+
+  if (!m_HostVisible) {
+    m_Device.GetUploader().CopyToBuffer(*this, data, size, offset);
+    return;
+  }
+
   void* mapped = Map();
   const std::span dest =
       std::span {static_cast<std::byte*>(mapped), m_Size}.subspan(offset, size);
   std::memcpy(dest.data(), data, size);
-  Unmap();
+
+  Flush(offset, size);
+  if (!m_Persistent) {
+    Unmap();
+  }
+}
+
+void VulkanBuffer::Flush(size_t offset, size_t size)
+{
+  if (!m_Mapped || size == 0) {
+    return;
+  }
+
+  m_Device.GetAllocator().Flush(m_Allocation, offset, size);
 }
 
 void VulkanBuffer::Unmap()
 {
-  if (!m_Mapped) {
+  // Persistently mapped buffers stay mapped until destruction
+  if (!m_Mapped || m_Persistent) {
     return;
   }
 
-  VkDevice vk_device = m_Device.GetVkDevice();
-  vkUnmapMemory(vk_device, m_Memory);
+  m_Device.GetAllocator().Unmap(m_Allocation);
   m_MappedPtr = nullptr;
   m_Mapped = false;
 }
@@ -1,4 +1,7 @@
+#include <algorithm>
 #include <format>
+#include <optional>
+#include <stdexcept>
 
 #include "Renderer/RHI/Vulkan/VulkanCommandBuffer.hpp"
 
@@ -12,8 +15,20 @@
 #include "Renderer/RHI/Vulkan/VulkanRenderTarget.hpp"
 #include "Renderer/RHI/Vulkan/VulkanShaderModule.hpp"
 #include "Renderer/RHI/Vulkan/VulkanSwapchain.hpp"
+#include "Renderer/RHI/Vulkan/VulkanTexture.hpp"
 #include "Renderer/RHI/Vulkan/VulkanUtils.hpp"
 
+// Stores value in the shadow; true when it differs from what was there
+template<typename T>
+static auto Update(std::optional<T>& shadow, const T& value) -> bool
+{
+  if (shadow == value) {
+    return false;
+  }
+  shadow = value;
+  return true;
+}
+
 void VulkanCommandBuffer::Allocate(const VulkanDevice& device,
                                    VkCommandPool pool)
 {
@@ -55,6 +70,8 @@ void VulkanCommandBuffer::Begin()
                                          VkUtils::ToString(result.error())));
   }
   m_Recording = true;
+  m_State = {};
+  m_Stats = {};
 }
 
 void VulkanCommandBuffer::End()
@@ -87,6 +104,66 @@ static auto ToVkLoadOp(LoadOp op) -> VkAttachmentLoadOp
   return VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 }
 
+// Layout of a texture state with the stages and accesses that use it
+struct StateAccess
+{
+  VkImageLayout Layout {VK_IMAGE_LAYOUT_UNDEFINED};
+  VkPipelineStageFlags Stages {VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT};
+  VkAccessFlags Writes {0};
+  VkAccessFlags Accesses {0};
+};
+
+// Without separateDepthStencilLayouts, transitions of depth/stencil images
+// have to cover both aspects
+static auto GetAspectMask(TextureFormat format) -> VkImageAspectFlags
+{
+  if (HasStencil(format)) {
+    return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+  }
+  return IsDepthFormat(format) ? VK_IMAGE_ASPECT_DEPTH_BIT
+                               : VK_IMAGE_ASPECT_COLOR_BIT;
+}
+
+static auto GetStateAccess(TextureState state) -> StateAccess
+{
+  switch (state) {
+    case TextureState::Undefined:
+      return {};
+    case TextureState::ColorAttachment:
+      return {
+          .Layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+          .Stages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+          .Writes = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+          .Accesses = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT
+              | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+      };
+    case TextureState::DepthAttachment:
+      return {
+          .Layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+          .Stages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT
+              | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+          .Writes = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+          .Accesses = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT
+              | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+      };
+    case TextureState::ShaderRead:
+      return {
+          .Layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+          .Stages = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+          .Writes = 0,
+          .Accesses = VK_ACCESS_SHADER_READ_BIT,
+      };
+    case TextureState::DepthRead:
+      return {
+          .Layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+          .Stages = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+          .Writes = 0,
+          .Accesses = VK_ACCESS_SHADER_READ_BIT,
+      };
+  }
+  return {};
+}
+
 void VulkanCommandBuffer::BeginRenderPass(const RenderPassInfo& info)
 {
   Logger::Trace("[Vulkan] Begin render pass ({}x{}) with dynamic rendering",
@@ -125,6 +202,12 @@ void VulkanCommandBuffer::BeginRenderPass(const RenderPassInfo& info)
     }
   }
 
+  // The caller already transitioned the attachments
+  if (!m_IsSwapchainTarget && info.ExplicitBarriers) {
+    color_images.clear();
+    depth_image = VK_NULL_HANDLE;
+  }
+
   // Barriers — one per color image
   std::vector<VkImageMemoryBarrier> barriers;
   VkPipelineStageFlags dst_stage =
@@ -167,16 +250,18 @@ void VulkanCommandBuffer::BeginRenderPass(const RenderPassInfo& info)
     dst_stage |= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
   }
 
-  vkCmdPipelineBarrier(m_CommandBuffer,
-                       VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                       dst_stage,
-                       0,
-                       0,
-                       nullptr,
-                       0,
-                       nullptr,
-                       static_cast<uint32_t>(barriers.size()),
-                       barriers.data());
+  if (!barriers.empty()) {
+    vkCmdPipelineBarrier(m_CommandBuffer,
+                         VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                         dst_stage,
+                         0,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr,
+                         static_cast<uint32_t>(barriers.size()),
+                         barriers.data());
+  }
 
   // Color attachments
   std::vector<VkRenderingAttachmentInfo> color_attachment_infos(
@@ -251,7 +336,9 @@ void VulkanCommandBuffer::EndRenderPass()
   if (m_IsSwapchainTarget) {
     auto* swapchain = dynamic_cast<VulkanSwapchain*>(m_Device->GetSwapchain());
     color_images.push_back(swapchain->GetCurrentImage());
-  } else if (m_CurrentRenderPass.RenderTarget != nullptr) {
+  } else if (m_CurrentRenderPass.RenderTarget != nullptr
+             && !m_CurrentRenderPass.ExplicitBarriers)
+  {
     auto* rt =
         dynamic_cast<VulkanRenderTarget*>(m_CurrentRenderPass.RenderTarget);
     for (uint32_t i = 0; i < m_CurrentRenderPass.ColorAttachmentCount; ++i) {
@@ -313,6 +400,64 @@ void VulkanCommandBuffer::EndRenderPass()
     src_stage |= VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
   }
 
+  if (!barriers.empty()) {
+    vkCmdPipelineBarrier(m_CommandBuffer,
+                         src_stage,
+                         dst_stage,
+                         0,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr,
+                         static_cast<uint32_t>(barriers.size()),
+                         barriers.data());
+  }
+
+  m_InRenderPass = false;
+  m_IsSwapchainTarget = false;
+  m_CurrentRenderPass = {};
+}
+
+void VulkanCommandBuffer::Barrier(std::span<const TextureBarrier> barriers)
+{
+  if (barriers.empty()) {
+    return;
+  }
+
+  std::vector<VkImageMemoryBarrier> image_barriers;
+  image_barriers.reserve(barriers.size());
+  VkPipelineStageFlags src_stage = 0;
+  VkPipelineStageFlags dst_stage = 0;
+
+  for (const auto& barrier : barriers) {
+    const auto* vk_texture =
+        dynamic_cast<const VulkanTexture*>(barrier.Texture);
+    const StateAccess before = GetStateAccess(barrier.Before);
+    const StateAccess after = GetStateAccess(barrier.After);
+
+    VkImageMemoryBarrier image_barrier {};
+    image_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    image_barrier.oldLayout =
+        barrier.Discard ? VK_IMAGE_LAYOUT_UNDEFINED : before.Layout;
+    image_barrier.newLayout = after.Layout;
+    image_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    image_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    image_barrier.image = vk_texture->GetVkImage();
+    image_barrier.subresourceRange = {
+        .aspectMask = GetAspectMask(vk_texture->GetFormat()),
+        .baseMipLevel = 0,
+        .levelCount = 1,
+        .baseArrayLayer = 0,
+        .layerCount = 1};
+    // Earlier reads only need to finish, earlier writes to be visible
+    image_barrier.srcAccessMask = before.Writes;
+    image_barrier.dstAccessMask = after.Accesses;
+    image_barriers.push_back(image_barrier);
+
+    src_stage |= before.Stages;
+    dst_stage |= after.Stages;
+  }
+
   vkCmdPipelineBarrier(m_CommandBuffer,
                        src_stage,
                        dst_stage,
@@ -321,12 +466,9 @@ void VulkanCommandBuffer::EndRenderPass()
                        nullptr,
                        0,
                        nullptr,
-                       static_cast<uint32_t>(barriers.size()),
-                       barriers.data());
-
-  m_InRenderPass = false;
-  m_IsSwapchainTarget = false;
-  m_CurrentRenderPass = {};
+                       static_cast<uint32_t>(image_barriers.size()),
+                       image_barriers.data());
+  Logger::Trace("[Vulkan] Recorded {} image barrier(s)", image_barriers.size());
 }
 
 auto VulkanCommandBuffer::GetHandle() const -> VkCommandBuffer
@@ -334,6 +476,21 @@ auto VulkanCommandBuffer::GetHandle() const -> VkCommandBuffer
   return m_CommandBuffer;
 }
 
+void VulkanCommandBuffer::InvalidateState()
+{
+  m_State = {};
+}
+
+auto VulkanCommandBuffer::record(bool changed, uint32_t commands) -> bool
+{
+  if (changed) {
+    m_Stats.Emitted += commands;
+  } else {
+    m_Stats.Filtered += commands;
+  }
+  return changed;
+}
+
 void VulkanCommandBuffer::BindShaders(const RHIShaderModule* vertex_shader,
                                       const RHIShaderModule* fragment_shader)
 {
@@ -342,19 +499,31 @@ void VulkanCommandBuffer::BindShaders(const RHIShaderModule* vertex_shader,
   const auto* vk_fragment =
       dynamic_cast<const VulkanShaderModule*>(fragment_shader);
 
-  std::array<VkShaderStageFlagBits, 2> stages = {VK_SHADER_STAGE_VERTEX_BIT,
-                                                 VK_SHADER_STAGE_FRAGMENT_BIT};
-  std::array<VkShaderEXT, 2> shaders = {
+  const std::array<VkShaderStageFlagBits, 2> stages = {
+      VK_SHADER_STAGE_VERTEX_BIT, VK_SHADER_STAGE_FRAGMENT_BIT};
+  const std::array<VkShaderEXT, 2> shaders = {
       vk_vertex != nullptr ? vk_vertex->GetVkShaderEXT() : VK_NULL_HANDLE,
       vk_fragment != nullptr ? vk_fragment->GetVkShaderEXT() : VK_NULL_HANDLE};
+  if (record(Update(m_State.Shaders, shaders))) {
+    vkCmdBindShadersEXT(m_CommandBuffer, 2, stages.data(), shaders.data());
+  }
 
-  vkCmdBindShadersEXT(m_CommandBuffer, 2, stages.data(), shaders.data());
+  if (record(!m_State.FixedState, FIXED_STATE_COMMANDS)) {
+    const auto sample_mask = 0xFFFFFFFF;
+    vkCmdSetSampleMaskEXT(
+        m_CommandBuffer, VK_SAMPLE_COUNT_1_BIT, &sample_mask);
+    vkCmdSetRasterizationSamplesEXT(m_CommandBuffer, VK_SAMPLE_COUNT_1_BIT);
+    vkCmdSetRasterizerDiscardEnable(m_CommandBuffer, VK_FALSE);
+    vkCmdSetAlphaToCoverageEnableEXT(m_CommandBuffer, VK_FALSE);
+    vkCmdSetCullMode(m_CommandBuffer, VK_CULL_MODE_BACK_BIT);
+    vkCmdSetFrontFace(m_CommandBuffer, VK_FRONT_FACE_COUNTER_CLOCKWISE);
+    vkCmdSetDepthBiasEnable(m_CommandBuffer, VK_FALSE);
+    vkCmdSetDepthBoundsTestEnable(m_CommandBuffer, VK_FALSE);
+    vkCmdSetStencilTestEnable(m_CommandBuffer, VK_FALSE);
+    vkCmdSetPrimitiveRestartEnable(m_CommandBuffer, VK_FALSE);
+    m_State.FixedState = true;
+  }
 
-  const auto sample_mask = 0xFFFFFFFF;
-  vkCmdSetSampleMaskEXT(m_CommandBuffer, VK_SAMPLE_COUNT_1_BIT, &sample_mask);
-  vkCmdSetRasterizationSamplesEXT(m_CommandBuffer, VK_SAMPLE_COUNT_1_BIT);
-  vkCmdSetRasterizerDiscardEnable(m_CommandBuffer, VK_FALSE);
-  vkCmdSetAlphaToCoverageEnableEXT(m_CommandBuffer, VK_FALSE);
   VkPolygonMode vk_polygon_mode = VK_POLYGON_MODE_FILL;
   switch (m_PolygonMode) {
     case PolygonMode::Fill:
@@ -362,71 +531,80 @@ void VulkanCommandBuffer::BindShaders(const RHIShaderModule* vertex_shader,
       break;
     case PolygonMode::Line:
       vk_polygon_mode = VK_POLYGON_MODE_LINE;
-      vkCmdSetLineWidth(m_CommandBuffer, 1.0F);
+      if (record(!m_State.LineWidth)) {
+        vkCmdSetLineWidth(m_CommandBuffer, 1.0F);
+        m_State.LineWidth = true;
+      }
       break;
     case PolygonMode::Point:
       vk_polygon_mode = VK_POLYGON_MODE_POINT;
       break;
   }
-  vkCmdSetPolygonModeEXT(m_CommandBuffer, vk_polygon_mode);
-  vkCmdSetCullMode(m_CommandBuffer, VK_CULL_MODE_BACK_BIT);
-  vkCmdSetFrontFace(m_CommandBuffer, VK_FRONT_FACE_COUNTER_CLOCKWISE);
+  if (record(Update(m_State.PolygonMode, vk_polygon_mode))) {
+    vkCmdSetPolygonModeEXT(m_CommandBuffer, vk_polygon_mode);
+  }
+
   const VkBool32 depth_test_enable =
       m_CurrentRenderPass.DepthStencilAttachment != nullptr ? VK_TRUE
                                                             : VK_FALSE;
-  vkCmdSetDepthTestEnable(m_CommandBuffer, depth_test_enable);
-  vkCmdSetDepthWriteEnable(m_CommandBuffer, depth_test_enable);
-  if (depth_test_enable == VK_TRUE) {
+  if (record(Update(m_State.DepthTest, depth_test_enable), 2)) {
+    vkCmdSetDepthTestEnable(m_CommandBuffer, depth_test_enable);
+    vkCmdSetDepthWriteEnable(m_CommandBuffer, depth_test_enable);
+  }
+  if (depth_test_enable == VK_TRUE && record(!m_State.DepthCompareOp)) {
     vkCmdSetDepthCompareOp(m_CommandBuffer, VK_COMPARE_OP_LESS);
+    m_State.DepthCompareOp = true;
+  }
+
+  const Extent extent {.Width = m_CurrentRenderPass.Width,
+                       .Height = m_CurrentRenderPass.Height};
+  if (record(Update(m_State.Viewport, extent), 2)) {
+    const VkViewport viewport {
+        .x = 0,
+        .y = static_cast<float>(extent.Height),
+        .width = static_cast<float>(extent.Width),
+        .height = -static_cast<float>(extent.Height),
+        .minDepth = 0.0F,
+        .maxDepth = 1.0F,
+    };
+    vkCmdSetViewportWithCount(m_CommandBuffer, 1, &viewport);
+
+    const VkRect2D scissor {
+        .offset = VkOffset2D {.x = 0, .y = 0},
+        .extent =
+            VkExtent2D {.width = extent.Width, .height = extent.Height},
+    };
+    vkCmdSetScissorWithCount(m_CommandBuffer, 1, &scissor);
   }
-  vkCmdSetDepthBiasEnable(m_CommandBuffer, VK_FALSE);
-  vkCmdSetDepthBoundsTestEnable(m_CommandBuffer, VK_FALSE);
-  vkCmdSetStencilTestEnable(m_CommandBuffer, VK_FALSE);
-  vkCmdSetPrimitiveRestartEnable(m_CommandBuffer, VK_FALSE);
-
-  const VkViewport viewport {
-      .x = 0,
-      .y = static_cast<float>(m_CurrentRenderPass.Height),
-      .width = static_cast<float>(m_CurrentRenderPass.Width),
-      .height = -static_cast<float>(m_CurrentRenderPass.Height),
-      .minDepth = 0.0F,
-      .maxDepth = 1.0F,
-  };
-  vkCmdSetViewportWithCount(m_CommandBuffer, 1, &viewport);
-
-  const VkRect2D scissor {
-      .offset = VkOffset2D {.x = 0, .y = 0},
-      .extent = VkExtent2D {.width = m_CurrentRenderPass.Width,
-                            .height = m_CurrentRenderPass.Height},
-  };
-  vkCmdSetScissorWithCount(m_CommandBuffer, 1, &scissor);
 
   // Color blend state — set for all color attachments
   const uint32_t attachment_count = m_CurrentRenderPass.ColorAttachmentCount;
-
-  std::vector<VkColorBlendEquationEXT> color_blend_equations(attachment_count);
-  for (auto& eq : color_blend_equations) {
-    eq.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
-    eq.dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
-    eq.colorBlendOp = VK_BLEND_OP_ADD;
-    eq.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
-    eq.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
-    eq.alphaBlendOp = VK_BLEND_OP_ADD;
-  }
-  vkCmdSetColorBlendEquationEXT(
-      m_CommandBuffer, 0, attachment_count, color_blend_equations.data());
-
-  std::vector<VkBool32> color_blend_enables(attachment_count, VK_FALSE);
-  vkCmdSetColorBlendEnableEXT(
-      m_CommandBuffer, 0, attachment_count, color_blend_enables.data());
-
-  const VkColorComponentFlags color_write_mask = VK_COLOR_COMPONENT_R_BIT
-      | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT
-      | VK_COLOR_COMPONENT_A_BIT;
-  std::vector<VkColorComponentFlags> color_write_masks(
-      attachment_count, color_write_mask);
-  vkCmdSetColorWriteMaskEXT(
-      m_CommandBuffer, 0, attachment_count, color_write_masks.data());
+  if (record(Update(m_State.BlendAttachments, attachment_count), 3)) {
+    std::vector<VkColorBlendEquationEXT> color_blend_equations(
+        attachment_count);
+    for (auto& eq : color_blend_equations) {
+      eq.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+      eq.dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
+      eq.colorBlendOp = VK_BLEND_OP_ADD;
+      eq.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+      eq.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+      eq.alphaBlendOp = VK_BLEND_OP_ADD;
+    }
+    vkCmdSetColorBlendEquationEXT(
+        m_CommandBuffer, 0, attachment_count, color_blend_equations.data());
+
+    std::vector<VkBool32> color_blend_enables(attachment_count, VK_FALSE);
+    vkCmdSetColorBlendEnableEXT(
+        m_CommandBuffer, 0, attachment_count, color_blend_enables.data());
+
+    const VkColorComponentFlags color_write_mask = VK_COLOR_COMPONENT_R_BIT
+        | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT
+        | VK_COLOR_COMPONENT_A_BIT;
+    std::vector<VkColorComponentFlags> color_write_masks(
+        attachment_count, color_write_mask);
+    vkCmdSetColorWriteMaskEXT(
+        m_CommandBuffer, 0, attachment_count, color_write_masks.data());
+  }
 
   Logger::Trace("[Vulkan] Bound shaders");
 }
@@ -436,6 +614,16 @@ void VulkanCommandBuffer::BindVertexBuffer(const RHIBuffer& buffer,
 {
   const auto& vk_buffer = dynamic_cast<const VulkanBuffer&>(buffer);
   VkBuffer vk_buf = vk_buffer.GetVkBuffer();
+
+  // Bindings past the shadowed range are always recorded
+  const bool tracked = binding < MAX_VERTEX_BINDINGS;
+  if (!record(!tracked || m_State.VertexBuffers.at(binding) != vk_buf)) {
+    return;
+  }
+  if (tracked) {
+    m_State.VertexBuffers.at(binding) = vk_buf;
+  }
+
   const VkDeviceSize offset = 0;
   vkCmdBindVertexBuffers(m_CommandBuffer, binding, 1, &vk_buf, &offset);
 }
@@ -444,12 +632,21 @@ void VulkanCommandBuffer::BindIndexBuffer(const RHIBuffer& buffer)
 {
   const auto& vk_buffer = dynamic_cast<const VulkanBuffer&>(buffer);
   VkBuffer vk_buf = vk_buffer.GetVkBuffer();
+  if (!record(m_State.IndexBuffer != vk_buf)) {
+    return;
+  }
+  m_State.IndexBuffer = vk_buf;
+
   const VkDeviceSize offset = 0;
   vkCmdBindIndexBuffer(m_CommandBuffer, vk_buf, offset, VK_INDEX_TYPE_UINT32);
 }
 
 void VulkanCommandBuffer::SetVertexInput(const VertexInputLayout& layout)
 {
+  if (!record(Update(m_State.VertexInput, layout))) {
+    return;
+  }
+
   std::vector<VkVertexInputBindingDescription2EXT> bindings;
   std::vector<VkVertexInputAttributeDescription2EXT> attributes;
 
@@ -516,7 +713,9 @@ void VulkanCommandBuffer::SetPrimitiveTopology(PrimitiveTopology topology)
       vk_topology = VK_PRIMITIVE_TOPOLOGY_POINT_LIST;
       break;
   }
-  vkCmdSetPrimitiveTopology(m_CommandBuffer, vk_topology);
+  if (record(Update(m_State.Topology, vk_topology))) {
+    vkCmdSetPrimitiveTopology(m_CommandBuffer, vk_topology);
+  }
 }
 
 void VulkanCommandBuffer::SetPolygonMode(PolygonMode mode)
@@ -535,10 +734,31 @@ void VulkanCommandBuffer::BindDescriptorSet(
   const auto& vk_layout = dynamic_cast<const VulkanPipelineLayout&>(layout);
 
   VkDescriptorSet vk_set = vk_descriptor_set.GetVkDescriptorSet();
+  VkPipelineLayout vk_pipeline_layout = vk_layout.GetVkPipelineLayout();
+
+  // Binding with another layout may disturb the other sets, so forget them
+  if (m_State.Layout != vk_pipeline_layout) {
+    m_State.Layout = vk_pipeline_layout;
+    m_State.DescriptorSets = {};
+  }
+
+  if (set_index < MAX_DESCRIPTOR_SETS) {
+    auto& bound = m_State.DescriptorSets.at(set_index);
+    if (!record(bound.Set != vk_set
+                || !std::ranges::equal(bound.DynamicOffsets, dynamic_offsets)))
+    {
+      return;
+    }
+    bound.Set = vk_set;
+    bound.DynamicOffsets.assign(dynamic_offsets.begin(),
+                                dynamic_offsets.end());
+  } else {
+    record(true);
+  }
 
   vkCmdBindDescriptorSets(m_CommandBuffer,
                           VK_PIPELINE_BIND_POINT_GRAPHICS,
-                          vk_layout.GetVkPipelineLayout(),
+                          vk_pipeline_layout,
                           set_index,
                           1,
                           &vk_set,
@@ -571,3 +791,52 @@ void VulkanCommandBuffer::DrawIndexed(uint32_t index_count,
                    vertex_offset,
                    first_instance);
 }
+
+void VulkanCommandBuffer::DrawIndexedIndirect(const RHIBuffer& args_buffer,
+                                              size_t offset,
+                                              uint32_t draw_count,
+                                              uint32_t stride)
+{
+  const auto& vk_buffer = dynamic_cast<const VulkanBuffer&>(args_buffer);
+
+  if (draw_count <= 1 || m_Device->SupportsMultiDrawIndirect()) {
+    vkCmdDrawIndexedIndirect(m_CommandBuffer,
+                             vk_buffer.GetVkBuffer(),
+                             offset,
+                             draw_count,
+                             stride);
+    return;
+  }
+
+  // Without multiDrawIndirect every command needs its own call
+  for (uint32_t i = 0; i < draw_count; ++i) {
+    vkCmdDrawIndexedIndirect(m_CommandBuffer,
+                             vk_buffer.GetVkBuffer(),
+                             offset + static_cast<size_t>(i) * stride,
+                             1,
+                             stride);
+  }
+}
+
+void VulkanCommandBuffer::DrawIndexedIndirectCount(
+    const RHIBuffer& args_buffer,
+    size_t offset,
+    const RHIBuffer& count_buffer,
+    size_t count_offset,
+    uint32_t max_draw_count,
+    uint32_t stride)
+{
+  if (!m_Device->SupportsDrawIndirectCount()) {
+    throw std::runtime_error("drawIndirectCount is not supported by the GPU");
+  }
+
+  const auto& vk_args = dynamic_cast<const VulkanBuffer&>(args_buffer);
+  const auto& vk_count = dynamic_cast<const VulkanBuffer&>(count_buffer);
+  vkCmdDrawIndexedIndirectCount(m_CommandBuffer,
+                                vk_args.GetVkBuffer(),
+                                offset,
+                                vk_count.GetVkBuffer(),
+                                count_offset,
+                                max_draw_count,
+                                stride);
+}
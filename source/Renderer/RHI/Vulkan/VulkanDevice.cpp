@@ -12,6 +12,7 @@
 #include "Renderer/RHI/RHIPipeline.hpp"
 #include "Renderer/RHI/RHIShaderModule.hpp"
 #include "Renderer/RHI/RenderPassInfo.hpp"
+#include "Renderer/RHI/Vulkan/VulkanAllocator.hpp"
 #include "Renderer/RHI/Vulkan/VulkanBuffer.hpp"
 #include "Renderer/RHI/Vulkan/VulkanCommandBuffer.hpp"
 #include "Renderer/RHI/Vulkan/VulkanDescriptorSet.hpp"
@@ -20,6 +21,7 @@
 #include "Renderer/RHI/Vulkan/VulkanSampler.hpp"
 #include "Renderer/RHI/Vulkan/VulkanShaderModule.hpp"
 #include "Renderer/RHI/Vulkan/VulkanTexture.hpp"
+#include "Renderer/RHI/Vulkan/VulkanUploader.hpp"
 #include "Renderer/RHI/Vulkan/VulkanUtils.hpp"
 #include "Renderer/RendererConfig.hpp"
 
@@ -53,6 +55,8 @@ DebugCallback(VkDebugUtilsMessageSeverityFlagBitsEXT message_severity,
   return VK_FALSE;
 }
 
+VulkanDevice::~VulkanDevice() = default;
+
 void VulkanDevice::Init(const RendererConfig& config, void* window)
 {
   if (m_Initialized) {
@@ -158,9 +162,14 @@ void VulkanDevice::Init(const RendererConfig& config, void* window)
   // Create logical device
   create_logical_device(m_Surface);
 
+  m_Allocator = std::make_unique<VulkanAllocator>(
+      m_Instance, m_PhysicalDevice, m_Device);
+
   // Create descriptor pool
   create_descriptor_pool();
 
+  m_Uploader = std::make_unique<VulkanUploader>(*this);
+
   Logger::Info("Created synchronization primitives for {} frames in flight",
                MAX_FRAMES_IN_FLIGHT);
 
@@ -203,6 +212,8 @@ void VulkanDevice::Destroy()
 
   WaitIdle();
 
+  m_Uploader.reset();
+
   for (const auto& frame : m_FrameData) {
     vkDestroySemaphore(m_Device, frame.ImageAvailableSemaphore, nullptr);
     vkDestroyFence(m_Device, frame.InFlightFence, nullptr);
@@ -215,6 +226,10 @@ void VulkanDevice::Destroy()
 
   m_Swapchain.reset();
 
+  // Shows any allocation that outlived its owner
+  m_Allocator->LogStats();
+  m_Allocator.reset();
+
   if (m_DescriptorPool != VK_NULL_HANDLE) {
     vkDestroyDescriptorPool(m_Device, m_DescriptorPool, nullptr);
   }
@@ -262,6 +277,10 @@ void VulkanDevice::EndFrame()
 
   Logger::Trace("[Vulkan] End frame {}", m_CurrentFrameIndex);
 
+  // Copies recorded during the frame must reach the queue before the draws
+  // that read them
+  m_Uploader->Flush();
+
   auto& frame_data = m_FrameData.at(m_CurrentFrameIndex);
   frame_data.CommandBuffer.End();
 
@@ -465,13 +484,43 @@ void VulkanDevice::create_logical_device(VkSurfaceKHR surface)
   queue_create_info.queueCount = 1;
   queue_create_info.pQueuePriorities = &queue_priority;
 
+  // Query optional features before enabling them
+  VkPhysicalDeviceVulkan12Features supported_vulkan12 = {};
+  supported_vulkan12.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+  VkPhysicalDeviceFeatures2 supported_features = {};
+  supported_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+  supported_features.pNext = &supported_vulkan12;
+  vkGetPhysicalDeviceFeatures2(m_PhysicalDevice, &supported_features);
+
+  m_MultiDrawIndirect = supported_features.features.multiDrawIndirect != 0U;
+  m_DrawIndirectCount = supported_vulkan12.drawIndirectCount != 0U;
+  m_DrawIndirectFirstInstance =
+      supported_features.features.drawIndirectFirstInstance != 0U;
+  Logger::Info(
+      "Multi-draw indirect: {}, indirect count: {}, indirect first instance: "
+      "{}",
+      m_MultiDrawIndirect,
+      m_DrawIndirectCount,
+      m_DrawIndirectFirstInstance);
+
   VkPhysicalDeviceFeatures device_features = {};
   device_features.fillModeNonSolid = VK_TRUE;
+  device_features.multiDrawIndirect =
+      supported_features.features.multiDrawIndirect;
+  device_features.drawIndirectFirstInstance =
+      supported_features.features.drawIndirectFirstInstance;
+
+  VkPhysicalDeviceVulkan12Features vulkan12_features = {};
+  vulkan12_features.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+  vulkan12_features.drawIndirectCount = supported_vulkan12.drawIndirectCount;
 
   VkPhysicalDeviceVulkan11Features vulkan11_features = {};
   vulkan11_features.sType =
       VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
   vulkan11_features.shaderDrawParameters = VK_TRUE;
+  vulkan11_features.pNext = &vulkan12_features;
 
   VkPhysicalDeviceShaderObjectFeaturesEXT shader_object_features = {};
   shader_object_features.pNext = &vulkan11_features;
@@ -628,6 +677,38 @@ void VulkanDevice::setup_frame_data()
   }
 }
 
+void VulkanDevice::UploadBuffer(RHIBuffer& buffer,
+                                const void* data,
+                                size_t size,
+                                size_t offset)
+{
+  m_Uploader->CopyToBuffer(
+      static_cast<VulkanBuffer&>(buffer), data, size, offset);
+}
+
+void VulkanDevice::UploadTexture(RHITexture& texture,
+                                 const void* data,
+                                 size_t size)
+{
+  texture.Upload(data, size);
+}
+
+void VulkanDevice::FlushUploads()
+{
+  m_Uploader->Flush();
+}
+
+auto VulkanDevice::GetUploadStats() const -> UploadStats
+{
+  return m_Uploader ? m_Uploader->GetStats() : UploadStats {};
+}
+
+auto VulkanDevice::GetMemoryStats() const -> std::vector<MemoryPoolStats>
+{
+  return m_Allocator ? m_Allocator->GetStats()
+                     : std::vector<MemoryPoolStats> {};
+}
+
 auto VulkanDevice::CreateRenderTarget(const RenderTargetDesc& desc)
     -> std::unique_ptr<RHIRenderTarget>
 {
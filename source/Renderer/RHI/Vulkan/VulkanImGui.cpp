@@ -151,6 +151,8 @@ void VulkanImGui::EndFrame()
 
   ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(),
                                   cmd_buffer->GetHandle());
+  // The backend bound its own pipeline, buffers and descriptors
+  cmd_buffer->InvalidateState();
 }
 
 auto VulkanImGui::RegisterTexture(RHITexture* texture) -> void*
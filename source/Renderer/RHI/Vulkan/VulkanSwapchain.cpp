@@ -6,6 +6,7 @@
 #include "Renderer/RHI/Vulkan/VulkanSwapchain.hpp"
 
 #include "Core/Logger.hpp"
+#include "Renderer/RHI/Vulkan/VulkanAllocator.hpp"
 #include "Renderer/RHI/Vulkan/VulkanDevice.hpp"
 #include "Renderer/RHI/Vulkan/VulkanUtils.hpp"
 
@@ -262,7 +263,6 @@ void VulkanSwapchain::destroy_old_swapchain()
 void VulkanSwapchain::create_depth_buffer()
 {
   VkDevice device = m_Device.GetVkDevice();
-  VkPhysicalDevice physical_device = m_Device.GetVkPhysicalDevice();
 
   VkImageCreateInfo image_info {};
   image_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
@@ -279,59 +279,11 @@ void VulkanSwapchain::create_depth_buffer()
   image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
   image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
-  if (auto result = VkUtils::Check(
-          vkCreateImage(device, &image_info, nullptr, &m_DepthImage));
-      !result)
-  {
-    throw std::runtime_error(std::format("Failed to create depth image: {}",
-                                         VkUtils::ToString(result.error())));
-  }
-
-  VkMemoryRequirements mem_requirements {};
-  vkGetImageMemoryRequirements(device, m_DepthImage, &mem_requirements);
-
-  VkPhysicalDeviceMemoryProperties mem_properties {};
-  vkGetPhysicalDeviceMemoryProperties(physical_device, &mem_properties);
-
-  uint32_t memory_type_index = UINT32_MAX;
-  for (uint32_t i = 0; i < mem_properties.memoryTypeCount; ++i) {
-    if ((mem_requirements.memoryTypeBits & (1 << i)) != 0
-        && (mem_properties.memoryTypes[i].propertyFlags
-            & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
-            == VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
-    {
-      memory_type_index = i;
-      break;
-    }
-  }
-
-  if (memory_type_index == UINT32_MAX) {
-    throw std::runtime_error(
-        "Failed to find suitable memory type for depth buffer");
-  }
-
-  VkMemoryAllocateInfo alloc_info {};
-  alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-  alloc_info.allocationSize = mem_requirements.size;
-  alloc_info.memoryTypeIndex = memory_type_index;
-
-  if (auto result = VkUtils::Check(
-          vkAllocateMemory(device, &alloc_info, nullptr, &m_DepthImageMemory));
-      !result)
-  {
-    throw std::runtime_error(
-        std::format("Failed to allocate depth image memory: {}",
-                    VkUtils::ToString(result.error())));
-  }
-
-  if (auto result = VkUtils::Check(
-          vkBindImageMemory(device, m_DepthImage, m_DepthImageMemory, 0));
-      !result)
-  {
-    throw std::runtime_error(
-        std::format("Failed to bind depth image memory: {}",
-                    VkUtils::ToString(result.error())));
-  }
+  const VulkanImageAllocation allocation =
+      m_Device.GetAllocator().CreateImage(image_info,
+                                          VulkanMemoryPool::RenderTarget);
+  m_DepthImage = allocation.Image;
+  m_DepthAllocation = allocation.Allocation;
 
   VkImageViewCreateInfo view_info {};
   view_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -366,12 +318,8 @@ void VulkanSwapchain::cleanup_depth_buffer()
   }
 
   if (m_DepthImage != VK_NULL_HANDLE) {
-    vkDestroyImage(device, m_DepthImage, nullptr);
+    m_Device.GetAllocator().DestroyImage({m_DepthImage, m_DepthAllocation});
     m_DepthImage = VK_NULL_HANDLE;
-  }
-
-  if (m_DepthImageMemory != VK_NULL_HANDLE) {
-    vkFreeMemory(device, m_DepthImageMemory, nullptr);
-    m_DepthImageMemory = VK_NULL_HANDLE;
+    m_DepthAllocation = VK_NULL_HANDLE;
   }
 }
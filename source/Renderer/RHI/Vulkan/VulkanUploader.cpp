@@ -0,0 +1,434 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "Renderer/RHI/Vulkan/VulkanUploader.hpp"
+
+#include "Core/Logger.hpp"
+#include "Renderer/RHI/Vulkan/VulkanBuffer.hpp"
+#include "Renderer/RHI/Vulkan/VulkanDevice.hpp"
+#include "Renderer/RHI/Vulkan/VulkanUtils.hpp"
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+auto SecondsSince(Clock::time_point start) -> double
+{
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+auto AlignUp(size_t value, size_t alignment) -> size_t
+{
+  return ((value + alignment - 1) / alignment) * alignment;
+}
+
+auto ColorLayoutBarrier(VkImage image,
+                        VkImageLayout old_layout,
+                        VkImageLayout new_layout) -> VkImageMemoryBarrier
+{
+  VkImageMemoryBarrier barrier = {};
+  barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+  barrier.oldLayout = old_layout;
+  barrier.newLayout = new_layout;
+  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.image = image;
+  barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  barrier.subresourceRange.baseMipLevel = 0;
+  barrier.subresourceRange.levelCount = 1;
+  barrier.subresourceRange.baseArrayLayer = 0;
+  barrier.subresourceRange.layerCount = 1;
+  return barrier;
+}
+
+}  // namespace
+
+VulkanUploader::VulkanUploader(const VulkanDevice& device)
+    : m_Device(device)
+{
+  VkDevice vk_device = m_Device.GetVkDevice();
+
+  VkCommandPoolCreateInfo pool_info = {};
+  pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+  pool_info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT
+      | VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+  pool_info.queueFamilyIndex = m_Device.GetGraphicsQueueFamily();
+
+  if (auto result = VkUtils::Check(
+          vkCreateCommandPool(vk_device, &pool_info, nullptr, &m_CommandPool));
+      !result)
+  {
+    throw std::runtime_error(
+        std::format("Failed to create upload command pool: {}",
+                    VkUtils::ToString(result.error())));
+  }
+
+  for (auto& batch : m_Batches) {
+    VkCommandBufferAllocateInfo alloc_info = {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    alloc_info.commandPool = m_CommandPool;
+    alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    alloc_info.commandBufferCount = 1;
+
+    if (auto result = VkUtils::Check(vkAllocateCommandBuffers(
+            vk_device, &alloc_info, &batch.CommandBuffer));
+        !result)
+    {
+      throw std::runtime_error(
+          std::format("Failed to allocate upload command buffer: {}",
+                      VkUtils::ToString(result.error())));
+    }
+
+    VkFenceCreateInfo fence_info = {};
+    fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    if (auto result = VkUtils::Check(
+            vkCreateFence(vk_device, &fence_info, nullptr, &batch.Fence));
+        !result)
+    {
+      throw std::runtime_error(std::format("Failed to create upload fence: {}",
+                                           VkUtils::ToString(result.error())));
+    }
+  }
+}
+
+VulkanUploader::~VulkanUploader()
+{
+  VkDevice vk_device = m_Device.GetVkDevice();
+
+  for (auto& batch : m_Batches) {
+    if (batch.Submitted) {
+      vkWaitForFences(vk_device, 1, &batch.Fence, VK_TRUE, UINT64_MAX);
+    }
+    batch.Staging.reset();
+    vkDestroyFence(vk_device, batch.Fence, nullptr);
+  }
+  vkDestroyCommandPool(vk_device, m_CommandPool, nullptr);
+
+  Logger::Trace("[Vulkan] Destroyed uploader ({} submissions, {} bytes)",
+                m_Stats.Submissions,
+                m_Stats.Bytes);
+}
+
+void VulkanUploader::CopyToBuffer(VulkanBuffer& buffer,
+                                  const void* data,
+                                  size_t size,
+                                  size_t offset)
+{
+  const auto start = Clock::now();
+
+  if (buffer.IsHostVisible()) {
+    buffer.Upload(data, size, offset);
+  } else {
+    if (offset + size > buffer.GetSize()) {
+      throw std::runtime_error(
+          std::format("Vulkan buffer upload out of range: {} + {} > {}",
+                      offset,
+                      size,
+                      buffer.GetSize()));
+    }
+
+    const auto* source = static_cast<const std::byte*>(data);
+    size_t copied = 0;
+    while (copied < size) {
+      Batch& batch = acquire_batch();
+      const size_t chunk = std::min(size - copied, STAGING_SIZE - batch.Used);
+      if (chunk == 0) {
+        Flush();
+        continue;
+      }
+
+      auto* staging = static_cast<std::byte*>(batch.Staging->Map());
+      std::memcpy(staging + batch.Used, source + copied, chunk);
+      batch.Staging->Flush(batch.Used, chunk);
+
+      // The first buffer copy in the batch waits for earlier reads of the
+      // memory it overwrites. Images get the same wait from their layout
+      // transition.
+      if (!batch.BuffersWait) {
+        vkCmdPipelineBarrier(batch.CommandBuffer,
+                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr);
+        batch.BuffersWait = true;
+      }
+
+      VkBufferCopy region = {};
+      region.srcOffset = batch.Used;
+      region.dstOffset = offset + copied;
+      region.size = chunk;
+      vkCmdCopyBuffer(batch.CommandBuffer,
+                      batch.Staging->GetVkBuffer(),
+                      buffer.GetVkBuffer(),
+                      1,
+                      &region);
+
+      batch.Used += chunk;
+      copied += chunk;
+    }
+  }
+
+  m_Stats.Bytes += size;
+  ++m_Stats.Copies;
+  m_Stats.HostSeconds += SecondsSince(start);
+}
+
+void VulkanUploader::CopyToImage(VkImage image,
+                                 uint32_t width,
+                                 uint32_t height,
+                                 VkImageLayout current_layout,
+                                 const void* data,
+                                 size_t size)
+{
+  if (width == 0 || height == 0 || size % height != 0
+      || (size / height) % width != 0)
+  {
+    throw std::runtime_error(std::format(
+        "Texture data of {} bytes does not match {}x{}", size, width, height));
+  }
+
+  const auto start = Clock::now();
+
+  const size_t row_size = size / height;
+  if (row_size > STAGING_SIZE) {
+    throw std::runtime_error(std::format(
+        "Texture row of {} bytes does not fit a staging buffer", row_size));
+  }
+  // Buffer offsets of image copies must be multiples of the texel size and
+  // of four
+  const size_t alignment = std::lcm(row_size / width, 4UZ);
+
+  const auto* source = static_cast<const std::byte*>(data);
+  VkImageLayout layout = current_layout;
+  uint32_t row = 0;
+  while (row < height) {
+    Batch& batch = acquire_batch();
+    const size_t offset = AlignUp(batch.Used, alignment);
+    const size_t rows = (offset < STAGING_SIZE)
+        ? std::min<size_t>(height - row, (STAGING_SIZE - offset) / row_size)
+        : 0;
+    if (rows == 0) {
+      Flush();
+      continue;
+    }
+
+    // The first copy into the image in this batch moves it to TRANSFER_DST;
+    // the barrier at submission moves it on to SHADER_READ_ONLY
+    if (std::ranges::find(batch.Images, image) == batch.Images.end()) {
+      VkImageMemoryBarrier barrier = ColorLayoutBarrier(
+          image, layout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+      barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+      vkCmdPipelineBarrier(batch.CommandBuffer,
+                           VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT,
+                           0,
+                           0,
+                           nullptr,
+                           0,
+                           nullptr,
+                           1,
+                           &barrier);
+      batch.Images.push_back(image);
+      layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    }
+
+    const size_t bytes = rows * row_size;
+    auto* staging = static_cast<std::byte*>(batch.Staging->Map());
+    std::memcpy(staging + offset, source + (row * row_size), bytes);
+    batch.Staging->Flush(offset, bytes);
+
+    VkBufferImageCopy region = {};
+    region.bufferOffset = offset;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = 0;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset = {.x = 0, .y = static_cast<int32_t>(row), .z = 0};
+    region.imageExtent = {
+        .width = width, .height = static_cast<uint32_t>(rows), .depth = 1};
+    vkCmdCopyBufferToImage(batch.CommandBuffer,
+                           batch.Staging->GetVkBuffer(),
+                           image,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           1,
+                           &region);
+
+    batch.Used = offset + bytes;
+    row += static_cast<uint32_t>(rows);
+  }
+
+  m_Stats.Bytes += size;
+  ++m_Stats.Copies;
+  ++m_Stats.TextureCopies;
+  m_Stats.HostSeconds += SecondsSince(start);
+}
+
+void VulkanUploader::Flush()
+{
+  Batch& batch = m_Batches.at(m_Current);
+  if (!batch.Recording) {
+    return;
+  }
+
+  const auto start = Clock::now();
+
+  // Later submissions on this queue may read anything copied in the batch,
+  // and sample every image written in it
+  VkMemoryBarrier barrier = {};
+  barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+  barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+
+  std::vector<VkImageMemoryBarrier> image_barriers;
+  image_barriers.reserve(batch.Images.size());
+  for (VkImage image : batch.Images) {
+    VkImageMemoryBarrier image_barrier =
+        ColorLayoutBarrier(image,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    image_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    image_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    image_barriers.push_back(image_barrier);
+  }
+
+  vkCmdPipelineBarrier(batch.CommandBuffer,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT,
+                       VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                       0,
+                       1,
+                       &barrier,
+                       0,
+                       nullptr,
+                       static_cast<uint32_t>(image_barriers.size()),
+                       image_barriers.data());
+
+  if (auto result = VkUtils::Check(vkEndCommandBuffer(batch.CommandBuffer));
+      !result)
+  {
+    throw std::runtime_error(
+        std::format("Failed to end upload command buffer: {}",
+                    VkUtils::ToString(result.error())));
+  }
+
+  VkSubmitInfo submit_info = {};
+  submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+  submit_info.commandBufferCount = 1;
+  submit_info.pCommandBuffers = &batch.CommandBuffer;
+
+  if (auto result = VkUtils::Check(vkQueueSubmit(
+          m_Device.GetGraphicsQueue(), 1, &submit_info, batch.Fence));
+      !result)
+  {
+    throw std::runtime_error(std::format("Failed to submit uploads: {}",
+                                         VkUtils::ToString(result.error())));
+  }
+
+  Logger::Trace(
+      "[Vulkan] Submitted upload batch {} ({} staged bytes, {} images)",
+      m_Current,
+      batch.Used,
+      image_barriers.size());
+
+  batch.Recording = false;
+  batch.Submitted = true;
+  m_Current = (m_Current + 1) % BATCH_COUNT;
+
+  ++m_Stats.Submissions;
+  m_Stats.HostSeconds += SecondsSince(start);
+}
+
+void VulkanUploader::ReleaseImage(VkImage image)
+{
+  for (auto& batch : m_Batches) {
+    if (std::ranges::find(batch.Images, image) == batch.Images.end()) {
+      continue;
+    }
+    // Only the current batch can still be recording
+    if (batch.Recording) {
+      Flush();
+    }
+    if (batch.Submitted) {
+      wait_batch(batch);
+    }
+    batch.Images.clear();
+  }
+}
+
+auto VulkanUploader::acquire_batch() -> Batch&
+{
+  Batch& batch = m_Batches.at(m_Current);
+  if (batch.Recording) {
+    return batch;
+  }
+
+  if (batch.Submitted) {
+    wait_batch(batch);
+  }
+
+  if (!batch.Staging) {
+    BufferDesc desc {};
+    desc.Size = STAGING_SIZE;
+    desc.Usage = BufferUsage::TransferSrc;
+    desc.CPUVisible = true;
+    desc.PersistentMap = true;
+    batch.Staging = std::make_unique<VulkanBuffer>(m_Device, desc);
+  }
+
+  if (auto result =
+          VkUtils::Check(vkResetCommandBuffer(batch.CommandBuffer, 0));
+      !result)
+  {
+    throw std::runtime_error(
+        std::format("Failed to reset upload command buffer: {}",
+                    VkUtils::ToString(result.error())));
+  }
+
+  VkCommandBufferBeginInfo begin_info = {};
+  begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+  if (auto result = VkUtils::Check(
+          vkBeginCommandBuffer(batch.CommandBuffer, &begin_info));
+      !result)
+  {
+    throw std::runtime_error(
+        std::format("Failed to begin upload command buffer: {}",
+                    VkUtils::ToString(result.error())));
+  }
+
+  batch.Images.clear();
+  batch.Used = 0;
+  batch.BuffersWait = false;
+  batch.Recording = true;
+  return batch;
+}
+
+void VulkanUploader::wait_batch(Batch& batch)
+{
+  VkDevice vk_device = m_Device.GetVkDevice();
+  if (auto result = VkUtils::Check(
+          vkWaitForFences(vk_device, 1, &batch.Fence, VK_TRUE, UINT64_MAX));
+      !result)
+  {
+    throw std::runtime_error(std::format("Failed to wait for uploads: {}",
+                                         VkUtils::ToString(result.error())));
+  }
+  if (auto result = VkUtils::Check(vkResetFences(vk_device, 1, &batch.Fence));
+      !result)
+  {
+    throw std::runtime_error(std::format("Failed to reset upload fence: {}",
+                                         VkUtils::ToString(result.error())));
+  }
+  batch.Submitted = false;
+}
@@ -2,38 +2,121 @@
 
 #include <algorithm>
 #include <format>
+#include <limits>
 #include <stdexcept>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
 
 #include "Core/Logger.hpp"
 #include "Renderer/RHI/RHICommandBuffer.hpp"
 #include "Renderer/RHI/RHIDevice.hpp"
 #include "Renderer/RHI/RHISwapchain.hpp"
 
+namespace
+{
+
+// Last use of resources that are read after the graph ran
+constexpr size_t END_OF_FRAME = std::numeric_limits<size_t>::max();
+
+constexpr double BYTES_PER_MIB = 1024.0 * 1024.0;
+
+// Reading a texture that is already readable needs no barrier; any other
+// access waits for the one before it
+constexpr auto IsReadState(TextureState state) -> bool
+{
+  return state == TextureState::ShaderRead || state == TextureState::DepthRead;
+}
+
+auto GetReadState(const RHITexture& texture) -> TextureState
+{
+  return IsDepthFormat(texture.GetFormat()) ? TextureState::DepthRead
+                                            : TextureState::ShaderRead;
+}
+
+auto GetTargetBytes(const RenderTargetDesc& desc) -> uint64_t
+{
+  const uint64_t pixels = static_cast<uint64_t>(desc.Width) * desc.Height;
+  uint64_t bytes = 0;
+  for (const auto format : desc.ColorFormats) {
+    bytes += pixels * GetBytesPerPixel(format);
+  }
+  if (desc.HasDepth) {
+    bytes += pixels * GetBytesPerPixel(desc.DepthFormat);
+  }
+  return bytes;
+}
+
+}  // namespace
+
 void RenderGraph::AddResource(const ResourceDesc& desc)
 {
-  m_Resources[desc.Name] = Resource {.Desc = desc, .Target = nullptr};
+  m_Resources[desc.Name] = Resource {.Desc = desc};
   m_Compiled = false;
 }
 
 void RenderGraph::AddPass(const PassDesc& desc)
 {
-  m_Passes.push_back(Pass {.Desc = desc, .ResolvedInfo = {}, .ResolvedDepthStencil = {}});
+  m_Passes.push_back(Pass {.Desc = desc,
+                          .ResolvedInfo = {},
+                          .ResolvedDepthStencil = {},
+                          .Barriers = {}});
   m_Compiled = false;
 }
 
 void RenderGraph::Compile(RHIDevice& device)
 {
+  PlanKey plan_key = makePlanKey();
+  const size_t plan_hash = hashPlanKey(plan_key);
+  if (m_PlanKey.has_value() && m_PlanHash == plan_hash
+      && *m_PlanKey == plan_key)
+  {
+    // Only the pass state is rebuilt, as it points into the new descriptions.
+    // Targets that already went through their initial barriers keep their
+    // contents.
+    const bool targets_initialized = m_InitialBarriers.empty();
+    buildRenderPassInfos();
+    buildBarriers();
+    if (targets_initialized) {
+      m_InitialBarriers.clear();
+    }
+    m_CompileStats.ReusedPlan = true;
+    m_Compiled = true;
+    Logger::Trace("[RenderGraph] Reused compiled plan for {} passes",
+                  m_ExecutionOrder.size());
+    return;
+  }
+
   topologicalSort();
+  cullPasses();
+  computeLifetimes();
   createResources(device);
   buildRenderPassInfos();
+  buildBarriers();
+  m_PlanKey = std::move(plan_key);
+  m_PlanHash = plan_hash;
+  m_CompileStats.ReusedPlan = false;
   m_Compiled = true;
-  Logger::Info("[RenderGraph] Compiled {} passes, {} resources",
-               m_Passes.size(),
+  Logger::Info("[RenderGraph] Compiled {} passes ({} culled), {} resources",
+               m_ExecutionOrder.size(),
+               m_CompileStats.CulledPassCount,
                m_Resources.size());
+  Logger::Info(
+      "[RenderGraph] Render target memory: {:.1f} MiB for {} resources, "
+      "{:.1f} MiB in {} targets after sharing",
+      static_cast<double>(m_MemoryStats.RequiredBytes) / BYTES_PER_MIB,
+      m_MemoryStats.ResourceCount,
+      static_cast<double>(m_MemoryStats.AllocatedBytes) / BYTES_PER_MIB,
+      m_MemoryStats.TargetCount);
 }
 
 void RenderGraph::Execute(RHICommandBuffer& cmd)
 {
+  if (!m_InitialBarriers.empty()) {
+    cmd.Barrier(m_InitialBarriers);
+    m_InitialBarriers.clear();
+  }
+
   for (size_t idx : m_ExecutionOrder) {
     auto& pass = m_Passes[idx];
 
@@ -43,10 +126,17 @@ void RenderGraph::Execute(RHICommandBuffer& cmd)
       pass.ResolvedInfo.Height = m_BackbufferHeight;
     }
 
+    if (!pass.Barriers.empty()) {
+      cmd.Barrier(pass.Barriers);
+    }
     cmd.BeginRenderPass(pass.ResolvedInfo);
     pass.Desc.Execute(cmd);
     cmd.EndRenderPass();
   }
+
+  if (!m_FinalBarriers.empty()) {
+    cmd.Barrier(m_FinalBarriers);
+  }
 }
 
 void RenderGraph::SetBackbufferSize(uint32_t width, uint32_t height)
@@ -62,31 +152,34 @@ auto RenderGraph::IsCompiled() const -> bool
 
 auto RenderGraph::GetTexture(const std::string& name) -> RHITexture*
 {
-  // Check MRT attachment map first
   auto map_it = m_AttachmentMap.find(name);
-  if (map_it != m_AttachmentMap.end()) {
-    if (map_it->second.IsDepth) {
-      return map_it->second.SharedTarget->GetDepthTexture();
-    }
-    return map_it->second.SharedTarget->GetColorTexture(
-        map_it->second.AttachmentIndex);
-  }
-
-  // Fallback to single-resource path
-  auto it = m_Resources.find(name);
-  if (it == m_Resources.end() || it->second.Target == nullptr) {
+  if (map_it == m_AttachmentMap.end()) {
     return nullptr;
   }
-  return it->second.Target->GetColorTexture(0);
+  if (map_it->second.IsDepth) {
+    return map_it->second.SharedTarget->GetDepthTexture();
+  }
+  return map_it->second.SharedTarget->GetColorTexture(
+      map_it->second.AttachmentIndex);
 }
 
 auto RenderGraph::GetRenderTarget(const std::string& name) -> RHIRenderTarget*
 {
-  auto it = m_Resources.find(name);
-  if (it == m_Resources.end()) {
+  auto map_it = m_AttachmentMap.find(name);
+  if (map_it == m_AttachmentMap.end()) {
     return nullptr;
   }
-  return it->second.Target.get();
+  return map_it->second.SharedTarget;
+}
+
+auto RenderGraph::GetMemoryStats() const -> const MemoryStats&
+{
+  return m_MemoryStats;
+}
+
+auto RenderGraph::GetCompileStats() const -> const CompileStats&
+{
+  return m_CompileStats;
 }
 
 void RenderGraph::Resize(RHIDevice& device, uint32_t width, uint32_t height)
@@ -97,12 +190,24 @@ void RenderGraph::Resize(RHIDevice& device, uint32_t width, uint32_t height)
     }
     resource.Desc.Width = width;
     resource.Desc.Height = height;
-    resource.Target.reset();
   }
-  m_AttachmentMap.clear();
-  m_SharedTargets.clear();
+
+  // Otherwise the next Compile() plans with the new size
+  if (!m_Compiled) {
+    return;
+  }
   createResources(device);
   buildRenderPassInfos();
+  buildBarriers();
+  m_PlanKey = makePlanKey();
+  m_PlanHash = hashPlanKey(*m_PlanKey);
+}
+
+void RenderGraph::Reset()
+{
+  m_Resources.clear();
+  m_Passes.clear();
+  m_Compiled = false;
 }
 
 void RenderGraph::Clear()
@@ -110,11 +215,70 @@ void RenderGraph::Clear()
   m_Resources.clear();
   m_Passes.clear();
   m_ExecutionOrder.clear();
+  m_Lifetimes.clear();
   m_AttachmentMap.clear();
   m_SharedTargets.clear();
+  m_MemoryStats = {};
+  m_CompileStats = {};
+  m_PlanKey.reset();
+  m_PlanHash = 0;
+  m_InitialBarriers.clear();
+  m_FinalBarriers.clear();
   m_Compiled = false;
 }
 
+auto RenderGraph::makePlanKey() const -> PlanKey
+{
+  PlanKey key;
+  for (const auto& [name, resource] : m_Resources) {
+    key.Resources.push_back(resource.Desc);
+  }
+  std::ranges::sort(key.Resources, {}, &ResourceDesc::Name);
+
+  // Load ops, clear values and callbacks only affect the render pass infos,
+  // which are rebuilt on every compile. The attachments a pass uses decide
+  // which textures it transitions, and so the states they end a frame in.
+  for (const auto& pass : m_Passes) {
+    key.Passes.push_back({
+        .Inputs = pass.Desc.Inputs,
+        .Outputs = pass.Desc.Outputs,
+        .ColorAttachmentCount = pass.Desc.ColorAttachmentCount,
+        .UseDepth = pass.Desc.UseDepth,
+    });
+  }
+  return key;
+}
+
+auto RenderGraph::hashPlanKey(const PlanKey& key) -> size_t
+{
+  size_t seed = 0;
+  auto hash_combine = [&seed](const auto& value) -> auto
+  {
+    seed ^= std::hash<std::decay_t<decltype(value)>> {}(value) + 0x9e3779b9
+        + (seed << 6) + (seed >> 2);
+  };
+
+  for (const auto& desc : key.Resources) {
+    hash_combine(desc.Name);
+    hash_combine(desc.Width);
+    hash_combine(desc.Height);
+    hash_combine(desc.ColorFormat);
+    hash_combine(desc.DepthFormat);
+    hash_combine(desc.HasDepth);
+    hash_combine(desc.IsDepth);
+    hash_combine(desc.Exported);
+  }
+  for (const auto& pass : key.Passes) {
+    hash_combine(pass.Inputs.size());
+    std::ranges::for_each(pass.Inputs, hash_combine);
+    hash_combine(pass.Outputs.size());
+    std::ranges::for_each(pass.Outputs, hash_combine);
+    hash_combine(pass.ColorAttachmentCount);
+    hash_combine(pass.UseDepth);
+  }
+  return seed;
+}
+
 void RenderGraph::topologicalSort()
 {
   const size_t pass_count = m_Passes.size();
@@ -167,17 +331,129 @@ void RenderGraph::topologicalSort()
   }
 }
 
+void RenderGraph::cullPasses()
+{
+  const size_t pass_count = m_ExecutionOrder.size();
+
+  // Walking back from the last pass, a pass is kept when it writes the
+  // backbuffer, an exported resource or anything a kept pass reads. Passes
+  // without outputs render to the backbuffer.
+  std::vector<bool> kept(m_Passes.size(), false);
+  std::unordered_set<std::string> read;
+  for (auto it = m_ExecutionOrder.rbegin(); it != m_ExecutionOrder.rend(); ++it)
+  {
+    const auto& desc = m_Passes[*it].Desc;
+    auto is_needed = [this, &read](const std::string& output) -> bool
+    {
+      if (output == BACKBUFFER || read.contains(output)) {
+        return true;
+      }
+      auto res_it = m_Resources.find(output);
+      return res_it != m_Resources.end() && res_it->second.Desc.Exported;
+    };
+
+    if (desc.Outputs.empty() || std::ranges::any_of(desc.Outputs, is_needed))
+    {
+      kept[*it] = true;
+      read.insert(desc.Inputs.begin(), desc.Inputs.end());
+    }
+  }
+
+  std::erase_if(m_ExecutionOrder,
+                [&kept](size_t idx) -> bool { return !kept[idx]; });
+
+  m_CompileStats.PassCount = static_cast<uint32_t>(pass_count);
+  m_CompileStats.CulledPassCount =
+      static_cast<uint32_t>(pass_count - m_ExecutionOrder.size());
+}
+
+void RenderGraph::computeLifetimes()
+{
+  m_Lifetimes.clear();
+
+  for (size_t position = 0; position < m_ExecutionOrder.size(); ++position) {
+    const auto& desc = m_Passes[m_ExecutionOrder[position]].Desc;
+    auto use = [this, position](const std::string& name) -> void
+    {
+      auto it = m_Lifetimes.find(name);
+      if (it == m_Lifetimes.end()) {
+        m_Lifetimes.emplace(name,
+                            Lifetime {.First = position, .Last = position});
+      } else {
+        it->second.Last = position;
+      }
+    };
+    std::ranges::for_each(desc.Inputs, use);
+    std::ranges::for_each(desc.Outputs, use);
+  }
+
+  for (const auto& [name, resource] : m_Resources) {
+    auto it = m_Lifetimes.find(name);
+    if (resource.Desc.Exported && it != m_Lifetimes.end()) {
+      it->second.Last = END_OF_FRAME;
+    }
+  }
+}
+
 void RenderGraph::createResources(RHIDevice& device)
 {
   m_AttachmentMap.clear();
   m_SharedTargets.clear();
+  m_MemoryStats = {};
+
+  // Layout and last use of each render target, parallel to m_SharedTargets
+  struct TargetUse
+  {
+    RenderTargetDesc Desc;
+    size_t LastUse {0};
+  };
+  std::vector<TargetUse> target_uses;
+
+  // Hands out a target of the requested layout that is no longer used when
+  // the lifetime starts, creating one when there is none
+  auto acquire = [&](const RenderTargetDesc& rt_desc,
+                     Lifetime lifetime) -> RHIRenderTarget*
+  {
+    const uint64_t bytes = GetTargetBytes(rt_desc);
+    m_MemoryStats.RequiredBytes += bytes;
+
+    for (size_t i = 0; i < target_uses.size(); ++i) {
+      if (target_uses[i].LastUse < lifetime.First
+          && target_uses[i].Desc == rt_desc)
+      {
+        target_uses[i].LastUse = lifetime.Last;
+        return m_SharedTargets[i].get();
+      }
+    }
 
-  for (auto& pass : m_Passes) {
+    m_SharedTargets.push_back(device.CreateRenderTarget(rt_desc));
+    target_uses.push_back({.Desc = rt_desc, .LastUse = lifetime.Last});
+    m_MemoryStats.AllocatedBytes += bytes;
+    ++m_MemoryStats.TargetCount;
+    return m_SharedTargets.back().get();
+  };
+
+  // A target lives from the first use of any of its resources to the last
+  auto span = [this](const std::vector<std::string>& names) -> Lifetime
+  {
+    Lifetime lifetime {.First = END_OF_FRAME, .Last = 0};
+    for (const auto& name : names) {
+      const Lifetime& resource = m_Lifetimes.at(name);
+      lifetime.First = std::min(lifetime.First, resource.First);
+      lifetime.Last = std::max(lifetime.Last, resource.Last);
+    }
+    return lifetime;
+  };
+
+  // Targets are handed out in execution order, so a target freed by an
+  // earlier pass can back the outputs of a later one
+  for (size_t idx : m_ExecutionOrder) {
+    const auto& pass = m_Passes[idx];
     std::vector<std::string> color_outputs;
     std::string depth_output;
 
     for (const auto& output : pass.Desc.Outputs) {
-      if (output == BACKBUFFER) {
+      if (output == BACKBUFFER || m_AttachmentMap.contains(output)) {
         continue;
       }
       auto it = m_Resources.find(output);
@@ -192,6 +468,11 @@ void RenderGraph::createResources(RHIDevice& device)
       }
     }
 
+    std::vector<std::string> members = color_outputs;
+    if (!depth_output.empty()) {
+      members.push_back(depth_output);
+    }
+
     // MRT case: multiple color outputs or color + depth from one pass
     if (color_outputs.size() > 1
         || (!color_outputs.empty() && !depth_output.empty()))
@@ -212,8 +493,8 @@ void RenderGraph::createResources(RHIDevice& device)
         rt_desc.HasDepth = false;
       }
 
-      auto shared_rt = device.CreateRenderTarget(rt_desc);
-      auto* rt_ptr = shared_rt.get();
+      auto* rt_ptr = acquire(rt_desc, span(members));
+      m_MemoryStats.ResourceCount += static_cast<uint32_t>(members.size());
 
       for (size_t i = 0; i < color_outputs.size(); ++i) {
         m_AttachmentMap[color_outputs[i]] = {
@@ -229,20 +510,12 @@ void RenderGraph::createResources(RHIDevice& device)
             .IsDepth = true,
         };
       }
-
-      m_SharedTargets.push_back(std::move(shared_rt));
       continue;  // Skip single-output path for passes already handled
     }
 
     // Single output -- existing path
-    for (const auto& output : pass.Desc.Outputs) {
-      if (output == BACKBUFFER) {
-        continue;
-      }
-      auto& resource = m_Resources[output];
-      if (resource.Target != nullptr) {
-        continue;
-      }
+    for (const auto& output : members) {
+      const auto& resource = m_Resources[output];
 
       RenderTargetDesc rt_desc;
       rt_desc.Width = resource.Desc.Width;
@@ -250,7 +523,13 @@ void RenderGraph::createResources(RHIDevice& device)
       rt_desc.ColorFormats = {resource.Desc.ColorFormat};
       rt_desc.DepthFormat = resource.Desc.DepthFormat;
       rt_desc.HasDepth = resource.Desc.HasDepth;
-      resource.Target = device.CreateRenderTarget(rt_desc);
+
+      m_AttachmentMap[output] = {
+          .SharedTarget = acquire(rt_desc, span({output})),
+          .AttachmentIndex = 0,
+          .IsDepth = false,
+      };
+      ++m_MemoryStats.ResourceCount;
     }
   }
 }
@@ -261,6 +540,7 @@ void RenderGraph::buildRenderPassInfos()
     RenderPassInfo info {};
     info.ColorAttachments = pass.Desc.ColorAttachments;
     info.ColorAttachmentCount = pass.Desc.ColorAttachmentCount;
+    info.ExplicitBarriers = true;
 
     bool writes_backbuffer = false;
     for (const auto& output : pass.Desc.Outputs) {
@@ -273,21 +553,11 @@ void RenderGraph::buildRenderPassInfos()
     if (writes_backbuffer) {
       info.RenderTarget = nullptr;
     } else if (!pass.Desc.Outputs.empty()) {
-      // Check MRT attachment map first
-      const auto& first_output = pass.Desc.Outputs[0];
-      auto map_it = m_AttachmentMap.find(first_output);
+      auto map_it = m_AttachmentMap.find(pass.Desc.Outputs[0]);
       if (map_it != m_AttachmentMap.end()) {
         info.RenderTarget = map_it->second.SharedTarget;
         info.Width = info.RenderTarget->GetWidth();
         info.Height = info.RenderTarget->GetHeight();
-      } else {
-        // Single output path
-        auto it = m_Resources.find(first_output);
-        if (it != m_Resources.end() && it->second.Target != nullptr) {
-          info.RenderTarget = it->second.Target.get();
-          info.Width = it->second.Target->GetWidth();
-          info.Height = it->second.Target->GetHeight();
-        }
       }
     }
 
@@ -299,3 +569,98 @@ void RenderGraph::buildRenderPassInfos()
     pass.ResolvedInfo = info;
   }
 }
+
+void RenderGraph::buildBarriers()
+{
+  struct Access
+  {
+    RHITexture* Texture {nullptr};
+    TextureState State {TextureState::Undefined};
+    bool Discard {false};
+  };
+
+  // Attachments the pass renders to, then the textures it samples
+  auto get_accesses = [this](const Pass& pass) -> std::vector<Access>
+  {
+    std::vector<Access> accesses;
+    auto* target = pass.ResolvedInfo.RenderTarget;
+    if (target != nullptr) {
+      for (uint32_t i = 0; i < pass.ResolvedInfo.ColorAttachmentCount; ++i) {
+        if (auto* texture = target->GetColorTexture(i)) {
+          accesses.push_back({
+              .Texture = texture,
+              .State = TextureState::ColorAttachment,
+              .Discard =
+                  pass.Desc.ColorAttachments[i].ColorLoadOp != LoadOp::Load,
+          });
+        }
+      }
+      auto* depth = target->GetDepthTexture();
+      if (pass.Desc.UseDepth && depth != nullptr) {
+        const auto& depth_stencil = pass.Desc.DepthStencil;
+        accesses.push_back({
+            .Texture = depth,
+            .State = TextureState::DepthAttachment,
+            .Discard = depth_stencil.DepthLoadOp != LoadOp::Load
+                && depth_stencil.StencilLoadOp != LoadOp::Load,
+        });
+      }
+    }
+
+    for (const auto& input : pass.Desc.Inputs) {
+      auto* texture = GetTexture(input);
+      if (texture == nullptr
+          || std::ranges::contains(accesses, texture, &Access::Texture))
+      {
+        continue;
+      }
+      accesses.push_back(
+          {.Texture = texture, .State = GetReadState(*texture)});
+    }
+    return accesses;
+  };
+
+  std::unordered_map<RHITexture*, TextureState> states;
+  auto transition = [&states](const Access& access,
+                              std::vector<TextureBarrier>& barriers) -> void
+  {
+    auto it = states.try_emplace(access.Texture, TextureState::Undefined).first;
+    if (it->second == access.State && IsReadState(access.State)) {
+      return;
+    }
+    barriers.push_back({.Texture = access.Texture,
+                        .Before = it->second,
+                        .After = access.State,
+                        .Discard = access.Discard});
+    it->second = access.State;
+  };
+
+  // The first run only finds the states a frame ends with, which the second
+  // starts from
+  for (int run = 0; run < 2; ++run) {
+    for (size_t idx : m_ExecutionOrder) {
+      auto& pass = m_Passes[idx];
+      pass.Barriers.clear();
+      for (const auto& access : get_accesses(pass)) {
+        transition(access, pass.Barriers);
+      }
+    }
+
+    m_FinalBarriers.clear();
+    for (const auto& [name, resource] : m_Resources) {
+      auto* texture = resource.Desc.Exported ? GetTexture(name) : nullptr;
+      if (texture != nullptr) {
+        transition({.Texture = texture, .State = GetReadState(*texture)},
+                   m_FinalBarriers);
+      }
+    }
+  }
+
+  m_InitialBarriers.clear();
+  for (const auto& [texture, state] : states) {
+    m_InitialBarriers.push_back({.Texture = texture,
+                                 .Before = TextureState::Undefined,
+                                 .After = state,
+                                 .Discard = true});
+  }
+}
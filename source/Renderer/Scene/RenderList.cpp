@@ -0,0 +1,88 @@
+#include <limits>
+
+#include "Renderer/Scene/RenderList.hpp"
+
+#include "Renderer/Scene/SceneNode.hpp"
+
+namespace
+{
+
+constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+void FillItem(RenderItem& item, SceneNode& node)
+{
+  item.Node = &node;
+  item.WorldMatrix = &node.GetTransform().GetWorldMatrix();
+  item.Asset = node.GetModel().get();
+  item.Bounds = node.GetWorldBounds();
+}
+
+}  // namespace
+
+void RenderList::Add(SceneNode& node)
+{
+  const TransformHandle handle = node.GetTransform().GetHandle();
+  if (handle == kInvalidTransformHandle) {
+    return;
+  }
+
+  uint32_t index = index_of(handle);
+  if (index == INVALID_INDEX) {
+    if (handle >= m_HandleItems.size()) {
+      m_HandleItems.resize(handle + 1, INVALID_INDEX);
+    }
+    index = static_cast<uint32_t>(m_Items.size());
+    m_HandleItems[handle] = index;
+    m_Items.emplace_back();
+  }
+  FillItem(m_Items[index], node);
+}
+
+void RenderList::Remove(const SceneNode& node)
+{
+  const TransformHandle handle = node.GetTransform().GetHandle();
+  const uint32_t index = index_of(handle);
+  if (index == INVALID_INDEX) {
+    return;
+  }
+
+  const auto last = static_cast<uint32_t>(m_Items.size() - 1);
+  if (index != last) {
+    m_Items[index] = m_Items[last];
+    m_HandleItems[m_Items[index].Node->GetTransform().GetHandle()] = index;
+  }
+  m_Items.pop_back();
+  m_HandleItems[handle] = INVALID_INDEX;
+}
+
+void RenderList::Clear()
+{
+  m_Items.clear();
+  m_HandleItems.clear();
+}
+
+void RenderList::UpdateBounds(TransformHandle handle)
+{
+  const uint32_t index = index_of(handle);
+  if (index != INVALID_INDEX) {
+    m_Items[index].Bounds = m_Items[index].Node->GetWorldBounds();
+  }
+}
+
+void RenderList::RefreshMatrices(uint64_t layout_version)
+{
+  for (auto& item : m_Items) {
+    item.WorldMatrix = &item.Node->GetTransform().GetWorldMatrix();
+  }
+  m_LayoutVersion = layout_version;
+}
+
+auto RenderList::Contains(const SceneNode& node) const -> bool
+{
+  return index_of(node.GetTransform().GetHandle()) != INVALID_INDEX;
+}
+
+auto RenderList::index_of(TransformHandle handle) const -> uint32_t
+{
+  return handle < m_HandleItems.size() ? m_HandleItems[handle] : INVALID_INDEX;
+}
@@ -1,15 +1,56 @@
 #include "Renderer/Scene/Scene.hpp"
 
+#include "Core/ThreadPool.hpp"
+
 Scene::Scene(std::string name)
     : m_Name(std::move(name))
+    , m_TransformStore(std::make_unique<TransformStore>())
     , m_Root(std::make_unique<SceneNode>("Root"))
 {
+  m_Root->SetScene(this);
+  add_name(m_Root->GetName(), *m_Root);
 }
 
 Scene::~Scene() = default;
 
-Scene::Scene(Scene&&) noexcept = default;
-auto Scene::operator=(Scene&&) noexcept -> Scene& = default;
+Scene::Scene(Scene&& other) noexcept
+    : m_Name(std::move(other.m_Name))
+    , m_TransformStore(std::move(other.m_TransformStore))
+    , m_Root(std::move(other.m_Root))
+    , m_UpdatePool(std::move(other.m_UpdatePool))
+    , m_ActiveCamera(other.m_ActiveCamera)
+    , m_NameIndex(std::move(other.m_NameIndex))
+    , m_NameSuffixes(std::move(other.m_NameSuffixes))
+    , m_RenderList(std::move(other.m_RenderList))
+    , m_BVH(std::move(other.m_BVH))
+    , m_SpatialIndexDirty(other.m_SpatialIndexDirty)
+{
+  if (m_Root) {
+    m_Root->SetScene(this);
+  }
+}
+
+auto Scene::operator=(Scene&& other) noexcept -> Scene&
+{
+  if (this != &other) {
+    // Release our nodes while the store they point into is still alive
+    m_Root.reset();
+    m_Name = std::move(other.m_Name);
+    m_TransformStore = std::move(other.m_TransformStore);
+    m_Root = std::move(other.m_Root);
+    m_UpdatePool = std::move(other.m_UpdatePool);
+    m_ActiveCamera = other.m_ActiveCamera;
+    m_NameIndex = std::move(other.m_NameIndex);
+    m_NameSuffixes = std::move(other.m_NameSuffixes);
+    m_RenderList = std::move(other.m_RenderList);
+    m_BVH = std::move(other.m_BVH);
+    m_SpatialIndexDirty = other.m_SpatialIndexDirty;
+    if (m_Root) {
+      m_Root->SetScene(this);
+    }
+  }
+  return *this;
+}
 
 auto Scene::GetRoot() -> SceneNode&
 {
@@ -29,10 +70,8 @@ auto Scene::CreateNode(const std::string& name, SceneNode* parent) -> SceneNode*
 
 auto Scene::FindNode(const std::string& name) const -> SceneNode*
 {
-  if (m_Root->GetName() == name) {
-    return m_Root.get();
-  }
-  return m_Root->FindChildRecursive(name);
+  const auto iter = m_NameIndex.find(name);
+  return (iter != m_NameIndex.end()) ? iter->second.front() : nullptr;
 }
 
 void Scene::SetName(const std::string& name)
@@ -47,79 +86,103 @@ auto Scene::GetName() const -> const std::string&
 
 void Scene::UpdateTransforms()
 {
-  m_Root->UpdateTransforms();
-}
+  m_TransformStore->UpdateWorldMatrices(m_UpdatePool.get());
 
-auto Scene::GetBounds() const -> AABB
-{
-  AABB bounds;
-  ForEachNode(
-      [&bounds](const SceneNode& node) -> void
+  // A dirty index is rebuilt from scratch on its next use anyway
+  const bool refit = !m_SpatialIndexDirty;
+  m_TransformStore->ForEachUpdatedHandle(
+      [this, refit](TransformHandle handle) -> void
       {
-        if (node.IsVisibleInHierarchy() && node.HasModel()) {
-          bounds.Expand(node.GetWorldBounds());
+        m_RenderList.UpdateBounds(handle);
+        if (refit) {
+          m_BVH.MarkMoved(handle);
         }
       });
-  return bounds;
+  if (refit) {
+    m_BVH.Refit();
+  }
+}
+
+auto Scene::GetTransformStore() -> TransformStore&
+{
+  return *m_TransformStore;
+}
+
+void Scene::SetTransformUpdateThreads(uint32_t thread_count)
+{
+  if (thread_count == GetTransformUpdateThreads()) {
+    return;
+  }
+
+  if (thread_count <= 1) {
+    m_UpdatePool.reset();
+  } else {
+    m_UpdatePool = std::make_unique<ThreadPool>(thread_count);
+  }
+}
+
+auto Scene::GetTransformUpdateThreads() const -> uint32_t
+{
+  return m_UpdatePool ? m_UpdatePool->GetThreadCount() : 1;
+}
+
+auto Scene::GetBounds() const -> AABB
+{
+  return spatial_index().GetBounds();
 }
 
 void Scene::ForEachNode(const std::function<void(SceneNode&)>& callback)
 {
-  std::function<void(SceneNode&)> traverse = [&](SceneNode& node) -> void
-  {
-    callback(node);
-    for (const auto& child : node.GetChildren()) {
-      traverse(*child);
-    }
-  };
-  traverse(*m_Root);
+  traverse(*m_Root,
+           [&callback](SceneNode& node) -> bool
+           {
+             callback(node);
+             return true;
+           });
 }
 
 void Scene::ForEachNode(
     const std::function<void(const SceneNode&)>& callback) const
 {
-  std::function<void(const SceneNode&)> traverse =
-      [&](const SceneNode& node) -> void
-  {
-    callback(node);
-    for (const auto& child : node.GetChildren()) {
-      traverse(*child);
-    }
-  };
-  traverse(*m_Root);
+  traverse(std::as_const(*m_Root),
+           [&callback](const SceneNode& node) -> bool
+           {
+             callback(node);
+             return true;
+           });
 }
 
 auto Scene::GetRenderableNodes() const -> std::vector<SceneNode*>
 {
+  const auto items = GetRenderList();
   std::vector<SceneNode*> nodes;
-  std::function<void(SceneNode&)> collect = [&](SceneNode& node) -> void
-  {
-    if (node.IsVisibleInHierarchy() && node.HasModel()) {
-      nodes.push_back(&node);
-    }
-    for (const auto& child : node.GetChildren()) {
-      collect(*child);
-    }
-  };
-  collect(*m_Root);
+  nodes.reserve(items.size());
+  for (const auto& item : items) {
+    nodes.push_back(item.Node);
+  }
   return nodes;
 }
 
+auto Scene::GetRenderList() const -> std::span<const RenderItem>
+{
+  const uint64_t layout_version = m_TransformStore->GetLayoutVersion();
+  if (m_RenderList.GetLayoutVersion() != layout_version) {
+    m_RenderList.RefreshMatrices(layout_version);
+  }
+  return m_RenderList.GetItems();
+}
+
 auto Scene::GetNodeCount() const -> size_t
 {
-  return count_nodes(*m_Root);
+  size_t count = 0;
+  ForEachNode([&count](const SceneNode& /*node*/) -> void { ++count; });
+  return count;
 }
 
 auto Scene::GetVisibleNodeCount() const -> size_t
 {
   size_t count = 0;
-  ForEachNode(
-      [&count](const SceneNode& node) -> void
-      {
-        if (node.IsVisibleInHierarchy()) {
-          ++count;
-        }
-      });
+  ForEachVisibleNode([&count](const SceneNode& /*node*/) -> void { ++count; });
   return count;
 }
 
@@ -135,20 +198,62 @@ auto Scene::GetActiveCamera() const -> Camera*
 
 auto Scene::PickNode(const Ray& ray) const -> SceneNode*
 {
-  const auto nodes = GetRenderableNodes();
-  SceneNode* closest = nullptr;
-  float closest_t = std::numeric_limits<float>::max();
+  float t_hit = 0.0F;
+  return spatial_index().RayCast(ray, t_hit);
+}
 
-  for (auto* node : nodes) {
-    const AABB bounds = node->GetWorldBounds();
-    float t_hit = 0.0F;
-    if (bounds.Intersects(ray, t_hit) && t_hit < closest_t) {
-      closest_t = t_hit;
-      closest = node;
-    }
+auto Scene::QueryRay(const Ray& ray) const -> std::vector<SceneNode*>
+{
+  std::vector<SceneNode*> results;
+  spatial_index().QueryRay(ray, results);
+  return results;
+}
+
+auto Scene::QueryAABB(const AABB& bounds) const -> std::vector<SceneNode*>
+{
+  std::vector<SceneNode*> results;
+  spatial_index().QueryAABB(bounds, results);
+  return results;
+}
+
+auto Scene::QuerySphere(const BoundingSphere& sphere) const
+    -> std::vector<SceneNode*>
+{
+  std::vector<SceneNode*> results;
+  spatial_index().QuerySphere(sphere, results);
+  return results;
+}
+
+void Scene::OnNodeChanged(SceneNode& node, SceneNodeChange change)
+{
+  m_SpatialIndexDirty = true;
+
+  switch (change) {
+    case SceneNodeChange::Attached:
+      index_names(node);
+      sync_render_list(node);
+      break;
+    case SceneNodeChange::VisibilityChanged:
+      sync_render_list(node);
+      break;
+    case SceneNodeChange::ModelChanged:
+      if (node.IsVisibleInHierarchy() && node.HasModel()) {
+        m_RenderList.Add(node);
+      } else {
+        m_RenderList.Remove(node);
+      }
+      break;
+    case SceneNodeChange::Detached:
+      unindex_names(node);
+      remove_from_render_list(node);
+      break;
   }
+}
 
-  return closest;
+void Scene::OnNodeRenamed(SceneNode& node, const std::string& old_name)
+{
+  remove_name(old_name, node);
+  add_name(node.GetName(), node);
 }
 
 auto Scene::MakeUniqueName(const std::string& name) const -> std::string
@@ -157,7 +262,9 @@ auto Scene::MakeUniqueName(const std::string& name) const -> std::string
     return name;
   }
 
-  int suffix = 1;
+  // Resume after the last suffix handed out, so bulk-creating nodes with one
+  // base name does not rescan every earlier candidate
+  uint32_t& suffix = m_NameSuffixes.try_emplace(name, 1).first->second;
   std::string candidate;
   do {
     candidate = name + "_" + std::to_string(suffix);
@@ -170,13 +277,10 @@ auto Scene::MakeUniqueName(const std::string& name) const -> std::string
 auto Scene::GetPointLights() const -> std::vector<PointLightData>
 {
   std::vector<PointLightData> lights;
-  ForEachNode(
+  ForEachLightNode(
       [&lights](const SceneNode& node) -> void
       {
-        if (node.HasLight()
-            && node.GetLight()->LightType == LightComponent::Type::Point
-            && node.IsVisibleInHierarchy())
-        {
+        if (node.GetLight()->LightType == LightComponent::Type::Point) {
           const auto& lc = *node.GetLight();
           PointLightData data {};
           data.Position = node.GetWorldPosition();
@@ -192,12 +296,11 @@ auto Scene::GetPointLights() const -> std::vector<PointLightData>
 auto Scene::GetDirectionalLight() const -> std::optional<DirectionalLightData>
 {
   std::optional<DirectionalLightData> result;
-  ForEachNode(
+  ForEachLightNode(
       [&result](const SceneNode& node) -> void
       {
-        if (!result && node.HasLight()
-            && node.GetLight()->LightType == LightComponent::Type::Directional
-            && node.IsVisibleInHierarchy())
+        if (!result
+            && node.GetLight()->LightType == LightComponent::Type::Directional)
         {
           const auto& lc = *node.GetLight();
           DirectionalLightData data {};
@@ -210,11 +313,67 @@ auto Scene::GetDirectionalLight() const -> std::optional<DirectionalLightData>
   return result;
 }
 
-auto Scene::count_nodes(const SceneNode& node) const -> size_t
+auto Scene::spatial_index() const -> const SceneBVH&
+{
+  if (m_SpatialIndexDirty) {
+    m_BVH.Build(GetRenderableNodes());
+    m_SpatialIndexDirty = false;
+  }
+  return m_BVH;
+}
+
+void Scene::sync_render_list(SceneNode& node)
 {
-  size_t count = 1;
+  if (node.IsVisibleInHierarchy() && node.HasModel()) {
+    m_RenderList.Add(node);
+  } else {
+    m_RenderList.Remove(node);
+  }
+
   for (const auto& child : node.GetChildren()) {
-    count += count_nodes(*child);
+    sync_render_list(*child);
+  }
+}
+
+void Scene::remove_from_render_list(const SceneNode& node)
+{
+  m_RenderList.Remove(node);
+  for (const auto& child : node.GetChildren()) {
+    remove_from_render_list(*child);
+  }
+}
+
+void Scene::index_names(SceneNode& node)
+{
+  add_name(node.GetName(), node);
+  for (const auto& child : node.GetChildren()) {
+    index_names(*child);
+  }
+}
+
+void Scene::unindex_names(const SceneNode& node)
+{
+  remove_name(node.GetName(), node);
+  for (const auto& child : node.GetChildren()) {
+    unindex_names(*child);
+  }
+}
+
+void Scene::add_name(const std::string& name, SceneNode& node)
+{
+  m_NameIndex[name].push_back(&node);
+}
+
+void Scene::remove_name(const std::string& name, const SceneNode& node)
+{
+  const auto iter = m_NameIndex.find(name);
+  if (iter == m_NameIndex.end()) {
+    return;
+  }
+
+  auto& nodes = iter->second;
+  std::erase(nodes, &node);
+  if (nodes.empty()) {
+    m_NameIndex.erase(iter);
   }
-  return count;
 }
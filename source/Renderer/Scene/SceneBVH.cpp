@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+#include "Renderer/Scene/SceneBVH.hpp"
+
+#include "Renderer/Scene/SceneNode.hpp"
+
+namespace
+{
+
+constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+constexpr uint32_t MAX_LEAF_ITEMS = 4;
+constexpr size_t TRAVERSAL_STACK_SIZE = 64;
+
+auto AxisCenter(const AABB& bounds, int axis) -> float
+{
+  const linalg::Vec3 center = bounds.GetCenter();
+  switch (axis) {
+    case 1:
+      return center.y();
+    case 2:
+      return center.z();
+    default:
+      return center.x();
+  }
+}
+
+}  // namespace
+
+void SceneBVH::Build(std::span<SceneNode* const> nodes)
+{
+  Clear();
+
+  m_Items.reserve(nodes.size());
+  for (auto* node : nodes) {
+    const AABB bounds = node->GetWorldBounds();
+    if (bounds.IsValid()) {
+      m_Items.push_back({node, bounds, node->GetTransform().GetHandle()});
+    }
+  }
+
+  if (m_Items.empty()) {
+    return;
+  }
+
+  m_Nodes.reserve(2 * m_Items.size());
+  m_Nodes.resize(1);
+  m_ItemLeaves.resize(m_Items.size());
+  build_node(0, INVALID_INDEX, 0, static_cast<uint32_t>(m_Items.size()));
+  m_NodeQueued.assign(m_Nodes.size(), 0);
+
+  for (uint32_t i = 0; i < m_Items.size(); ++i) {
+    const TransformHandle handle = m_Items[i].Handle;
+    if (handle == kInvalidTransformHandle) {
+      continue;
+    }
+    if (handle >= m_HandleItems.size()) {
+      m_HandleItems.resize(handle + 1, INVALID_INDEX);
+    }
+    m_HandleItems[handle] = i;
+  }
+}
+
+void SceneBVH::Clear()
+{
+  m_Nodes.clear();
+  m_Items.clear();
+  m_ItemLeaves.clear();
+  m_HandleItems.clear();
+  m_NodeQueued.clear();
+  m_RefitQueue.clear();
+}
+
+void SceneBVH::MarkMoved(TransformHandle handle)
+{
+  if (handle >= m_HandleItems.size()) {
+    return;
+  }
+  const uint32_t item = m_HandleItems[handle];
+  if (item == INVALID_INDEX) {
+    return;
+  }
+
+  m_Items[item].Bounds = m_Items[item].Node->GetWorldBounds();
+
+  // Queue the leaf and its ancestors; stop at the first already queued one
+  for (uint32_t index = m_ItemLeaves[item];
+       index != INVALID_INDEX && m_NodeQueued[index] == 0;
+       index = m_Nodes[index].Parent)
+  {
+    m_NodeQueued[index] = 1;
+    m_RefitQueue.push_back(index);
+  }
+}
+
+void SceneBVH::Refit()
+{
+  // Children are always stored after their parent, so refitting in
+  // descending index order finishes every child before its parent
+  std::ranges::sort(m_RefitQueue, std::greater {});
+  for (const uint32_t index : m_RefitQueue) {
+    refit_node(index);
+    m_NodeQueued[index] = 0;
+  }
+  m_RefitQueue.clear();
+}
+
+auto SceneBVH::RayCast(const Ray& ray, float& t_hit) const -> SceneNode*
+{
+  SceneNode* closest = nullptr;
+  float closest_t = std::numeric_limits<float>::max();
+  if (m_Nodes.empty()) {
+    return nullptr;
+  }
+
+  std::vector<uint32_t> stack;
+  stack.reserve(TRAVERSAL_STACK_SIZE);
+  stack.push_back(0);
+  while (!stack.empty()) {
+    const Node& node = m_Nodes[stack.back()];
+    stack.pop_back();
+
+    float node_t = 0.0F;
+    if (!node.Bounds.Intersects(ray, node_t) || node_t >= closest_t) {
+      continue;
+    }
+
+    if (node.Count == 0) {
+      stack.push_back(node.First);
+      stack.push_back(node.First + 1);
+      continue;
+    }
+
+    for (uint32_t i = node.First; i < node.First + node.Count; ++i) {
+      float item_t = 0.0F;
+      if (m_Items[i].Bounds.Intersects(ray, item_t) && item_t < closest_t) {
+        closest_t = item_t;
+        closest = m_Items[i].Node;
+      }
+    }
+  }
+
+  if (closest != nullptr) {
+    t_hit = closest_t;
+  }
+  return closest;
+}
+
+void SceneBVH::QueryRay(const Ray& ray, std::vector<SceneNode*>& results) const
+{
+  query(
+      [&ray](const AABB& bounds) -> bool
+      {
+        float t_hit = 0.0F;
+        return bounds.Intersects(ray, t_hit);
+      },
+      results);
+}
+
+void SceneBVH::QueryAABB(const AABB& bounds,
+                         std::vector<SceneNode*>& results) const
+{
+  query([&bounds](const AABB& other) -> bool { return bounds.Overlaps(other); },
+        results);
+}
+
+void SceneBVH::QuerySphere(const BoundingSphere& sphere,
+                           std::vector<SceneNode*>& results) const
+{
+  query([&sphere](const AABB& bounds) -> bool
+        { return sphere.Overlaps(bounds); },
+        results);
+}
+
+auto SceneBVH::GetBounds() const -> AABB
+{
+  return m_Nodes.empty() ? AABB {} : m_Nodes.front().Bounds;
+}
+
+void SceneBVH::build_node(uint32_t index,
+                          uint32_t parent,
+                          uint32_t first,
+                          uint32_t count)
+{
+  AABB bounds;
+  AABB centroid_bounds;
+  for (uint32_t i = first; i < first + count; ++i) {
+    bounds.Expand(m_Items[i].Bounds);
+    centroid_bounds.Expand(m_Items[i].Bounds.GetCenter());
+  }
+  m_Nodes[index].Bounds = bounds;
+  m_Nodes[index].Parent = parent;
+
+  if (count <= MAX_LEAF_ITEMS) {
+    m_Nodes[index].First = first;
+    m_Nodes[index].Count = count;
+    for (uint32_t i = first; i < first + count; ++i) {
+      m_ItemLeaves[i] = index;
+    }
+    return;
+  }
+
+  // Median split along the longest centroid axis keeps the tree balanced
+  const linalg::Vec3 extent = centroid_bounds.GetSize();
+  int axis = 0;
+  if (extent.y() > extent.x()) {
+    axis = 1;
+  }
+  if (extent.z() > std::max(extent.x(), extent.y())) {
+    axis = 2;
+  }
+
+  const uint32_t half = count / 2;
+  auto begin = m_Items.begin() + first;
+  std::nth_element(begin,
+                   begin + half,
+                   begin + count,
+                   [axis](const Item& lhs, const Item& rhs) -> bool
+                   {
+                     return AxisCenter(lhs.Bounds, axis)
+                         < AxisCenter(rhs.Bounds, axis);
+                   });
+
+  // Siblings are allocated together, after their parent
+  const auto left = static_cast<uint32_t>(m_Nodes.size());
+  m_Nodes[index].First = left;
+  m_Nodes[index].Count = 0;
+  m_Nodes.resize(m_Nodes.size() + 2);
+
+  build_node(left, index, first, half);
+  build_node(left + 1, index, first + half, count - half);
+}
+
+void SceneBVH::refit_node(uint32_t index)
+{
+  Node& node = m_Nodes[index];
+  AABB bounds;
+  if (node.Count == 0) {
+    bounds.Expand(m_Nodes[node.First].Bounds);
+    bounds.Expand(m_Nodes[node.First + 1].Bounds);
+  } else {
+    for (uint32_t i = node.First; i < node.First + node.Count; ++i) {
+      bounds.Expand(m_Items[i].Bounds);
+    }
+  }
+  node.Bounds = bounds;
+}
+
+template<typename OverlapFn>
+void SceneBVH::query(OverlapFn&& overlaps,
+                     std::vector<SceneNode*>& results) const
+{
+  if (m_Nodes.empty()) {
+    return;
+  }
+
+  std::vector<uint32_t> stack;
+  stack.reserve(TRAVERSAL_STACK_SIZE);
+  stack.push_back(0);
+  while (!stack.empty()) {
+    const Node& node = m_Nodes[stack.back()];
+    stack.pop_back();
+
+    if (!overlaps(node.Bounds)) {
+      continue;
+    }
+
+    if (node.Count == 0) {
+      stack.push_back(node.First);
+      stack.push_back(node.First + 1);
+      continue;
+    }
+
+    for (uint32_t i = node.First; i < node.First + node.Count; ++i) {
+      if (overlaps(m_Items[i].Bounds)) {
+        results.push_back(m_Items[i].Node);
+      }
+    }
+  }
+}
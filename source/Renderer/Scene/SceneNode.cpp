@@ -1,8 +1,10 @@
 #include <algorithm>
+#include <utility>
 
 #include "Renderer/Scene/SceneNode.hpp"
 
 #include "Renderer/Model/Model.hpp"
+#include "Renderer/Scene/Scene.hpp"
 
 SceneNode::SceneNode(std::string name)
     : m_Name(std::move(name))
@@ -21,7 +23,9 @@ auto SceneNode::AddChild(std::unique_ptr<SceneNode> child) -> SceneNode*
   }
 
   child->set_parent(this);
+  child->SetScene(m_Scene);
   m_Children.push_back(std::move(child));
+  m_Children.back()->notify_scene(SceneNodeChange::Attached);
   return m_Children.back().get();
 }
 
@@ -41,6 +45,7 @@ void SceneNode::RemoveChild(SceneNode* child)
                                    { return ptr.get() == child; });
 
   if (iter != m_Children.end()) {
+    (*iter)->notify_scene(SceneNodeChange::Detached);
     (*iter)->set_parent(nullptr);
     m_Children.erase(iter);
   }
@@ -56,6 +61,7 @@ void SceneNode::RemoveFromParent()
 void SceneNode::ClearChildren()
 {
   for (auto& child : m_Children) {
+    child->notify_scene(SceneNodeChange::Detached);
     child->set_parent(nullptr);
   }
   m_Children.clear();
@@ -155,6 +161,7 @@ auto SceneNode::GetWorldPosition() const -> linalg::Vec3
 void SceneNode::SetModel(std::shared_ptr<Model> model)
 {
   m_Model = std::move(model);
+  notify_scene(SceneNodeChange::ModelChanged);
 }
 
 auto SceneNode::GetModel() const -> std::shared_ptr<Model>
@@ -199,7 +206,14 @@ auto SceneNode::HasLight() const -> bool
 
 void SceneNode::SetName(const std::string& name)
 {
-  m_Name = name;
+  if (m_Name == name) {
+    return;
+  }
+
+  std::string old_name = std::exchange(m_Name, name);
+  if (m_Scene != nullptr) {
+    m_Scene->OnNodeRenamed(*this, old_name);
+  }
 }
 
 auto SceneNode::GetName() const -> const std::string&
@@ -209,7 +223,12 @@ auto SceneNode::GetName() const -> const std::string&
 
 void SceneNode::SetVisible(bool visible)
 {
+  if (m_Visible == visible) {
+    return;
+  }
   m_Visible = visible;
+  update_hierarchy_visibility();
+  notify_scene(SceneNodeChange::VisibilityChanged);
 }
 
 auto SceneNode::IsVisible() const -> bool
@@ -219,13 +238,7 @@ auto SceneNode::IsVisible() const -> bool
 
 auto SceneNode::IsVisibleInHierarchy() const -> bool
 {
-  if (!m_Visible) {
-    return false;
-  }
-  if (m_Parent != nullptr) {
-    return m_Parent->IsVisibleInHierarchy();
-  }
-  return true;
+  return m_VisibleInHierarchy;
 }
 
 void SceneNode::SetEnabled(bool enabled)
@@ -254,12 +267,55 @@ auto SceneNode::GetWorldBounds() const -> AABB
 
 void SceneNode::UpdateTransforms()
 {
-  // Update this node's transform
+  update_transforms(false);
+}
+
+void SceneNode::SetScene(Scene* scene)
+{
+  m_Scene = scene;
+  m_Transform.Bind((scene != nullptr) ? &scene->GetTransformStore() : nullptr);
+  for (auto& child : m_Children) {
+    child->SetScene(scene);
+  }
+}
+
+auto SceneNode::GetScene() const -> Scene*
+{
+  return m_Scene;
+}
+
+void SceneNode::update_transforms(bool parent_changed)
+{
+  // A moved ancestor invalidates this world matrix even if the node is clean
+  const bool changed = parent_changed || m_Transform.IsWorldDirty();
+  if (changed) {
+    m_Transform.MarkWorldDirty();
+  }
   m_Transform.UpdateMatrices();
 
-  // Recursively update children
   for (auto& child : m_Children) {
-    child->UpdateTransforms();
+    child->update_transforms(changed);
+  }
+}
+
+void SceneNode::notify_scene(SceneNodeChange change)
+{
+  if (m_Scene != nullptr) {
+    m_Scene->OnNodeChanged(*this, change);
+  }
+}
+
+void SceneNode::update_hierarchy_visibility()
+{
+  const bool parent_visible =
+      (m_Parent == nullptr) || m_Parent->m_VisibleInHierarchy;
+  m_VisibleInHierarchy = parent_visible && m_Visible;
+  for (auto& child : m_Children) {
+    // Subtrees whose effective visibility did not change are left alone
+    const bool child_visible = m_VisibleInHierarchy && child->m_Visible;
+    if (child->m_VisibleInHierarchy != child_visible) {
+      child->update_hierarchy_visibility();
+    }
   }
 }
 
@@ -271,4 +327,5 @@ void SceneNode::set_parent(SceneNode* parent)
   } else {
     m_Transform.SetParent(nullptr);
   }
+  update_hierarchy_visibility();
 }
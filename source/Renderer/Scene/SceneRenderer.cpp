@@ -1,6 +1,12 @@
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+
 #include "Renderer/Scene/SceneRenderer.hpp"
 
 #include "Core/Logger.hpp"
+#include "Renderer/DrawQueue.hpp"
 #include "Renderer/Camera.hpp"
 #include "Renderer/Model/Material.hpp"
 #include "Renderer/Model/Mesh.hpp"
@@ -12,10 +18,44 @@
 #include "Renderer/RHI/RHIDevice.hpp"
 #include "Renderer/RHI/RHIPipeline.hpp"
 #include "Renderer/RHI/RHIShaderModule.hpp"
+#include "Renderer/Scene/RenderList.hpp"
 #include "Renderer/Scene/Scene.hpp"
 #include "Renderer/Scene/SceneNode.hpp"
+#include "Renderer/UploadRing.hpp"
 #include "linalg/projection.hpp"
 
+namespace
+{
+
+// Groups of fewer nodes are drawn one by one
+constexpr size_t MIN_INSTANCES = 2;
+
+auto MakeNodeUBO(const SceneNode& node) -> NodeUBO
+{
+  NodeUBO data {};
+  data.Model = node.GetTransform().GetWorldMatrix();
+  const auto normal_mat = node.GetTransform().GetNormalMatrix();
+  data.NormalMatrix = linalg::Mat4 {normal_mat(0, 0),
+                                    normal_mat(0, 1),
+                                    normal_mat(0, 2),
+                                    0.0F,
+                                    normal_mat(1, 0),
+                                    normal_mat(1, 1),
+                                    normal_mat(1, 2),
+                                    0.0F,
+                                    normal_mat(2, 0),
+                                    normal_mat(2, 1),
+                                    normal_mat(2, 2),
+                                    0.0F,
+                                    0.0F,
+                                    0.0F,
+                                    0.0F,
+                                    1.0F};
+  return data;
+}
+
+}  // namespace
+
 SceneRenderer::SceneRenderer(RHIDevice& device, RenderAPI api,
                              const std::string& shader_path)
     : m_Device(device)
@@ -32,8 +72,15 @@ SceneRenderer::~SceneRenderer() = default;
 
 void SceneRenderer::BeginFrame(const Camera& camera)
 {
+  m_FrameIndex = m_Device.GetFrameIndex()
+      % static_cast<uint32_t>(m_CameraDescriptorSets.size());
   update_camera_ubo(camera);
-  m_NodeDynamicOffset = 0;
+  m_NodeRing->BeginFrame();
+  m_IndirectRing->BeginFrame();
+  m_Frustum = Frustum::FromMatrix(camera.GetViewProjectionMatrix());
+  m_CullStats = {};
+  m_BindStats = {};
+  m_CameraPosition = camera.GetPosition();
 }
 
 void SceneRenderer::SetWireframe(bool wireframe)
@@ -41,6 +88,51 @@ void SceneRenderer::SetWireframe(bool wireframe)
   m_Wireframe = wireframe;
 }
 
+void SceneRenderer::SetInstancing(bool enabled)
+{
+  m_Instancing = enabled;
+}
+
+auto SceneRenderer::IsInstancing() const -> bool
+{
+  return m_Instancing;
+}
+
+void SceneRenderer::SetIndirectDraws(bool enabled)
+{
+  m_IndirectDraws = enabled;
+}
+
+auto SceneRenderer::IsIndirectDraws() const -> bool
+{
+  return m_IndirectDraws;
+}
+
+void SceneRenderer::SetFrustumCulling(bool enabled)
+{
+  m_FrustumCulling = enabled;
+}
+
+auto SceneRenderer::IsFrustumCulling() const -> bool
+{
+  return m_FrustumCulling;
+}
+
+auto SceneRenderer::GetCullStats() const -> const CullStats&
+{
+  return m_CullStats;
+}
+
+auto SceneRenderer::GetBindStats() const -> const BindStats&
+{
+  return m_BindStats;
+}
+
+auto SceneRenderer::GetUploadRing() -> UploadRing&
+{
+  return *m_NodeRing;
+}
+
 void SceneRenderer::RenderScene(RHICommandBuffer& cmd, const Scene& scene)
 {
   cmd.SetPrimitiveTopology(PrimitiveTopology::TriangleList);
@@ -50,82 +142,340 @@ void SceneRenderer::RenderScene(RHICommandBuffer& cmd, const Scene& scene)
   cmd.SetVertexInput(Vertex::GetLayout());
 
   cmd.BindDescriptorSet(m_ReflectedLayout.GetSetIndex("camera"),
-                        *m_CameraDescriptorSet,
+                        *m_CameraDescriptorSets[m_FrameIndex],
                         *m_PipelineLayout);
 
-  auto renderable_nodes = scene.GetRenderableNodes();
-  for (auto* node : renderable_nodes) {
-    RenderNode(cmd, *node);
+  const auto render_list = scene.GetRenderList();
+  m_CullStats.NodesTested += static_cast<uint32_t>(render_list.size());
+  m_DrawQueue.Clear();
+  m_InstanceData.clear();
+
+  // Cull every node before recording any draw. The scratch arrays keep
+  // their capacity, so steady-state frames do not allocate.
+  m_VisibleItems.clear();
+  if (!m_FrustumCulling) {
+    for (const auto& item : render_list) {
+      m_VisibleItems.push_back(&item);
+    }
+  } else {
+    m_CullBounds.clear();
+    for (const auto& item : render_list) {
+      m_CullBounds.push_back(item.Bounds);
+    }
+    m_CullVisible.resize(m_CullBounds.size());
+    m_Frustum.CullAABBs(m_CullBounds, m_CullVisible);
+
+    for (size_t i = 0; i < render_list.size(); ++i) {
+      if (m_CullVisible[i] != 0) {
+        m_VisibleItems.push_back(&render_list[i]);
+      }
+    }
   }
+  m_CullStats.NodesVisible += static_cast<uint32_t>(m_VisibleItems.size());
 
+  if (!m_Instancing) {
+    for (const auto* item : m_VisibleItems) {
+      collect_node(*item->Node);
+    }
+  } else {
+    // Bring nodes sharing a model together, then instance each large group
+    std::ranges::sort(m_VisibleItems,
+                      [](const RenderItem* lhs, const RenderItem* rhs) -> bool
+                      { return std::less<> {}(lhs->Asset, rhs->Asset); });
+
+    size_t first = 0;
+    while (first < m_VisibleItems.size()) {
+      const Model* model = m_VisibleItems[first]->Asset;
+      size_t last = first + 1;
+      while (last < m_VisibleItems.size()
+             && m_VisibleItems[last]->Asset == model)
+      {
+        ++last;
+      }
+
+      if (last - first < MIN_INSTANCES) {
+        for (size_t i = first; i < last; ++i) {
+          collect_node(*m_VisibleItems[i]->Node);
+        }
+      } else {
+        m_InstanceNodes.clear();
+        for (size_t i = first; i < last; ++i) {
+          m_InstanceNodes.push_back(m_VisibleItems[i]->Node);
+        }
+        collect_instances(*model, m_InstanceNodes);
+      }
+      first = last;
+    }
+  }
+
+  submit_draws(cmd);
   cmd.SetPolygonMode(PolygonMode::Fill);
 }
 
 void SceneRenderer::RenderNode(RHICommandBuffer& cmd, const SceneNode& node)
+{
+  m_DrawQueue.Clear();
+  m_InstanceData.clear();
+  collect_node(node);
+  submit_draws(cmd);
+}
+
+void SceneRenderer::collect_node(const SceneNode& node)
 {
   auto model = node.GetModel();
   if (!model || !model->AreResourcesCreated()) {
     return;
   }
 
-  NodeUBO data {};
-  data.Model = node.GetTransform().GetWorldMatrix();
-  const auto normal_mat = node.GetTransform().GetNormalMatrix();
-  data.NormalMatrix = linalg::Mat4 {normal_mat(0, 0),
-                                    normal_mat(0, 1),
-                                    normal_mat(0, 2),
-                                    0.0F,
-                                    normal_mat(1, 0),
-                                    normal_mat(1, 1),
-                                    normal_mat(1, 2),
-                                    0.0F,
-                                    normal_mat(2, 0),
-                                    normal_mat(2, 1),
-                                    normal_mat(2, 2),
-                                    0.0F,
-                                    0.0F,
-                                    0.0F,
-                                    0.0F,
-                                    1.0F};
+  const auto first_instance = static_cast<uint32_t>(m_InstanceData.size());
+  m_InstanceData.push_back(MakeNodeUBO(node));
 
-  m_NodeDynamicBuffer->Upload(&data, sizeof(NodeUBO), m_NodeDynamicOffset);
+  const linalg::Mat4& world = node.GetTransform().GetWorldMatrix();
+  queue_draws(*model, first_instance, 1, node_depth(world), &world);
+}
 
-  uint32_t offsets[] = {m_NodeDynamicOffset};
-  cmd.BindDescriptorSet(
-      m_NodeSetIndex, *m_NodeDescriptorSet, *m_PipelineLayout, offsets);
+void SceneRenderer::collect_instances(const Model& model,
+                                      std::span<SceneNode* const> nodes)
+{
+  if (!model.AreResourcesCreated()) {
+    return;
+  }
 
-  m_NodeDynamicOffset =
-      (m_NodeDynamicOffset + sizeof(NodeUBO) + m_NodeAlignment - 1)
-      & ~(m_NodeAlignment - 1);
+  for (size_t first = 0; first < nodes.size(); first += MAX_INSTANCES) {
+    const auto batch = nodes.subspan(
+        first, std::min<size_t>(MAX_INSTANCES, nodes.size() - first));
+
+    const auto first_instance = static_cast<uint32_t>(m_InstanceData.size());
+    float depth = std::numeric_limits<float>::max();
+    for (const auto* node : batch) {
+      m_InstanceData.push_back(MakeNodeUBO(*node));
+      depth = std::min(depth,
+                       node_depth(node->GetTransform().GetWorldMatrix()));
+    }
 
-  for (size_t mesh_idx = 0; mesh_idx < model->GetMeshCount(); ++mesh_idx) {
-    auto* mesh = model->GetMesh(mesh_idx);
+    queue_draws(model,
+                first_instance,
+                static_cast<uint32_t>(batch.size()),
+                depth,
+                nullptr);
+    ++m_CullStats.InstancedBatches;
+  }
+}
+
+void SceneRenderer::queue_draws(const Model& model,
+                                uint32_t first_instance,
+                                uint32_t instance_count,
+                                float depth,
+                                const linalg::Mat4* world)
+{
+  // Recorded node by node, every instance would bind its own state
+  m_BindStats.SceneOrder.Nodes += instance_count;
+
+  // A single draw was already covered by the node test
+  size_t draw_count = 0;
+  for (const auto& mesh : model.GetMeshes()) {
+    draw_count += mesh->GetSubMeshCount();
+  }
+  const bool cull_submeshes =
+      m_FrustumCulling && world != nullptr && draw_count > 1;
+
+  for (size_t mesh_idx = 0; mesh_idx < model.GetMeshCount(); ++mesh_idx) {
+    auto* mesh = model.GetMesh(mesh_idx);
     if (mesh == nullptr) {
       continue;
     }
 
-    cmd.BindVertexBuffer(*mesh->GetVertexBuffer(), 0);
-    cmd.BindIndexBuffer(*mesh->GetIndexBuffer());
+    m_BindStats.SceneOrder.VertexBuffers += instance_count;
+    m_BindStats.SceneOrder.IndexBuffers += instance_count;
 
     for (size_t submesh_idx = 0; submesh_idx < mesh->GetSubMeshCount();
          ++submesh_idx)
     {
       const auto& submesh = mesh->GetSubMesh(submesh_idx);
 
-      auto* material = model->GetMaterial(submesh.MaterialIndex);
-      if (material != nullptr && material->GetDescriptorSet() != nullptr) {
-        cmd.BindDescriptorSet(m_ReflectedLayout.GetSetIndex("material"),
-                              *material->GetDescriptorSet(),
-                              *m_PipelineLayout);
+      if (cull_submeshes) {
+        ++m_CullStats.SubMeshesTested;
+        if (!m_Frustum.Intersects(submesh.LocalBounds.Transform(*world))) {
+          ++m_CullStats.SubMeshesCulled;
+          continue;
+        }
+      }
+
+      const auto* material = model.GetMaterial(submesh.MaterialIndex);
+      DrawPass pass = DrawPass::Opaque;
+      uint64_t material_id = 0;
+      if (material != nullptr) {
+        if (material->GetDescriptorSet() != nullptr) {
+          m_BindStats.SceneOrder.Materials += instance_count;
+        }
+        if (material->IsTransparent()) {
+          pass = DrawPass::Transparent;
+        } else if (material->GetAlphaMode() == AlphaMode::Mask) {
+          pass = DrawPass::Masked;
+        }
+        material_id = material->GetId();
+      }
+
+      DrawPacket packet {};
+      packet.SortKey =
+          DrawQueue::MakeSortKey(pass, material_id, mesh->GetId(), depth);
+      packet.MeshRef = mesh;
+      packet.SubMeshRef = &submesh;
+      packet.MaterialRef = material;
+      packet.FirstInstance = first_instance;
+      packet.InstanceCount = instance_count;
+      m_DrawQueue.Add(packet);
+    }
+  }
+}
+
+auto SceneRenderer::node_depth(const linalg::Mat4& world) const -> float
+{
+  // Squared distance to the node origin is enough to order draws by depth
+  const linalg::Vec3 delta =
+      linalg::Vec3 {world(0, 3), world(1, 3), world(2, 3)} - m_CameraPosition;
+  return linalg::dot(delta, delta);
+}
+
+void SceneRenderer::submit_draws(RHICommandBuffer& cmd)
+{
+  m_DrawQueue.Sort();
+  const auto packets = m_DrawQueue.GetPackets();
+  if (packets.empty()) {
+    return;
+  }
+
+  const uint32_t material_set_index = m_ReflectedLayout.GetSetIndex("material");
+  const RHIBuffer* bound_vertices = nullptr;
+  const RHIBuffer* bound_indices = nullptr;
+  const RHIDescriptorSet* bound_material = nullptr;
+
+  // Node data is streamed into windows of MAX_INSTANCES entries in draw
+  // order; a draw reads its entries at first_instance within the window
+  UploadAllocation window {};
+  NodeUBO* window_data = nullptr;
+  uint32_t window_used = MAX_INSTANCES;
+  uint32_t placed_instance = std::numeric_limits<uint32_t>::max();
+  uint32_t placed_slot = 0;
+
+  // With indirect draws, commands sharing all bindings form one call. Where
+  // indirect commands cannot start at a nonzero instance, draws placed past
+  // the start of their window are recorded directly instead.
+  const bool indirect_first_instance = m_Device.SupportsIndirectFirstInstance();
+  UploadAllocation args {};
+  DrawIndexedIndirectCommand* commands = nullptr;
+  uint32_t command_count = 0;
+  uint32_t batch_start = 0;
+  if (m_IndirectDraws) {
+    args = m_IndirectRing->Allocate(
+        packets.size() * sizeof(DrawIndexedIndirectCommand),
+        alignof(DrawIndexedIndirectCommand));
+    commands = reinterpret_cast<DrawIndexedIndirectCommand*>(
+        static_cast<std::byte*>(args.Buffer->Map()) + args.Offset);
+  }
+
+  auto flush_batch = [&]() -> void
+  {
+    if (command_count == batch_start) {
+      return;
+    }
+    cmd.DrawIndexedIndirect(
+        *args.Buffer,
+        args.Offset + batch_start * sizeof(DrawIndexedIndirectCommand),
+        command_count - batch_start);
+    ++m_CullStats.DrawCalls;
+    batch_start = command_count;
+  };
+
+  auto close_window = [&]() -> void
+  {
+    if (window_data != nullptr) {
+      window.Buffer->Flush(window.Offset, window_used * sizeof(NodeUBO));
+    }
+  };
+
+  for (const auto& packet : packets) {
+    // Submeshes of one node share its entries when drawn back to back
+    if (packet.FirstInstance != placed_instance) {
+      if (window_used + packet.InstanceCount > MAX_INSTANCES) {
+        flush_batch();
+        close_window();
+
+        window = m_NodeRing->Allocate(NODE_BINDING_RANGE, m_NodeAlignment);
+        window_data = reinterpret_cast<NodeUBO*>(
+            static_cast<std::byte*>(window.Buffer->Map()) + window.Offset);
+        window_used = 0;
+
+        uint32_t offsets[] = {static_cast<uint32_t>(window.Offset)};
+        cmd.BindDescriptorSet(m_NodeSetIndex,
+                              node_descriptor_set(*window.Buffer),
+                              *m_PipelineLayout,
+                              offsets);
+        ++m_BindStats.Sorted.Nodes;
       }
 
+      std::copy_n(&m_InstanceData[packet.FirstInstance],
+                  packet.InstanceCount,
+                  window_data + window_used);
+      placed_instance = packet.FirstInstance;
+      placed_slot = window_used;
+      window_used += packet.InstanceCount;
+    }
+
+    RHIBuffer* vertices = packet.MeshRef->GetVertexBuffer();
+    if (vertices != bound_vertices) {
+      flush_batch();
+      cmd.BindVertexBuffer(*vertices, 0);
+      bound_vertices = vertices;
+      ++m_BindStats.Sorted.VertexBuffers;
+    }
+
+    RHIBuffer* indices = packet.MeshRef->GetIndexBuffer();
+    if (indices != bound_indices) {
+      flush_batch();
+      cmd.BindIndexBuffer(*indices);
+      bound_indices = indices;
+      ++m_BindStats.Sorted.IndexBuffers;
+    }
+
+    RHIDescriptorSet* material_set = (packet.MaterialRef != nullptr)
+        ? packet.MaterialRef->GetDescriptorSet()
+        : nullptr;
+    if (material_set != nullptr && material_set != bound_material) {
+      flush_batch();
+      cmd.BindDescriptorSet(
+          material_set_index, *material_set, *m_PipelineLayout);
+      bound_material = material_set;
+      ++m_BindStats.Sorted.Materials;
+    }
+
+    const SubMesh& submesh = *packet.SubMeshRef;
+    if (m_IndirectDraws && (placed_slot == 0 || indirect_first_instance)) {
+      commands[command_count++] = {
+          submesh.IndexCount,
+          packet.InstanceCount,
+          submesh.IndexOffset,
+          static_cast<int32_t>(submesh.VertexOffset),
+          placed_slot,
+      };
+      ++m_CullStats.IndirectCommands;
+    } else {
+      flush_batch();
       cmd.DrawIndexed(submesh.IndexCount,
-                      1,
+                      packet.InstanceCount,
                       submesh.IndexOffset,
                       static_cast<int32_t>(submesh.VertexOffset),
-                      0);
+                      placed_slot);
+      ++m_CullStats.DrawCalls;
     }
   }
+
+  flush_batch();
+  close_window();
+  if (m_IndirectDraws) {
+    args.Buffer->Flush(args.Offset,
+                       command_count * sizeof(DrawIndexedIndirectCommand));
+  }
 }
 
 auto SceneRenderer::GetSetLayout(const std::string& parameter_name) const
@@ -182,24 +532,34 @@ void SceneRenderer::create_camera_resources()
   camera_buffer_desc.Size = sizeof(CameraUBO);
   camera_buffer_desc.Usage = BufferUsage::Uniform;
   camera_buffer_desc.CPUVisible = true;
-  m_CameraUBO = m_Device.CreateBuffer(camera_buffer_desc);
+  camera_buffer_desc.PersistentMap = true;
 
   auto camera_layout = m_ReflectedLayout.GetSetLayout("camera");
-  m_CameraDescriptorSet = m_Device.CreateDescriptorSet(camera_layout);
-  m_CameraDescriptorSet->WriteBuffer(
-      0, m_CameraUBO.get(), 0, sizeof(CameraUBO));
-
-  BufferDesc node_desc {};
-  node_desc.Size = 1024 * static_cast<size_t>(m_NodeAlignment);
-  node_desc.Usage = BufferUsage::Uniform;
-  node_desc.CPUVisible = true;
-  m_NodeDynamicBuffer = m_Device.CreateBuffer(node_desc);
+  for (uint32_t i = 0; i < m_Device.GetFramesInFlight(); ++i) {
+    auto& buffer =
+        m_CameraUBOs.emplace_back(m_Device.CreateBuffer(camera_buffer_desc));
+    auto& set = m_CameraDescriptorSets.emplace_back(
+        m_Device.CreateDescriptorSet(camera_layout));
+    set->WriteBuffer(0, buffer.get(), 0, sizeof(CameraUBO));
+  }
 
   m_NodeSetIndex = m_ReflectedLayout.GetSetIndex("node");
-  auto node_layout = m_ReflectedLayout.GetSetLayout("node");
-  m_NodeDescriptorSet = m_Device.CreateDescriptorSet(node_layout);
-  m_NodeDescriptorSet->WriteBuffer(
-      0, m_NodeDynamicBuffer.get(), 0, sizeof(NodeUBO));
+  m_NodeRing = std::make_unique<UploadRing>(m_Device,
+                                            BufferUsage::Uniform,
+                                            UploadRing::DEFAULT_PAGE_SIZE,
+                                            NODE_BINDING_RANGE);
+  m_IndirectRing =
+      std::make_unique<UploadRing>(m_Device, BufferUsage::Indirect);
+}
+
+auto SceneRenderer::node_descriptor_set(RHIBuffer& page) -> RHIDescriptorSet&
+{
+  auto& set = m_NodeDescriptorSets[&page];
+  if (!set) {
+    set = m_Device.CreateDescriptorSet(m_ReflectedLayout.GetSetLayout("node"));
+    set->WriteBuffer(0, &page, 0, NODE_BINDING_RANGE);
+  }
+  return *set;
 }
 
 void SceneRenderer::update_camera_ubo(const Camera& camera)
@@ -211,5 +571,5 @@ void SceneRenderer::update_camera_ubo(const Camera& camera)
   data.InverseViewProjection = linalg::inverse(data.ViewProjection);
   data.CameraPosition = linalg::Vec4(camera.GetPosition(), 1.0F);
 
-  m_CameraUBO->Upload(&data, sizeof(CameraUBO), 0);
+  m_CameraUBOs[m_FrameIndex]->Upload(&data, sizeof(CameraUBO), 0);
 }
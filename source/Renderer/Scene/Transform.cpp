@@ -5,66 +5,101 @@
 #include <linalg/transform.hpp>
 #include <linalg/utility.hpp>
 
+Transform::~Transform()
+{
+  if (m_Store != nullptr) {
+    m_Store->Free(m_Handle);
+  }
+}
+
+Transform::Transform(const Transform& other)
+    : m_Position(other.position())
+    , m_Rotation(other.rotation())
+    , m_Scale(other.scale())
+{
+}
+
+Transform::Transform(Transform&& other) noexcept
+    : Transform(static_cast<const Transform&>(other))
+{
+}
+
+auto Transform::operator=(const Transform& other) -> Transform&
+{
+  if (this != &other) {
+    position() = other.position();
+    rotation() = other.rotation();
+    scale() = other.scale();
+    MarkDirty();
+  }
+  return *this;
+}
+
+auto Transform::operator=(Transform&& other) noexcept -> Transform&
+{
+  return *this = static_cast<const Transform&>(other);
+}
+
 void Transform::SetPosition(const linalg::Vec3& position)
 {
-  m_Position = position;
+  this->position() = position;
   MarkDirty();
 }
 
 void Transform::SetRotation(const linalg::Quat& rotation)
 {
-  m_Rotation = linalg::normalized(rotation);
+  this->rotation() = linalg::normalized(rotation);
   MarkDirty();
 }
 
 void Transform::SetRotationEuler(const linalg::Vec3& euler_degrees)
 {
   const linalg::Vec3 radians = linalg::radians(euler_degrees);
-  m_Rotation = linalg::quat_from_euler(radians);
+  rotation() = linalg::quat_from_euler(radians);
   MarkDirty();
 }
 
 void Transform::SetScale(const linalg::Vec3& scale)
 {
-  m_Scale = scale;
+  this->scale() = scale;
   MarkDirty();
 }
 
 void Transform::SetScale(float uniform_scale)
 {
-  m_Scale = linalg::Vec3{uniform_scale, uniform_scale, uniform_scale};
+  scale() = linalg::Vec3{uniform_scale, uniform_scale, uniform_scale};
   MarkDirty();
 }
 
 auto Transform::GetPosition() const -> const linalg::Vec3&
 {
-  return m_Position;
+  return position();
 }
 
 auto Transform::GetRotation() const -> const linalg::Quat&
 {
-  return m_Rotation;
+  return rotation();
 }
 
 auto Transform::GetRotationEuler() const -> linalg::Vec3
 {
-  return linalg::degrees(linalg::euler_angles(m_Rotation));
+  return linalg::degrees(linalg::euler_angles(rotation()));
 }
 
 auto Transform::GetScale() const -> const linalg::Vec3&
 {
-  return m_Scale;
+  return scale();
 }
 
 void Transform::Translate(const linalg::Vec3& delta)
 {
-  m_Position += delta;
+  position() += delta;
   MarkDirty();
 }
 
 void Transform::Rotate(const linalg::Quat& delta)
 {
-  m_Rotation = linalg::normalized(delta * m_Rotation);
+  rotation() = linalg::normalized(delta * rotation());
   MarkDirty();
 }
 
@@ -76,66 +111,64 @@ void Transform::RotateEuler(const linalg::Vec3& euler_degrees)
 
 void Transform::ScaleBy(const linalg::Vec3& factor)
 {
-  m_Scale *= factor;
+  scale() *= factor;
   MarkDirty();
 }
 
 void Transform::ScaleBy(float uniform_factor)
 {
-  m_Scale *= uniform_factor;
+  scale() *= uniform_factor;
   MarkDirty();
 }
 
 auto Transform::GetForward() const -> linalg::Vec3
 {
-  return linalg::normalized(linalg::transform(linalg::Vec3{0.0F, 0.0F, -1.0F}, m_Rotation));
+  return linalg::normalized(linalg::transform(linalg::Vec3{0.0F, 0.0F, -1.0F}, rotation()));
 }
 
 auto Transform::GetRight() const -> linalg::Vec3
 {
-  return linalg::normalized(linalg::transform(linalg::Vec3{1.0F, 0.0F, 0.0F}, m_Rotation));
+  return linalg::normalized(linalg::transform(linalg::Vec3{1.0F, 0.0F, 0.0F}, rotation()));
 }
 
 auto Transform::GetUp() const -> linalg::Vec3
 {
-  return linalg::normalized(linalg::transform(linalg::Vec3{0.0F, 1.0F, 0.0F}, m_Rotation));
+  return linalg::normalized(linalg::transform(linalg::Vec3{0.0F, 1.0F, 0.0F}, rotation()));
 }
 
 auto Transform::GetLocalMatrix() const -> const linalg::Mat4&
 {
-  return m_LocalMatrix;
+  return (m_Store != nullptr) ? m_Store->LocalMatrix(m_Handle) : m_LocalMatrix;
 }
 
 auto Transform::GetWorldMatrix() const -> const linalg::Mat4&
 {
-  return m_WorldMatrix;
+  return world_matrix();
 }
 
 auto Transform::GetNormalMatrix() const -> linalg::Mat3
 {
+  const linalg::Mat4& world = world_matrix();
   const linalg::Mat3 upper3x3{
-      m_WorldMatrix(0, 0), m_WorldMatrix(0, 1), m_WorldMatrix(0, 2),
-      m_WorldMatrix(1, 0), m_WorldMatrix(1, 1), m_WorldMatrix(1, 2),
-      m_WorldMatrix(2, 0), m_WorldMatrix(2, 1), m_WorldMatrix(2, 2)};
+      world(0, 0), world(0, 1), world(0, 2),
+      world(1, 0), world(1, 1), world(1, 2),
+      world(2, 0), world(2, 1), world(2, 2)};
   return linalg::transpose(linalg::inverse(upper3x3));
 }
 
 void Transform::UpdateLocalMatrix()
 {
-  if (!m_LocalDirty) {
+  if (!IsLocalDirty()) {
     return;
   }
 
-  m_LocalMatrix = linalg::Mat4::identity();
-  m_LocalMatrix = m_LocalMatrix * static_cast<linalg::Mat4>(linalg::make_translation(m_Position));
-  m_LocalMatrix = m_LocalMatrix * m_Rotation.to_mat4();
-  m_LocalMatrix = m_LocalMatrix * static_cast<linalg::Mat4>(linalg::make_scale(m_Scale));
-  m_LocalDirty = false;
+  local_matrix() = ComposeMatrix(position(), rotation(), scale());
+  set_dirty(false, IsWorldDirty());
 }
 
 void Transform::UpdateWorldMatrix()
 {
-  if (!m_WorldDirty) {
+  if (!IsWorldDirty()) {
     return;
   }
 
@@ -143,12 +176,12 @@ void Transform::UpdateWorldMatrix()
   UpdateLocalMatrix();
 
   if (m_Parent != nullptr) {
-    m_WorldMatrix = m_Parent->GetWorldMatrix() * m_LocalMatrix;
+    world_matrix() = m_Parent->GetWorldMatrix() * GetLocalMatrix();
   } else {
-    m_WorldMatrix = m_LocalMatrix;
+    world_matrix() = GetLocalMatrix();
   }
 
-  m_WorldDirty = false;
+  set_dirty(false, false);
 }
 
 void Transform::UpdateMatrices()
@@ -160,7 +193,12 @@ void Transform::UpdateMatrices()
 void Transform::SetParent(Transform* parent)
 {
   m_Parent = parent;
-  m_WorldDirty = true;
+  if (m_Store != nullptr) {
+    const bool same_store = parent != nullptr && parent->m_Store == m_Store;
+    m_Store->SetParent(m_Handle,
+                       same_store ? parent->m_Handle : kInvalidTransformHandle);
+  }
+  MarkWorldDirty();
 }
 
 auto Transform::GetParent() const -> Transform*
@@ -170,23 +208,27 @@ auto Transform::GetParent() const -> Transform*
 
 void Transform::MarkDirty()
 {
-  m_LocalDirty = true;
-  m_WorldDirty = true;
+  set_dirty(true, true);
+}
+
+void Transform::MarkWorldDirty()
+{
+  set_dirty(IsLocalDirty(), true);
 }
 
 auto Transform::IsLocalDirty() const -> bool
 {
-  return m_LocalDirty;
+  return (m_Store != nullptr) ? m_Store->IsLocalDirty(m_Handle) : m_LocalDirty;
 }
 
 auto Transform::IsWorldDirty() const -> bool
 {
-  return m_WorldDirty;
+  return (m_Store != nullptr) ? m_Store->IsWorldDirty(m_Handle) : m_WorldDirty;
 }
 
 void Transform::LookAt(const linalg::Vec3& target, const linalg::Vec3& v_up)
 {
-  const linalg::Vec3 direction = linalg::normalized(target - m_Position);
+  const linalg::Vec3 direction = linalg::normalized(target - position());
 
   // Calculate rotation to face the target
   const linalg::Vec3 right = linalg::normalized(linalg::cross(v_up, direction));
@@ -196,7 +238,7 @@ void Transform::LookAt(const linalg::Vec3& target, const linalg::Vec3& v_up)
 
   linalg::Quat q;
   q.set_rotation_from_matrix(rotation_matrix);
-  m_Rotation = linalg::normalized(q);
+  rotation() = linalg::normalized(q);
   MarkDirty();
 }
 
@@ -204,9 +246,114 @@ auto Transform::Lerp(const Transform& from, const Transform& to, float t)
     -> Transform
 {
   Transform result;
-  result.m_Position = linalg::mix(from.m_Position, to.m_Position, t);
-  result.m_Rotation = linalg::slerp(from.m_Rotation, to.m_Rotation, t);
-  result.m_Scale = linalg::mix(from.m_Scale, to.m_Scale, t);
+  result.m_Position = linalg::mix(from.position(), to.position(), t);
+  result.m_Rotation = linalg::slerp(from.rotation(), to.rotation(), t);
+  result.m_Scale = linalg::mix(from.scale(), to.scale(), t);
   result.MarkDirty();
   return result;
 }
+
+auto Transform::ComposeMatrix(const linalg::Vec3& position,
+                              const linalg::Quat& rotation,
+                              const linalg::Vec3& scale) -> linalg::Mat4
+{
+  linalg::Mat4 matrix = linalg::Mat4::identity();
+  matrix = matrix * static_cast<linalg::Mat4>(linalg::make_translation(position));
+  matrix = matrix * rotation.to_mat4();
+  matrix = matrix * static_cast<linalg::Mat4>(linalg::make_scale(scale));
+  return matrix;
+}
+
+void Transform::Bind(TransformStore* store)
+{
+  if (store == m_Store) {
+    return;
+  }
+
+  if (m_Store != nullptr) {
+    m_Position = m_Store->Position(m_Handle);
+    m_Rotation = m_Store->Rotation(m_Handle);
+    m_Scale = m_Store->Scale(m_Handle);
+    m_Store->Free(m_Handle);
+    m_Store = nullptr;
+    m_Handle = kInvalidTransformHandle;
+  }
+
+  if (store != nullptr) {
+    const bool parent_bound = m_Parent != nullptr && m_Parent->m_Store == store;
+    m_Handle =
+        store->Allocate(parent_bound ? m_Parent->m_Handle : kInvalidTransformHandle);
+    m_Store = store;
+    m_Store->Position(m_Handle) = m_Position;
+    m_Store->Rotation(m_Handle) = m_Rotation;
+    m_Store->Scale(m_Handle) = m_Scale;
+  }
+
+  MarkDirty();
+}
+
+auto Transform::GetStore() const -> TransformStore*
+{
+  return m_Store;
+}
+
+auto Transform::GetHandle() const -> TransformHandle
+{
+  return m_Handle;
+}
+
+auto Transform::position() -> linalg::Vec3&
+{
+  return (m_Store != nullptr) ? m_Store->Position(m_Handle) : m_Position;
+}
+
+auto Transform::position() const -> const linalg::Vec3&
+{
+  return (m_Store != nullptr) ? m_Store->Position(m_Handle) : m_Position;
+}
+
+auto Transform::rotation() -> linalg::Quat&
+{
+  return (m_Store != nullptr) ? m_Store->Rotation(m_Handle) : m_Rotation;
+}
+
+auto Transform::rotation() const -> const linalg::Quat&
+{
+  return (m_Store != nullptr) ? m_Store->Rotation(m_Handle) : m_Rotation;
+}
+
+auto Transform::scale() -> linalg::Vec3&
+{
+  return (m_Store != nullptr) ? m_Store->Scale(m_Handle) : m_Scale;
+}
+
+auto Transform::scale() const -> const linalg::Vec3&
+{
+  return (m_Store != nullptr) ? m_Store->Scale(m_Handle) : m_Scale;
+}
+
+auto Transform::local_matrix() -> linalg::Mat4&
+{
+  return (m_Store != nullptr) ? m_Store->LocalMatrix(m_Handle) : m_LocalMatrix;
+}
+
+auto Transform::world_matrix() -> linalg::Mat4&
+{
+  return (m_Store != nullptr) ? m_Store->WorldMatrix(m_Handle) : m_WorldMatrix;
+}
+
+auto Transform::world_matrix() const -> const linalg::Mat4&
+{
+  return (m_Store != nullptr) ? m_Store->WorldMatrix(m_Handle) : m_WorldMatrix;
+}
+
+void Transform::set_dirty(bool local_dirty, bool world_dirty)
+{
+  if (m_Store != nullptr) {
+    m_Store->SetLocalDirty(m_Handle, local_dirty);
+    m_Store->SetWorldDirty(m_Handle, world_dirty);
+  } else {
+    m_LocalDirty = local_dirty;
+    m_WorldDirty = world_dirty;
+  }
+}
@@ -0,0 +1,381 @@
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include "Renderer/Scene/TransformStore.hpp"
+
+#include "Core/ThreadPool.hpp"
+#include "Renderer/Scene/Transform.hpp"
+
+namespace
+{
+
+constexpr uint32_t INVALID_SLOT = std::numeric_limits<uint32_t>::max();
+// Below this many dirty transforms, waking workers costs more than it saves
+constexpr size_t MIN_PARALLEL_UPDATE = 4096;
+// Ranges per thread after splitting, so uneven subtrees still balance
+constexpr size_t RANGES_PER_THREAD = 8;
+
+}  // namespace
+
+auto TransformStore::Allocate(TransformHandle parent) -> TransformHandle
+{
+  TransformHandle handle = kInvalidTransformHandle;
+  if (!m_FreeHandles.empty()) {
+    handle = m_FreeHandles.back();
+    m_FreeHandles.pop_back();
+  } else {
+    handle = static_cast<TransformHandle>(m_HandleSlots.size());
+    m_HandleSlots.push_back(INVALID_SLOT);
+  }
+
+  // Appended at the end for now; the next update moves it next to its
+  // siblings so subtrees stay contiguous
+  const auto slot = static_cast<uint32_t>(m_SlotHandles.size());
+  m_Positions.push_back(linalg::Vec3 {0.0F, 0.0F, 0.0F});
+  m_Rotations.push_back(linalg::Quat {0.0F, 0.0F, 0.0F, 1.0F});
+  m_Scales.push_back(linalg::Vec3 {1.0F, 1.0F, 1.0F});
+  m_LocalMatrices.push_back(linalg::Mat4::identity());
+  m_WorldMatrices.push_back(linalg::Mat4::identity());
+  m_ParentSlots.push_back(parent != kInvalidTransformHandle ? slot_of(parent)
+                                                            : INVALID_SLOT);
+  m_SubtreeSizes.push_back(1);
+  m_SlotHandles.push_back(handle);
+  m_LocalDirty.push_back(1);
+  m_WorldDirty.push_back(0);
+
+  m_HandleSlots[handle] = slot;
+  queue_dirty(slot);
+  ++m_LiveCount;
+  ++m_LayoutVersion;
+  m_LayoutDirty = true;
+  return handle;
+}
+
+void TransformStore::Free(TransformHandle handle)
+{
+  const uint32_t slot = slot_of(handle);
+
+  // Leave a hole; the next layout rebuild compacts it away
+  m_SlotHandles[slot] = kInvalidTransformHandle;
+  m_ParentSlots[slot] = INVALID_SLOT;
+  m_LocalDirty[slot] = 0;
+  m_WorldDirty[slot] = 0;
+
+  m_HandleSlots[handle] = INVALID_SLOT;
+  m_FreeHandles.push_back(handle);
+  --m_LiveCount;
+  m_LayoutDirty = true;
+}
+
+void TransformStore::SetParent(TransformHandle handle, TransformHandle parent)
+{
+  const uint32_t slot = slot_of(handle);
+  const uint32_t parent_slot =
+      parent != kInvalidTransformHandle ? slot_of(parent) : INVALID_SLOT;
+
+  m_ParentSlots[slot] = parent_slot;
+  queue_dirty(slot);
+  m_LayoutDirty = true;
+}
+
+auto TransformStore::GetParent(TransformHandle handle) const -> TransformHandle
+{
+  const uint32_t parent_slot = m_ParentSlots[slot_of(handle)];
+  return parent_slot != INVALID_SLOT ? m_SlotHandles[parent_slot]
+                                     : kInvalidTransformHandle;
+}
+
+auto TransformStore::Position(TransformHandle handle) -> linalg::Vec3&
+{
+  return m_Positions[slot_of(handle)];
+}
+
+auto TransformStore::Position(TransformHandle handle) const
+    -> const linalg::Vec3&
+{
+  return m_Positions[slot_of(handle)];
+}
+
+auto TransformStore::Rotation(TransformHandle handle) -> linalg::Quat&
+{
+  return m_Rotations[slot_of(handle)];
+}
+
+auto TransformStore::Rotation(TransformHandle handle) const
+    -> const linalg::Quat&
+{
+  return m_Rotations[slot_of(handle)];
+}
+
+auto TransformStore::Scale(TransformHandle handle) -> linalg::Vec3&
+{
+  return m_Scales[slot_of(handle)];
+}
+
+auto TransformStore::Scale(TransformHandle handle) const -> const linalg::Vec3&
+{
+  return m_Scales[slot_of(handle)];
+}
+
+auto TransformStore::LocalMatrix(TransformHandle handle) -> linalg::Mat4&
+{
+  return m_LocalMatrices[slot_of(handle)];
+}
+
+auto TransformStore::LocalMatrix(TransformHandle handle) const
+    -> const linalg::Mat4&
+{
+  return m_LocalMatrices[slot_of(handle)];
+}
+
+auto TransformStore::WorldMatrix(TransformHandle handle) -> linalg::Mat4&
+{
+  return m_WorldMatrices[slot_of(handle)];
+}
+
+auto TransformStore::WorldMatrix(TransformHandle handle) const
+    -> const linalg::Mat4&
+{
+  return m_WorldMatrices[slot_of(handle)];
+}
+
+void TransformStore::MarkDirty(TransformHandle handle)
+{
+  const uint32_t slot = slot_of(handle);
+  m_LocalDirty[slot] = 1;
+  queue_dirty(slot);
+}
+
+void TransformStore::SetLocalDirty(TransformHandle handle, bool dirty)
+{
+  const uint32_t slot = slot_of(handle);
+  m_LocalDirty[slot] = dirty ? 1 : 0;
+  if (dirty) {
+    queue_dirty(slot);
+  }
+}
+
+void TransformStore::SetWorldDirty(TransformHandle handle, bool dirty)
+{
+  const uint32_t slot = slot_of(handle);
+  if (dirty) {
+    queue_dirty(slot);
+  } else {
+    // The handle may stay queued; updating it again is harmless
+    m_WorldDirty[slot] = 0;
+  }
+}
+
+auto TransformStore::IsLocalDirty(TransformHandle handle) const -> bool
+{
+  return m_LocalDirty[slot_of(handle)] != 0;
+}
+
+auto TransformStore::IsWorldDirty(TransformHandle handle) const -> bool
+{
+  return m_WorldDirty[slot_of(handle)] != 0;
+}
+
+void TransformStore::UpdateWorldMatrices(ThreadPool* pool)
+{
+  if (m_LayoutDirty) {
+    rebuild_layout();
+  }
+
+  m_LastUpdateCount = 0;
+  m_UpdatedRanges.clear();
+  if (m_DirtyHandles.empty()) {
+    return;
+  }
+
+  m_DirtySlots.clear();
+  for (const TransformHandle handle : m_DirtyHandles) {
+    const uint32_t slot = m_HandleSlots[handle];
+    if (slot != INVALID_SLOT) {
+      m_DirtySlots.push_back(slot);
+    }
+  }
+  m_DirtyHandles.clear();
+  std::ranges::sort(m_DirtySlots);
+
+  // Slots inside an already collected subtree are refreshed with it
+  m_DirtyRanges.clear();
+  uint32_t swept_end = 0;
+  for (const uint32_t slot : m_DirtySlots) {
+    if (slot < swept_end) {
+      continue;
+    }
+    swept_end = slot + m_SubtreeSizes[slot];
+    m_DirtyRanges.push_back({slot, swept_end});
+    m_LastUpdateCount += m_SubtreeSizes[slot];
+  }
+  m_UpdatedRanges = m_DirtyRanges;
+
+  const uint32_t thread_count = (pool != nullptr) ? pool->GetThreadCount() : 1;
+  if (thread_count <= 1 || m_LastUpdateCount < MIN_PARALLEL_UPDATE) {
+    for (const auto& range : m_DirtyRanges) {
+      update_range(range.First, range.Last);
+    }
+    return;
+  }
+
+  split_ranges(m_LastUpdateCount / (thread_count * RANGES_PER_THREAD));
+  pool->ParallelFor(m_DirtyRanges.size(),
+                    [this](size_t index) -> void
+                    {
+                      const auto& range = m_DirtyRanges[index];
+                      update_range(range.First, range.Last);
+                    });
+}
+
+auto TransformStore::slot_of(TransformHandle handle) const -> uint32_t
+{
+  return m_HandleSlots[handle];
+}
+
+void TransformStore::queue_dirty(uint32_t slot)
+{
+  if (m_WorldDirty[slot] == 0) {
+    m_WorldDirty[slot] = 1;
+    m_DirtyHandles.push_back(m_SlotHandles[slot]);
+  }
+}
+
+void TransformStore::update_range(uint32_t first, uint32_t last)
+{
+  // The first slot's parent lies outside the range and is already current
+  for (uint32_t slot = first; slot < last; ++slot) {
+    if (m_LocalDirty[slot] != 0) {
+      m_LocalMatrices[slot] = Transform::ComposeMatrix(
+          m_Positions[slot], m_Rotations[slot], m_Scales[slot]);
+      m_LocalDirty[slot] = 0;
+    }
+
+    const uint32_t parent = m_ParentSlots[slot];
+    m_WorldMatrices[slot] = (parent != INVALID_SLOT)
+        ? m_WorldMatrices[parent] * m_LocalMatrices[slot]
+        : m_LocalMatrices[slot];
+    m_WorldDirty[slot] = 0;
+  }
+}
+
+void TransformStore::split_ranges(size_t grain_size)
+{
+  // Sibling subtrees are independent once their parent is current, so a
+  // large range is replaced by its children after updating its root here.
+  m_SplitRanges.clear();
+  while (!m_DirtyRanges.empty()) {
+    const SlotRange range = m_DirtyRanges.back();
+    m_DirtyRanges.pop_back();
+
+    if (range.Last - range.First <= std::max<size_t>(grain_size, 1)) {
+      m_SplitRanges.push_back(range);
+      continue;
+    }
+
+    update_range(range.First, range.First + 1);
+    for (uint32_t child = range.First + 1; child < range.Last;
+         child += m_SubtreeSizes[child])
+    {
+      m_DirtyRanges.push_back({child, child + m_SubtreeSizes[child]});
+    }
+  }
+  std::swap(m_DirtyRanges, m_SplitRanges);
+}
+
+void TransformStore::rebuild_layout()
+{
+  ++m_LayoutVersion;
+  const auto old_count = static_cast<uint32_t>(m_SlotHandles.size());
+
+  // Children of every slot in compressed form. Nodes whose parent was freed
+  // become roots rather than disappearing from the layout.
+  std::vector<uint32_t> child_offsets(old_count + 1, 0);
+  std::vector<uint32_t> roots;
+  for (uint32_t slot = 0; slot < old_count; ++slot) {
+    if (m_SlotHandles[slot] == kInvalidTransformHandle) {
+      continue;
+    }
+    const uint32_t parent = m_ParentSlots[slot];
+    if (parent == INVALID_SLOT
+        || m_SlotHandles[parent] == kInvalidTransformHandle)
+    {
+      m_ParentSlots[slot] = INVALID_SLOT;
+      roots.push_back(slot);
+    } else {
+      ++child_offsets[parent + 1];
+    }
+  }
+  for (uint32_t slot = 0; slot < old_count; ++slot) {
+    child_offsets[slot + 1] += child_offsets[slot];
+  }
+
+  std::vector<uint32_t> children(child_offsets[old_count]);
+  std::vector<uint32_t> cursor(child_offsets.begin(), child_offsets.end() - 1);
+  for (uint32_t slot = 0; slot < old_count; ++slot) {
+    const uint32_t parent = m_ParentSlots[slot];
+    if (m_SlotHandles[slot] != kInvalidTransformHandle && parent != INVALID_SLOT)
+    {
+      children[cursor[parent]++] = slot;
+    }
+  }
+
+  // Depth-first preorder; push children reversed so they pop in order
+  std::vector<uint32_t> order;
+  order.reserve(m_LiveCount);
+  std::vector<uint32_t> stack(roots.rbegin(), roots.rend());
+  while (!stack.empty()) {
+    const uint32_t slot = stack.back();
+    stack.pop_back();
+    order.push_back(slot);
+    for (uint32_t i = child_offsets[slot + 1]; i > child_offsets[slot]; --i) {
+      stack.push_back(children[i - 1]);
+    }
+  }
+
+  std::vector<uint32_t> new_slots(old_count, INVALID_SLOT);
+  for (uint32_t i = 0; i < order.size(); ++i) {
+    new_slots[order[i]] = i;
+  }
+
+  auto permute = [&order](auto& values) -> void
+  {
+    std::remove_cvref_t<decltype(values)> sorted;
+    sorted.reserve(order.size());
+    for (const uint32_t old_slot : order) {
+      sorted.push_back(values[old_slot]);
+    }
+    values = std::move(sorted);
+  };
+
+  permute(m_Positions);
+  permute(m_Rotations);
+  permute(m_Scales);
+  permute(m_LocalMatrices);
+  permute(m_WorldMatrices);
+  permute(m_ParentSlots);
+  permute(m_SlotHandles);
+  permute(m_LocalDirty);
+  permute(m_WorldDirty);
+
+  for (uint32_t slot = 0; slot < order.size(); ++slot) {
+    uint32_t& parent = m_ParentSlots[slot];
+    if (parent != INVALID_SLOT) {
+      parent = new_slots[parent];
+    }
+    m_HandleSlots[m_SlotHandles[slot]] = slot;
+  }
+
+  // Preorder puts descendants after their ancestor, so a reverse pass can
+  // accumulate subtree sizes into parents
+  m_SubtreeSizes.assign(order.size(), 1U);
+  for (auto slot = static_cast<uint32_t>(order.size()); slot-- > 0;) {
+    const uint32_t parent = m_ParentSlots[slot];
+    if (parent != INVALID_SLOT) {
+      m_SubtreeSizes[parent] += m_SubtreeSizes[slot];
+    }
+  }
+
+  m_LayoutDirty = false;
+}
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+
+#include "Renderer/UploadRing.hpp"
+
+#include "Core/Logger.hpp"
+#include "Renderer/RHI/RHIDevice.hpp"
+
+namespace
+{
+
+auto AlignUp(size_t value, size_t alignment) -> size_t
+{
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+}  // namespace
+
+UploadRing::UploadRing(RHIDevice& device,
+                       BufferUsage usage,
+                       size_t page_size,
+                       size_t binding_range)
+    : m_Device(device)
+    , m_Usage(usage)
+    , m_PageSize(page_size)
+    , m_BindingRange(binding_range)
+    , m_Partitions(std::max(device.GetFramesInFlight(), 1U))
+{
+}
+
+UploadRing::~UploadRing() = default;
+
+void UploadRing::BeginFrame()
+{
+  m_FrameIndex =
+      m_Device.GetFrameIndex() % static_cast<uint32_t>(m_Partitions.size());
+
+  auto& partition = m_Partitions[m_FrameIndex];
+  for (auto& page : partition.Pages) {
+    page.Offset = 0;
+  }
+  partition.Current = 0;
+}
+
+auto UploadRing::Allocate(size_t size, size_t alignment) -> UploadAllocation
+{
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+    throw std::runtime_error(
+        std::format("Upload alignment {} is not a power of two", alignment));
+  }
+
+  auto& partition = m_Partitions[m_FrameIndex];
+  const size_t reserved = std::max(size, m_BindingRange);
+
+  // Move on through the pages kept from earlier frames before growing
+  while (partition.Current < partition.Pages.size()) {
+    Page& page = partition.Pages[partition.Current];
+    const size_t offset = AlignUp(page.Offset, alignment);
+    if (offset + reserved <= page.Buffer->GetSize()) {
+      page.Offset = offset + size;
+      return {page.Buffer.get(), offset, size};
+    }
+    ++partition.Current;
+  }
+
+  Page& page = add_page(partition, reserved);
+  page.Offset = size;
+  return {page.Buffer.get(), 0, size};
+}
+
+auto UploadRing::Upload(const void* data, size_t size, size_t alignment)
+    -> UploadAllocation
+{
+  const UploadAllocation allocation = Allocate(size, alignment);
+  allocation.Buffer->Upload(data, size, allocation.Offset);
+  return allocation;
+}
+
+auto UploadRing::GetFrameUsage() const -> size_t
+{
+  const auto& partition = m_Partitions[m_FrameIndex];
+  size_t usage = 0;
+  for (const auto& page : partition.Pages) {
+    usage += page.Offset;
+  }
+  return usage;
+}
+
+auto UploadRing::GetCapacity() const -> size_t
+{
+  size_t capacity = 0;
+  for (const auto& partition : m_Partitions) {
+    for (const auto& page : partition.Pages) {
+      capacity += page.Buffer->GetSize();
+    }
+  }
+  return capacity;
+}
+
+auto UploadRing::GetPageCount() const -> size_t
+{
+  size_t count = 0;
+  for (const auto& partition : m_Partitions) {
+    count += partition.Pages.size();
+  }
+  return count;
+}
+
+auto UploadRing::add_page(Partition& partition, size_t min_size) -> Page&
+{
+  BufferDesc desc {};
+  desc.Size = std::max(m_PageSize, min_size);
+  desc.Usage = m_Usage;
+  desc.CPUVisible = true;
+  desc.PersistentMap = true;
+
+  Logger::Trace("[UploadRing] Frame {} grows to {} page(s) of {} bytes",
+                m_FrameIndex,
+                partition.Pages.size() + 1,
+                desc.Size);
+
+  partition.Pages.push_back({m_Device.CreateBuffer(desc), 0});
+  partition.Current = partition.Pages.size() - 1;
+  return partition.Pages.back();
+}
@@ -6,6 +6,8 @@
 #include <imgui.h>
 
 #include "Core/Logger.hpp"
+#include "Renderer/RHI/Null/NullDevice.hpp"
+#include "Renderer/RHI/Null/NullImGui.hpp"
 #include "Renderer/RHI/OpenGL/OpenGLDevice.hpp"
 #include "Renderer/RHI/OpenGL/OpenGLImGui.hpp"
 #include "Renderer/RHI/Vulkan/VulkanDevice.hpp"
@@ -24,6 +26,10 @@ auto RHIImGui::Create(RHIDevice& device) -> std::unique_ptr<RHIImGui>
     return std::make_unique<OpenGLImGui>(*opengl_device);
   }
 
+  if (auto* null_device = dynamic_cast<NullDevice*>(&device)) {
+    return std::make_unique<NullImGui>(*null_device);
+  }
+
   throw std::runtime_error("Unsupported RHI device type for ImGui");
 }
 
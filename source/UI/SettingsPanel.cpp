@@ -80,7 +80,7 @@ auto SettingsPanel::IsWireframe() const -> bool
 void SettingsPanel::renderRendererSection()
 {
   if (ImGui::CollapsingHeader("Renderer", ImGuiTreeNodeFlags_DefaultOpen)) {
-    constexpr const char* API_NAMES[] = {"OpenGL", "Vulkan"};
+    constexpr const char* API_NAMES[] = {"OpenGL", "Vulkan", "Null"};
     int current = static_cast<int>(m_CurrentAPI);
     if (ImGui::Combo("Backend", &current, API_NAMES, IM_ARRAYSIZE(API_NAMES))) {
       auto selected = static_cast<RenderAPI>(current);
@@ -0,0 +1,69 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Renderer/DrawQueue.hpp"
+
+TEST_CASE("DrawQueue sort keys order passes, state and depth", "[draw_queue]")
+{
+  // Pass dominates everything else
+  REQUIRE(DrawQueue::MakeSortKey(DrawPass::Opaque, 9, 9, 100.0F)
+          < DrawQueue::MakeSortKey(DrawPass::Masked, 0, 0, 0.0F));
+  REQUIRE(DrawQueue::MakeSortKey(DrawPass::Masked, 9, 9, 100.0F)
+          < DrawQueue::MakeSortKey(DrawPass::Transparent, 0, 0, 0.0F));
+
+  // Opaque draws group by material, then mesh, then go front to back
+  REQUIRE(DrawQueue::MakeSortKey(DrawPass::Opaque, 1, 9, 100.0F)
+          < DrawQueue::MakeSortKey(DrawPass::Opaque, 2, 0, 0.0F));
+  REQUIRE(DrawQueue::MakeSortKey(DrawPass::Opaque, 1, 1, 100.0F)
+          < DrawQueue::MakeSortKey(DrawPass::Opaque, 1, 2, 0.0F));
+  REQUIRE(DrawQueue::MakeSortKey(DrawPass::Opaque, 1, 1, 1.0F)
+          < DrawQueue::MakeSortKey(DrawPass::Opaque, 1, 1, 50.0F));
+
+  // Transparent draws go back to front regardless of state
+  REQUIRE(DrawQueue::MakeSortKey(DrawPass::Transparent, 2, 2, 50.0F)
+          < DrawQueue::MakeSortKey(DrawPass::Transparent, 1, 1, 1.0F));
+}
+
+TEST_CASE("DrawQueue radix sort matches std::sort", "[draw_queue]")
+{
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<uint64_t> id(0, 64);
+  std::uniform_real_distribution<float> depth(0.0F, 1000.0F);
+
+  DrawQueue queue;
+  std::vector<uint64_t> expected;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    const auto pass = static_cast<DrawPass>(i % 3);
+    DrawPacket packet {};
+    packet.SortKey =
+        DrawQueue::MakeSortKey(pass, id(rng), id(rng), depth(rng));
+    packet.FirstInstance = i;
+    queue.Add(packet);
+    expected.push_back(packet.SortKey);
+  }
+  std::ranges::sort(expected);
+
+  queue.Sort();
+  const auto packets = queue.GetPackets();
+  REQUIRE(packets.size() == expected.size());
+  for (size_t i = 0; i < packets.size(); ++i) {
+    REQUIRE(packets[i].SortKey == expected[i]);
+  }
+
+  // Equal keys keep insertion order
+  queue.Clear();
+  for (uint32_t i = 0; i < 8; ++i) {
+    DrawPacket packet {};
+    packet.SortKey = DrawQueue::MakeSortKey(DrawPass::Opaque, 3, 4, 1.0F);
+    packet.FirstInstance = i;
+    queue.Add(packet);
+  }
+  queue.Sort();
+  for (uint32_t i = 0; i < 8; ++i) {
+    REQUIRE(queue.GetPackets()[i].FirstInstance == i);
+  }
+}
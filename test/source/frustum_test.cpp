@@ -0,0 +1,53 @@
+#include <array>
+#include <cstdint>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Renderer/Camera.hpp"
+#include "Renderer/Frustum.hpp"
+
+namespace
+{
+
+auto MakeBox(float x, float y, float z) -> AABB
+{
+  return AABB {linalg::Vec3 {x - 0.5F, y - 0.5F, z - 0.5F},
+               linalg::Vec3 {x + 0.5F, y + 0.5F, z + 0.5F}};
+}
+
+}  // namespace
+
+TEST_CASE("Frustum batches agree with single volume tests", "[frustum]")
+{
+  Camera camera;
+  camera.SetPerspective(60.0F, 1.0F, 0.1F, 100.0F);
+  camera.SetPosition(linalg::Vec3 {0.0F, 0.0F, 0.0F});
+  camera.SetTarget(linalg::Vec3 {1.0F, 0.0F, 0.0F});
+  const Frustum frustum = Frustum::FromMatrix(camera.GetViewProjectionMatrix());
+
+  const std::array<AABB, 6> boxes = {
+      MakeBox(10.0F, 0.0F, 0.0F),  // In front
+      MakeBox(-10.0F, 0.0F, 0.0F),  // Behind
+      MakeBox(200.0F, 0.0F, 0.0F),  // Past the far plane
+      MakeBox(10.0F, -50.0F, 0.0F),  // Far to the right
+      MakeBox(10.0F, 0.0F, 5.0F),  // Inside the 60 degree cone
+      AABB {},  // Empty
+  };
+
+  std::array<uint8_t, boxes.size()> visible {};
+  REQUIRE(frustum.CullAABBs(boxes, visible) == 2);
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    REQUIRE((visible[i] != 0) == frustum.Intersects(boxes[i]));
+  }
+  REQUIRE(visible[0] == 1);
+  REQUIRE(visible[4] == 1);
+
+  std::array<BoundingSphere, 5> spheres {};
+  for (size_t i = 0; i < spheres.size(); ++i) {
+    spheres[i] = BoundingSphere::FromAABB(boxes[i]);
+  }
+  std::array<uint8_t, spheres.size()> sphere_visible {};
+  REQUIRE(frustum.CullSpheres(spheres, sphere_visible) == 2);
+  REQUIRE(sphere_visible[0] == 1);
+  REQUIRE(sphere_visible[4] == 1);
+}
@@ -0,0 +1,151 @@
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Core/Logger.hpp"
+#include "Renderer/Model/GeometryPool.hpp"
+#include "Renderer/Model/Mesh.hpp"
+#include "Renderer/RHI/RHIDevice.hpp"
+#include "Renderer/RendererConfig.hpp"
+
+TEST_CASE("Free list merges released ranges", "[geometry_pool]")
+{
+  FreeListAllocator allocator(100);
+
+  const auto first = allocator.Allocate(30);
+  const auto second = allocator.Allocate(30);
+  const auto third = allocator.Allocate(30);
+  REQUIRE(first == 0U);
+  REQUIRE(second == 30U);
+  REQUIRE(third == 60U);
+  REQUIRE_FALSE(allocator.Allocate(20).has_value());
+
+  // Holes that are not adjacent stay separate blocks
+  allocator.Free(*first, 30);
+  allocator.Free(*third, 30);
+  REQUIRE(allocator.GetFreeBlockCount() == 2);
+  REQUIRE(allocator.GetLargestFreeBlock() == 40);
+
+  // Releasing the middle joins everything back into one block
+  allocator.Free(*second, 30);
+  REQUIRE(allocator.GetFreeBlockCount() == 1);
+  REQUIRE(allocator.GetLargestFreeBlock() == 100);
+  REQUIRE(allocator.GetUsed() == 0);
+
+  // First fit reuses the lowest hole that is large enough
+  REQUIRE(allocator.Allocate(10) == 0U);
+  REQUIRE(allocator.Allocate(90) == 10U);
+}
+
+TEST_CASE("Geometry pool shares pages between meshes", "[geometry_pool]")
+{
+  Logger::Init(LoggerConfig {spdlog::level::off});
+
+  RendererConfig config;
+  config.API = RenderAPI::Null;
+  auto device = RHIDevice::Create(config);
+  device->Init(config, nullptr);
+
+  constexpr uint32_t PAGE_VERTICES = 64;
+  constexpr uint32_t PAGE_INDICES = 96;
+  GeometryPool pool(*device, PAGE_VERTICES, PAGE_INDICES);
+
+  const std::vector<Vertex> vertices(24);
+  const std::vector<uint32_t> indices(36, 0);
+
+  auto first = pool.Allocate(vertices, indices);
+  auto second = pool.Allocate(vertices, indices);
+  REQUIRE(pool.GetPageCount() == 1);
+  REQUIRE(first.GetVertexBuffer() == second.GetVertexBuffer());
+  REQUIRE(first.GetIndexBuffer() == second.GetIndexBuffer());
+  REQUIRE(second.GetRange().FirstVertex == 24);
+  REQUIRE(second.GetRange().FirstIndex == 36);
+
+  // No room left for a third mesh, so it gets a page of its own
+  auto third = pool.Allocate(vertices, indices);
+  REQUIRE(pool.GetPageCount() == 2);
+  REQUIRE(third.GetRange().Page == 1);
+  REQUIRE(third.GetVertexBuffer() != first.GetVertexBuffer());
+
+  // Freed ranges are reused and empty extra pages are released
+  first.Reset();
+  third.Reset();
+  REQUIRE(pool.GetPageCount() == 1);
+  auto reused = pool.Allocate(vertices, indices);
+  REQUIRE(reused.GetRange().Page == 0);
+  REQUIRE(reused.GetRange().FirstVertex == 0);
+
+  // Moving an allocation transfers ownership of the range
+  GeometryAllocation moved = std::move(second);
+  REQUIRE(pool.GetAllocationCount() == 2);
+  moved.Reset();
+  reused.Reset();
+  REQUIRE(pool.GetAllocationCount() == 0);
+  REQUIRE(pool.GetUsedVertices() == 0);
+  REQUIRE(pool.GetUsedIndices() == 0);
+}
+
+TEST_CASE("Allocations outliving their pool are detached", "[geometry_pool]")
+{
+  Logger::Init(LoggerConfig {spdlog::level::off});
+
+  RendererConfig config;
+  config.API = RenderAPI::Null;
+  auto device = RHIDevice::Create(config);
+  device->Init(config, nullptr);
+
+  const std::vector<Vertex> vertices(3);
+  const std::vector<uint32_t> indices(3, 0);
+
+  auto pool = std::make_unique<GeometryPool>(*device, 64, 96);
+  auto allocation = pool->Allocate(vertices, indices);
+  REQUIRE(allocation.IsValid());
+
+  pool.reset();
+  REQUIRE_FALSE(allocation.IsValid());
+  REQUIRE(allocation.GetVertexBuffer() == nullptr);
+  REQUIRE(allocation.GetIndexBuffer() == nullptr);
+  allocation.Reset();
+}
+
+TEST_CASE("Pooled meshes use page offsets", "[geometry_pool]")
+{
+  Logger::Init(LoggerConfig {spdlog::level::off});
+
+  RendererConfig config;
+  config.API = RenderAPI::Null;
+  auto device = RHIDevice::Create(config);
+  device->Init(config, nullptr);
+  GeometryPool pool(*device, 64, 96);
+
+  auto make_mesh = []() -> Mesh
+  {
+    Mesh mesh;
+    mesh.SetVertices(std::vector<Vertex>(8));
+    mesh.SetIndices(std::vector<uint32_t>(12, 0));
+    mesh.AddSubMesh(0, 6, 0);
+    mesh.AddSubMesh(6, 6, 1);
+    return mesh;
+  };
+
+  Mesh first = make_mesh();
+  Mesh second = make_mesh();
+  first.CreateBuffers(pool);
+  second.CreateBuffers(pool);
+
+  REQUIRE(second.IsPooled());
+  REQUIRE(first.GetVertexBuffer() == second.GetVertexBuffer());
+  REQUIRE(second.GetSubMesh(0).IndexOffset == 12);
+  REQUIRE(second.GetSubMesh(0).VertexOffset == 8);
+  REQUIRE(second.GetSubMesh(1).IndexOffset == 18);
+
+  // Destroying the buffers returns the offsets to mesh-local space
+  second.DestroyBuffers();
+  REQUIRE_FALSE(second.IsPooled());
+  REQUIRE(second.GetSubMesh(1).IndexOffset == 6);
+  REQUIRE(second.GetSubMesh(1).VertexOffset == 0);
+  REQUIRE(pool.GetAllocationCount() == 1);
+}
@@ -0,0 +1,151 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Core/Logger.hpp"
+#include "Renderer/RHI/Null/NullBuffer.hpp"
+#include "Renderer/RHI/Null/NullDevice.hpp"
+#include "Renderer/RHI/RHITexture.hpp"
+#include "Renderer/RHI/RenderPassInfo.hpp"
+#include "Renderer/RendererConfig.hpp"
+
+TEST_CASE("Null device records command streams", "[rhi][null]")
+{
+  Logger::Init(LoggerConfig {spdlog::level::off});
+
+  RendererConfig config;
+  config.API = RenderAPI::Null;
+
+  auto device = RHIDevice::Create(config);
+  device->Init(config, nullptr);
+  device->CreateSwapchain(640, 480);
+  REQUIRE(device->GetSwapchain()->GetWidth() == 640);
+
+  BufferDesc desc;
+  desc.Size = 16;
+  auto buffer = device->CreateBuffer(desc);
+  const std::array<uint32_t, 4> data {1, 2, 3, 4};
+  buffer->Upload(data.data(), sizeof(data), 0);
+  REQUIRE(static_cast<const uint32_t*>(buffer->Map())[2] == 3);
+  REQUIRE_THROWS(buffer->Upload(data.data(), sizeof(data), 4));
+
+  auto* null_device = dynamic_cast<NullDevice*>(device.get());
+  REQUIRE(null_device != nullptr);
+
+  for (int frame = 0; frame < 2; ++frame) {
+    device->BeginFrame();
+    auto* cmd = device->GetCurrentCommandBuffer();
+    RenderPassInfo info;
+    info.Width = 640;
+    info.Height = 480;
+    cmd->BeginRenderPass(info);
+    cmd->BindVertexBuffer(*buffer, 0);
+    cmd->Draw(3, 1, 0, 0);
+    cmd->DrawIndexed(6, 2, 0, -1, 0);
+    cmd->EndRenderPass();
+    device->EndFrame();
+    device->Present();
+  }
+
+  const auto* recorded = null_device->GetNullCommandBuffer();
+  REQUIRE(recorded->GetCommands().size() == 5);
+  REQUIRE(recorded->GetDrawCount() == 2);
+  REQUIRE(recorded->GetCommands()[1].Object == buffer.get());
+  REQUIRE(recorded->GetCommands()[3].Args[1] == 2);
+  REQUIRE(null_device->GetFrameCount() == 2);
+
+  device->Destroy();
+}
+
+TEST_CASE("Null device records indirect draws", "[rhi][null]")
+{
+  Logger::Init(LoggerConfig {spdlog::level::off});
+
+  RendererConfig config;
+  config.API = RenderAPI::Null;
+  auto device = RHIDevice::Create(config);
+  device->Init(config, nullptr);
+  device->CreateSwapchain(64, 64);
+
+  BufferDesc desc;
+  desc.Size = 4 * sizeof(DrawIndexedIndirectCommand);
+  desc.Usage = BufferUsage::Indirect;
+  auto args = device->CreateBuffer(desc);
+  desc.Size = sizeof(uint32_t);
+  auto count = device->CreateBuffer(desc);
+
+  device->BeginFrame();
+  auto* cmd = device->GetCurrentCommandBuffer();
+  cmd->DrawIndexedIndirect(*args, sizeof(DrawIndexedIndirectCommand), 3);
+  cmd->DrawIndexedIndirectCount(*args, 0, *count, 0, 4);
+  device->EndFrame();
+
+  const auto* recorded =
+      dynamic_cast<NullDevice*>(device.get())->GetNullCommandBuffer();
+  REQUIRE(recorded->GetDrawCount() == 2);
+  const auto& multi_draw = recorded->GetCommands()[0];
+  REQUIRE(multi_draw.Type == NullCommandType::DrawIndexedIndirect);
+  REQUIRE(multi_draw.Args[0] == sizeof(DrawIndexedIndirectCommand));
+  REQUIRE(multi_draw.Args[1] == 3);
+  REQUIRE(multi_draw.Args[2] == sizeof(DrawIndexedIndirectCommand));
+  REQUIRE(recorded->GetCommands()[1].SecondaryObject == count.get());
+
+  device->Destroy();
+}
+
+TEST_CASE("Null device batches buffer uploads", "[rhi][null]")
+{
+  Logger::Init(LoggerConfig {spdlog::level::off});
+
+  RendererConfig config;
+  config.API = RenderAPI::Null;
+  auto device = RHIDevice::Create(config);
+  device->Init(config, nullptr);
+  device->CreateSwapchain(64, 64);
+
+  BufferDesc desc;
+  desc.Size = 16;
+  desc.CPUVisible = false;
+  auto buffer = device->CreateBuffer(desc);
+  REQUIRE_THROWS(buffer->Map());
+
+  const std::array<uint32_t, 2> data {7, 8};
+  device->UploadBuffer(*buffer, data.data(), sizeof(data), 0);
+  device->UploadBuffer(*buffer, data.data(), sizeof(data), sizeof(data));
+
+  auto* null_buffer = dynamic_cast<NullBuffer*>(buffer.get());
+  REQUIRE(null_buffer != nullptr);
+  REQUIRE(null_buffer->GetData()[8] == std::byte {7});
+
+  // Both copies go out in one submission; an empty flush submits nothing
+  device->FlushUploads();
+  device->FlushUploads();
+  auto stats = device->GetUploadStats();
+  REQUIRE(stats.Bytes == 2 * sizeof(data));
+  REQUIRE(stats.Copies == 2);
+  REQUIRE(stats.Submissions == 1);
+
+  // Copies left pending go out with the frame
+  device->UploadBuffer(*buffer, data.data(), sizeof(data), 0);
+  device->BeginFrame();
+  device->EndFrame();
+  stats = device->GetUploadStats();
+  REQUIRE(stats.Submissions == 2);
+
+  // Texture copies count towards the totals and are reported separately
+  TextureDesc texture_desc;
+  texture_desc.Width = 2;
+  texture_desc.Height = 2;
+  auto texture = device->CreateTexture(texture_desc);
+  const std::array<uint8_t, 16> pixels {};
+  device->UploadTexture(*texture, pixels.data(), pixels.size());
+  device->FlushUploads();
+  stats = device->GetUploadStats();
+  REQUIRE(stats.Copies == 4);
+  REQUIRE(stats.TextureCopies == 1);
+  REQUIRE(stats.Submissions == 3);
+
+  device->Destroy();
+}
@@ -0,0 +1,258 @@
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Core/Logger.hpp"
+#include "Renderer/RHI/Null/NullCommandBuffer.hpp"
+#include "Renderer/RHI/Null/NullDevice.hpp"
+#include "Renderer/RHI/RHIDevice.hpp"
+#include "Renderer/RenderGraph.hpp"
+#include "Renderer/RendererConfig.hpp"
+
+namespace
+{
+
+constexpr uint32_t WIDTH = 64;
+constexpr uint32_t HEIGHT = 32;
+
+auto MakeColor(const std::string& name, bool exported = false)
+    -> RenderGraph::ResourceDesc
+{
+  return {
+      .Name = name,
+      .Width = WIDTH,
+      .Height = HEIGHT,
+      .ColorFormat = TextureFormat::RGBA8Srgb,
+      .HasDepth = false,
+      .IsDepth = false,
+      .Exported = exported,
+  };
+}
+
+auto MakePass(const std::string& name,
+              std::vector<std::string> inputs,
+              std::vector<std::string> outputs) -> RenderGraph::PassDesc
+{
+  return {
+      .Name = name,
+      .Inputs = std::move(inputs),
+      .Outputs = std::move(outputs),
+      .UseDepth = false,
+      .Execute = [](RHICommandBuffer& /*cmd*/) -> void {},
+  };
+}
+
+// A -> B -> C -> Backbuffer, each written by its own pass
+void BuildChain(RenderGraph& graph, bool export_first)
+{
+  graph.AddResource(MakeColor("A", export_first));
+  graph.AddResource(MakeColor("B"));
+  graph.AddResource(MakeColor("C"));
+  graph.AddPass(MakePass("Composite", {"C"}, {RenderGraph::BACKBUFFER}));
+  graph.AddPass(MakePass("Third", {"B"}, {"C"}));
+  graph.AddPass(MakePass("Second", {"A"}, {"B"}));
+  graph.AddPass(MakePass("First", {}, {"A"}));
+}
+
+// Barriers of every batch recorded in the last frame, in order
+auto GetFrameBarriers(NullDevice& device) -> std::vector<TextureBarrier>
+{
+  const auto* recorded = device.GetNullCommandBuffer();
+  std::vector<TextureBarrier> barriers;
+  for (const auto& command : recorded->GetCommands()) {
+    const auto batch = recorded->GetBarriers(command);
+    barriers.insert(barriers.end(), batch.begin(), batch.end());
+  }
+  return barriers;
+}
+
+auto Transitions(const TextureBarrier& barrier,
+                 const RHITexture* texture,
+                 TextureState before,
+                 TextureState after) -> bool
+{
+  return barrier.Texture == texture && barrier.Before == before
+      && barrier.After == after;
+}
+
+}  // namespace
+
+TEST_CASE("Render graph shares targets between disjoint resources",
+          "[render_graph]")
+{
+  Logger::Init(LoggerConfig {spdlog::level::off});
+
+  RendererConfig config;
+  config.API = RenderAPI::Null;
+  auto device = RHIDevice::Create(config);
+  device->Init(config, nullptr);
+
+  constexpr uint64_t TARGET_BYTES = uint64_t {WIDTH} * HEIGHT * 4;
+
+  RenderGraph graph;
+  BuildChain(graph, false);
+  graph.Compile(*device);
+
+  // A is dead once Second ran, so C can take over its target
+  REQUIRE(graph.GetTexture("A") == graph.GetTexture("C"));
+  REQUIRE(graph.GetTexture("A") != graph.GetTexture("B"));
+  REQUIRE(graph.GetMemoryStats().ResourceCount == 3);
+  REQUIRE(graph.GetMemoryStats().TargetCount == 2);
+  REQUIRE(graph.GetMemoryStats().RequiredBytes == 3 * TARGET_BYTES);
+  REQUIRE(graph.GetMemoryStats().AllocatedBytes == 2 * TARGET_BYTES);
+
+  // Sharing is planned again with the new size
+  graph.Resize(*device, WIDTH * 2, HEIGHT * 2);
+  REQUIRE(graph.GetTexture("A") == graph.GetTexture("C"));
+  REQUIRE(graph.GetTexture("C")->GetWidth() == WIDTH * 2);
+  REQUIRE(graph.GetMemoryStats().AllocatedBytes == 8 * TARGET_BYTES);
+
+  // Exported resources keep their contents until the end of the frame
+  graph.Clear();
+  BuildChain(graph, true);
+  graph.Compile(*device);
+  REQUIRE(graph.GetTexture("A") != graph.GetTexture("C"));
+  REQUIRE(graph.GetMemoryStats().TargetCount == 3);
+
+  device->Destroy();
+}
+
+TEST_CASE("Render graph derives texture transitions from pass accesses",
+          "[render_graph]")
+{
+  Logger::Init(LoggerConfig {spdlog::level::off});
+
+  RendererConfig config;
+  config.API = RenderAPI::Null;
+  auto device = RHIDevice::Create(config);
+  device->Init(config, nullptr);
+  device->CreateSwapchain(WIDTH, HEIGHT);
+  auto* null_device = dynamic_cast<NullDevice*>(device.get());
+  REQUIRE(null_device != nullptr);
+
+  // Lighting accumulates into what it rendered last frame
+  auto lighting = MakePass("Lighting", {"Albedo"}, {"Lit"});
+  lighting.ColorAttachments[0].ColorLoadOp = LoadOp::Load;
+
+  RenderGraph graph;
+  graph.AddResource(MakeColor("Albedo"));
+  graph.AddResource(MakeColor("Lit"));
+  graph.AddPass(MakePass("GBuffer", {}, {"Albedo"}));
+  graph.AddPass(lighting);
+  graph.AddPass(
+      MakePass("Composite", {"Lit", "Albedo"}, {RenderGraph::BACKBUFFER}));
+  graph.Compile(*device);
+
+  auto* albedo = graph.GetTexture("Albedo");
+  auto* lit = graph.GetTexture("Lit");
+
+  auto run_frame = [&]() -> std::vector<TextureBarrier>
+  {
+    device->BeginFrame();
+    graph.SetBackbufferSize(WIDTH, HEIGHT);
+    graph.Execute(*device->GetCurrentCommandBuffer());
+    device->EndFrame();
+    device->Present();
+    return GetFrameBarriers(*null_device);
+  };
+
+  // The first frame moves the new targets into the state frames start in
+  const auto first = run_frame();
+  REQUIRE(first.size() == 6);
+  REQUIRE(first[0].Before == TextureState::Undefined);
+  REQUIRE(first[1].Before == TextureState::Undefined);
+
+  const auto steady = run_frame();
+  REQUIRE(null_device->GetNullCommandBuffer()->GetCommandCount(
+              NullCommandType::Barrier)
+          == 3);
+  REQUIRE(steady.size() == 4);
+  REQUIRE(Transitions(steady[0],
+                      albedo,
+                      TextureState::ShaderRead,
+                      TextureState::ColorAttachment));
+  REQUIRE(steady[0].Discard);
+  REQUIRE(Transitions(
+      steady[1], lit, TextureState::ShaderRead, TextureState::ColorAttachment));
+  REQUIRE_FALSE(steady[1].Discard);
+  REQUIRE(Transitions(steady[2],
+                      albedo,
+                      TextureState::ColorAttachment,
+                      TextureState::ShaderRead));
+  // Albedo is still readable for the composite, so only Lit transitions
+  REQUIRE(Transitions(
+      steady[3], lit, TextureState::ColorAttachment, TextureState::ShaderRead));
+
+  device->Destroy();
+}
+
+TEST_CASE("Render graph culls unused passes and reuses identical plans",
+          "[render_graph]")
+{
+  Logger::Init(LoggerConfig {spdlog::level::off});
+
+  RendererConfig config;
+  config.API = RenderAPI::Null;
+  auto device = RHIDevice::Create(config);
+  device->Init(config, nullptr);
+  device->CreateSwapchain(WIDTH, HEIGHT);
+  auto* null_device = dynamic_cast<NullDevice*>(device.get());
+  REQUIRE(null_device != nullptr);
+
+  // A debug view of B that nothing reads unless it is exported
+  auto describe =
+      [](RenderGraph& graph, bool show_debug, bool debug_depth = false) -> void
+  {
+    BuildChain(graph, false);
+    graph.AddResource(MakeColor("Debug", show_debug));
+    auto debug_view = MakePass("DebugView", {"B"}, {"Debug"});
+    debug_view.UseDepth = debug_depth;
+    graph.AddPass(debug_view);
+  };
+
+  RenderGraph graph;
+  describe(graph, false);
+  graph.Compile(*device);
+  REQUIRE(graph.GetCompileStats().PassCount == 5);
+  REQUIRE(graph.GetCompileStats().CulledPassCount == 1);
+  REQUIRE_FALSE(graph.GetCompileStats().ReusedPlan);
+  REQUIRE(graph.GetTexture("Debug") == nullptr);
+
+  device->BeginFrame();
+  graph.SetBackbufferSize(WIDTH, HEIGHT);
+  graph.Execute(*device->GetCurrentCommandBuffer());
+  device->EndFrame();
+  device->Present();
+  REQUIRE(null_device->GetNullCommandBuffer()->GetCommandCount(
+              NullCommandType::BeginRenderPass)
+          == 4);
+
+  // Describing the same graph again keeps the compiled plan
+  const auto targets = graph.GetMemoryStats().TargetCount;
+  graph.Reset();
+  describe(graph, false);
+  graph.Compile(*device);
+  REQUIRE(graph.GetCompileStats().ReusedPlan);
+  REQUIRE(graph.GetMemoryStats().TargetCount == targets);
+  REQUIRE(graph.GetTexture("A") != nullptr);
+
+  // Exporting the debug view changes the structure, so it is planned anew
+  graph.Reset();
+  describe(graph, true);
+  graph.Compile(*device);
+  REQUIRE_FALSE(graph.GetCompileStats().ReusedPlan);
+  REQUIRE(graph.GetCompileStats().CulledPassCount == 0);
+  REQUIRE(graph.GetTexture("Debug") != nullptr);
+
+  // The attachments a pass uses decide its barriers, so they are part of the
+  // structure as well
+  graph.Reset();
+  describe(graph, true, true);
+  graph.Compile(*device);
+  REQUIRE_FALSE(graph.GetCompileStats().ReusedPlan);
+
+  device->Destroy();
+}
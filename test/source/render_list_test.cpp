@@ -0,0 +1,55 @@
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Renderer/Model/Model.hpp"
+#include "Renderer/Scene/Scene.hpp"
+#include "Renderer/Scene/SceneNode.hpp"
+
+TEST_CASE("Render list follows hierarchy and visibility events",
+          "[scene][renderlist]")
+{
+  Scene scene("Test");
+  const auto model = std::make_shared<Model>("Empty");
+
+  auto* parent = scene.CreateNode("Parent");
+  auto* child = scene.CreateNode("Child", parent);
+  auto* other = scene.CreateNode("Other");
+  REQUIRE(scene.GetRenderList().empty());
+
+  parent->SetModel(model);
+  child->SetModel(model);
+  other->SetModel(model);
+  REQUIRE(scene.GetRenderList().size() == 3);
+
+  // Hiding a parent hides its subtree; showing it restores it
+  parent->SetVisible(false);
+  REQUIRE_FALSE(child->IsVisibleInHierarchy());
+  REQUIRE(scene.GetRenderList().size() == 1);
+  REQUIRE(scene.GetRenderList().front().Node == other);
+  parent->SetVisible(true);
+  REQUIRE(child->IsVisibleInHierarchy());
+  REQUIRE(scene.GetRenderList().size() == 3);
+
+  // Reparenting under a hidden node hides the moved subtree
+  auto* hidden = scene.CreateNode("Hidden");
+  hidden->SetVisible(false);
+  hidden->AddChild(std::make_unique<SceneNode>("Late"))->SetModel(model);
+  REQUIRE_FALSE(hidden->FindChild("Late")->IsVisibleInHierarchy());
+  REQUIRE(scene.GetRenderList().size() == 3);
+
+  // Clearing a model and removing a subtree drop their entries
+  other->SetModel(nullptr);
+  scene.GetRoot().RemoveChild(parent);
+  REQUIRE(scene.GetRenderList().empty());
+
+  // Entries point at the current world matrices after an update
+  auto* moved = scene.CreateNode("Moved");
+  moved->SetModel(model);
+  moved->SetPosition(linalg::Vec3 {1.0F, 2.0F, 3.0F});
+  scene.UpdateTransforms();
+  const auto items = scene.GetRenderList();
+  REQUIRE(items.size() == 1);
+  REQUIRE(items.front().WorldMatrix == &moved->GetTransform().GetWorldMatrix());
+}
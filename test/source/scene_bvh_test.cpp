@@ -0,0 +1,64 @@
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Renderer/Model/Mesh.hpp"
+#include "Renderer/Model/Model.hpp"
+#include "Renderer/Model/Vertex.hpp"
+#include "Renderer/Scene/Scene.hpp"
+#include "Renderer/Scene/SceneNode.hpp"
+
+namespace
+{
+
+auto MakeUnitCube() -> std::shared_ptr<Model>
+{
+  std::vector<Vertex> vertices(2);
+  vertices[0].Position = linalg::Vec3 {-0.5F, -0.5F, -0.5F};
+  vertices[1].Position = linalg::Vec3 {0.5F, 0.5F, 0.5F};
+
+  auto mesh = std::make_unique<Mesh>("Cube");
+  mesh->SetVertices(std::move(vertices));
+  auto model = std::make_shared<Model>("Cube");
+  model->AddMesh(std::move(mesh));
+  return model;
+}
+
+}  // namespace
+
+TEST_CASE("Scene BVH answers picks and follows moved nodes", "[scene][bvh]")
+{
+  Scene scene("Test");
+  const auto cube = MakeUnitCube();
+
+  std::vector<SceneNode*> nodes;
+  for (int i = 0; i < 64; ++i) {
+    auto* node = scene.CreateNode("Cube");
+    node->SetPosition(linalg::Vec3 {static_cast<float>(i) * 2.0F, 0.0F, 0.0F});
+    node->SetModel(cube);
+    nodes.push_back(node);
+  }
+  scene.UpdateTransforms();
+
+  const Ray down {linalg::Vec3 {20.0F, 10.0F, 0.0F},
+                  linalg::Vec3 {0.0F, -1.0F, 0.0F}};
+  REQUIRE(scene.PickNode(down) == nodes[10]);
+  REQUIRE(scene.QueryAABB(AABB {linalg::Vec3 {-1.0F, -1.0F, -1.0F},
+                                linalg::Vec3 {3.0F, 1.0F, 1.0F}})
+              .size()
+          == 2);
+
+  // Moving a node refits the tree without a rebuild
+  nodes[10]->SetPosition(linalg::Vec3 {20.0F, 0.0F, 50.0F});
+  scene.UpdateTransforms();
+  REQUIRE(scene.PickNode(down) == nullptr);
+  REQUIRE(scene.GetBounds().Max.z() > 50.0F);
+
+  // Hidden and removed nodes drop out of the index
+  nodes[0]->SetVisible(false);
+  scene.GetRoot().RemoveChild(nodes[1]);
+  REQUIRE(scene.QueryAABB(AABB {linalg::Vec3 {-1.0F, -1.0F, -1.0F},
+                                linalg::Vec3 {3.0F, 1.0F, 1.0F}})
+              .empty());
+}
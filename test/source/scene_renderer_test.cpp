@@ -0,0 +1,128 @@
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Core/Logger.hpp"
+#include "Renderer/Camera.hpp"
+#include "Renderer/Model/Mesh.hpp"
+#include "Renderer/Model/Model.hpp"
+#include "Renderer/Model/Vertex.hpp"
+#include "Renderer/RHI/Null/NullBuffer.hpp"
+#include "Renderer/RHI/Null/NullCommandBuffer.hpp"
+#include "Renderer/RHI/Null/NullDevice.hpp"
+#include "Renderer/RHI/RHIDevice.hpp"
+#include "Renderer/RendererConfig.hpp"
+#include "Renderer/Scene/Scene.hpp"
+#include "Renderer/Scene/SceneNode.hpp"
+#include "Renderer/Scene/SceneRenderer.hpp"
+
+namespace
+{
+
+auto MakeTriangleModel(RHIDevice& device, const std::string& name)
+    -> std::shared_ptr<Model>
+{
+  auto mesh = std::make_unique<Mesh>(name);
+  mesh->SetVertices(std::vector<Vertex>(3));
+  mesh->SetIndices({0, 1, 2});
+  mesh->CreateSingleSubMesh();
+
+  auto model = std::make_shared<Model>(name);
+  model->AddMesh(std::move(mesh));
+  model->CreateResources(device, nullptr, nullptr, nullptr, nullptr);
+  return model;
+}
+
+// FirstInstance of every indirect command recorded in the last frame
+auto GetIndirectFirstInstances(NullDevice& device) -> std::vector<uint32_t>
+{
+  std::vector<uint32_t> first_instances;
+  for (const auto& command : device.GetNullCommandBuffer()->GetCommands()) {
+    if (command.Type != NullCommandType::DrawIndexedIndirect) {
+      continue;
+    }
+    const auto* args = static_cast<const NullBuffer*>(
+        static_cast<const RHIBuffer*>(command.Object));
+    for (uint32_t i = 0; i < command.Args[1]; ++i) {
+      DrawIndexedIndirectCommand draw {};
+      std::memcpy(&draw,
+                  args->GetData().data() + command.Args[0]
+                      + (static_cast<size_t>(i) * command.Args[2]),
+                  sizeof(draw));
+      first_instances.push_back(draw.FirstInstance);
+    }
+  }
+  return first_instances;
+}
+
+}  // namespace
+
+TEST_CASE("Indirect scene draws start at their node window slot",
+          "[scene][renderer]")
+{
+  Logger::Init(LoggerConfig {spdlog::level::off});
+
+  RendererConfig config;
+  config.API = RenderAPI::Null;
+  auto device = RHIDevice::Create(config);
+  device->Init(config, nullptr);
+  device->CreateSwapchain(64, 64);
+  auto* null_device = dynamic_cast<NullDevice*>(device.get());
+  REQUIRE(null_device != nullptr);
+
+  // Three instanced groups: the first two share a node window, the third
+  // does not fit and starts the next one
+  Scene scene("Test");
+  const std::pair<const char*, uint32_t> groups[] = {
+      {"A", 3}, {"B", 2}, {"C", SceneRenderer::MAX_INSTANCES}};
+  for (const auto& [name, count] : groups) {
+    const auto model = MakeTriangleModel(*device, name);
+    for (uint32_t i = 0; i < count; ++i) {
+      scene.CreateNode(name)->SetModel(model);
+    }
+  }
+  scene.UpdateTransforms();
+
+  SceneRenderer renderer(*device,
+                         RenderAPI::Null,
+                         LUMINA_EXAMPLE_SHADER_DIR "/scene.slang");
+  renderer.SetFrustumCulling(false);
+  renderer.SetIndirectDraws(true);
+
+  const Camera camera;
+  auto render_frame = [&]() -> void
+  {
+    device->BeginFrame();
+    renderer.BeginFrame(camera);
+    renderer.RenderScene(*device->GetCurrentCommandBuffer(), scene);
+    device->EndFrame();
+    device->Present();
+  };
+
+  render_frame();
+  REQUIRE(renderer.GetBindStats().Sorted.Nodes == 2);
+  REQUIRE(GetIndirectFirstInstances(*null_device)
+          == std::vector<uint32_t> {0, 3, 0});
+
+  // Without drawIndirectFirstInstance the draw at slot 3 is recorded
+  // directly, and every indirect command starts at its window
+  null_device->SetIndirectFirstInstance(false);
+  render_frame();
+  REQUIRE(GetIndirectFirstInstances(*null_device)
+          == std::vector<uint32_t> {0, 0});
+  const auto* recorded = null_device->GetNullCommandBuffer();
+  REQUIRE(recorded->GetCommandCount(NullCommandType::DrawIndexed) == 1);
+  for (const auto& command : recorded->GetCommands()) {
+    if (command.Type == NullCommandType::DrawIndexed) {
+      REQUIRE(command.Args[1] == 2);
+      REQUIRE(command.Args[4] == 3);
+    }
+  }
+
+  device->Destroy();
+}
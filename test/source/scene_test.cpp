@@ -0,0 +1,58 @@
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Renderer/Scene/Scene.hpp"
+#include "Renderer/Scene/SceneNode.hpp"
+
+TEST_CASE("Scene name index tracks creation, renames and removal",
+          "[scene][names]")
+{
+  Scene scene("Test");
+  REQUIRE(scene.FindNode("Root") == &scene.GetRoot());
+
+  auto* first = scene.CreateNode("Crate");
+  auto* second = scene.CreateNode("Crate");
+  auto* third = scene.CreateNode("Crate");
+  REQUIRE(first->GetName() == "Crate");
+  REQUIRE(second->GetName() == "Crate_1");
+  REQUIRE(third->GetName() == "Crate_2");
+  REQUIRE(scene.FindNode("Crate_1") == second);
+
+  second->SetName("Barrel");
+  REQUIRE(scene.FindNode("Crate_1") == nullptr);
+  REQUIRE(scene.FindNode("Barrel") == second);
+
+  // Suffixes keep counting up and never collide with existing names
+  REQUIRE(scene.CreateNode("Crate")->GetName() == "Crate_3");
+  scene.CreateNode("Node_1");
+  REQUIRE(scene.CreateNode("Node")->GetName() == "Node");
+  REQUIRE(scene.CreateNode("Node")->GetName() == "Node_2");
+
+  scene.GetRoot().RemoveChild(first);
+  REQUIRE(scene.FindNode("Crate") == nullptr);
+  REQUIRE(scene.MakeUniqueName("Crate") == "Crate");
+}
+
+TEST_CASE("Templated traversal visits in order and prunes", "[scene]")
+{
+  Scene scene("Test");
+  auto* a = scene.CreateNode("A");
+  scene.CreateNode("A1", a);
+  scene.CreateNode("A2", a);
+  auto* b = scene.CreateNode("B");
+  scene.CreateNode("B1", b);
+
+  std::string order;
+  scene.ForEachNode([&order](const SceneNode& node) -> void
+                    { order += node.GetName() + " "; });
+  REQUIRE(order == "Root A A1 A2 B B1 ");
+
+  a->SetVisible(false);
+  size_t visible = 0;
+  scene.ForEachVisibleNode([&visible](const SceneNode& /*node*/) -> void
+                           { ++visible; });
+  REQUIRE(visible == 3);
+  REQUIRE(scene.GetVisibleNodeCount() == 3);
+  REQUIRE(scene.GetNodeCount() == 6);
+}
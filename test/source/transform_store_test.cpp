@@ -0,0 +1,85 @@
+#include <cstring>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Renderer/Scene/Scene.hpp"
+#include "Renderer/Scene/SceneNode.hpp"
+
+TEST_CASE("Flat transform update matches the hierarchy", "[scene][transform]")
+{
+  Scene scene("Test");
+  auto* parent = scene.CreateNode("Parent");
+  auto* child = scene.CreateNode("Child", parent);
+  auto* grandchild = scene.CreateNode("Grandchild", child);
+
+  parent->SetPosition(linalg::Vec3 {1.0F, 0.0F, 0.0F});
+  child->SetPosition(linalg::Vec3 {0.0F, 2.0F, 0.0F});
+  grandchild->SetPosition(linalg::Vec3 {0.0F, 0.0F, 3.0F});
+  scene.UpdateTransforms();
+
+  REQUIRE(scene.GetTransformStore().GetCount() == 4);
+  REQUIRE(grandchild->GetWorldPosition() == linalg::Vec3 {1.0F, 2.0F, 3.0F});
+
+  // Moving only the parent must still refresh its descendants
+  parent->SetPosition(linalg::Vec3 {5.0F, 0.0F, 0.0F});
+  scene.UpdateTransforms();
+  REQUIRE(grandchild->GetWorldPosition() == linalg::Vec3 {5.0F, 2.0F, 3.0F});
+
+  // Removing a node frees its slots and compacts the layout
+  parent->RemoveChild(child);
+  scene.UpdateTransforms();
+  REQUIRE(scene.GetTransformStore().GetCount() == 2);
+  REQUIRE(parent->GetWorldPosition() == linalg::Vec3 {5.0F, 0.0F, 0.0F});
+}
+
+TEST_CASE("Transform update only visits dirty subtrees", "[scene][transform]")
+{
+  Scene scene("Test");
+  auto* moving = scene.CreateNode("Moving");
+  auto* child = scene.CreateNode("Child", moving);
+  auto* still = scene.CreateNode("Still");
+  scene.CreateNode("StillChild", still);
+  scene.UpdateTransforms();
+
+  scene.UpdateTransforms();
+  REQUIRE(scene.GetTransformStore().GetLastUpdateCount() == 0);
+
+  moving->SetPosition(linalg::Vec3 {1.0F, 0.0F, 0.0F});
+  child->SetPosition(linalg::Vec3 {0.0F, 1.0F, 0.0F});
+  scene.UpdateTransforms();
+  REQUIRE(scene.GetTransformStore().GetLastUpdateCount() == 2);
+  REQUIRE(child->GetWorldPosition() == linalg::Vec3 {1.0F, 1.0F, 0.0F});
+}
+
+TEST_CASE("Parallel transform update matches serial", "[scene][transform]")
+{
+  constexpr size_t NODE_COUNT = 20'000;
+
+  auto build = [](Scene& scene) -> std::vector<SceneNode*>
+  {
+    std::vector<SceneNode*> nodes {&scene.GetRoot()};
+    for (size_t i = 1; i < NODE_COUNT; ++i) {
+      // Deterministic, bushy hierarchy
+      auto* node = nodes[(i * 7919) % nodes.size()]->CreateChild("Node");
+      node->SetPosition(linalg::Vec3 {static_cast<float>(i % 13), 1.0F, 0.5F});
+      node->SetRotationEuler(linalg::Vec3 {0.0F, static_cast<float>(i % 90), 0.0F});
+      nodes.push_back(node);
+    }
+    return nodes;
+  };
+
+  Scene serial("Serial");
+  Scene parallel("Parallel");
+  parallel.SetTransformUpdateThreads(4);
+  const auto serial_nodes = build(serial);
+  const auto parallel_nodes = build(parallel);
+  serial.UpdateTransforms();
+  parallel.UpdateTransforms();
+
+  for (size_t i = 0; i < NODE_COUNT; ++i) {
+    const auto& expected = serial_nodes[i]->GetTransform().GetWorldMatrix();
+    const auto& actual = parallel_nodes[i]->GetTransform().GetWorldMatrix();
+    REQUIRE(std::memcmp(&expected, &actual, sizeof(linalg::Mat4)) == 0);
+  }
+}
@@ -0,0 +1,85 @@
+#include <array>
+#include <cstdint>
+#include <set>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Core/Logger.hpp"
+#include "Renderer/RHI/RHIDevice.hpp"
+#include "Renderer/RendererConfig.hpp"
+#include "Renderer/UploadRing.hpp"
+
+TEST_CASE("Upload ring partitions memory per frame in flight",
+          "[rhi][upload]")
+{
+  Logger::Init(LoggerConfig {spdlog::level::off});
+
+  RendererConfig config;
+  config.API = RenderAPI::Null;
+  auto device = RHIDevice::Create(config);
+  device->Init(config, nullptr);
+  device->CreateSwapchain(64, 64);
+
+  constexpr size_t PAGE_SIZE = 1024;
+  constexpr size_t ALIGNMENT = 256;
+  UploadRing ring(*device, BufferUsage::Uniform, PAGE_SIZE);
+
+  // Overflowing a page grows the partition instead of wrapping
+  std::set<const RHIBuffer*> first_frame_pages;
+  device->BeginFrame();
+  ring.BeginFrame();
+  for (int i = 0; i < 10; ++i) {
+    const std::array<uint32_t, 4> data {1, 2, 3, 4};
+    const auto allocation = ring.Upload(data.data(), sizeof(data), ALIGNMENT);
+    REQUIRE(allocation.Offset % ALIGNMENT == 0);
+    REQUIRE(allocation.Buffer->IsPersistentlyMapped());
+    first_frame_pages.insert(allocation.Buffer);
+  }
+  REQUIRE(first_frame_pages.size() == 3);
+  device->EndFrame();
+  device->Present();
+
+  // The other frames in flight never touch the first frame's pages
+  for (uint32_t frame = 1; frame < device->GetFramesInFlight(); ++frame) {
+    device->BeginFrame();
+    ring.BeginFrame();
+    const auto allocation = ring.Allocate(16, ALIGNMENT);
+    REQUIRE_FALSE(first_frame_pages.contains(allocation.Buffer));
+    device->EndFrame();
+    device->Present();
+  }
+
+  // Back on the first slot, its pages are reused rather than reallocated
+  const size_t page_count = ring.GetPageCount();
+  device->BeginFrame();
+  ring.BeginFrame();
+  REQUIRE(ring.GetFrameUsage() == 0);
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(first_frame_pages.contains(ring.Allocate(16, ALIGNMENT).Buffer));
+  }
+  REQUIRE(ring.GetPageCount() == page_count);
+}
+
+TEST_CASE("Upload ring keeps a binding range behind every allocation",
+          "[rhi][upload]")
+{
+  Logger::Init(LoggerConfig {spdlog::level::off});
+
+  RendererConfig config;
+  config.API = RenderAPI::Null;
+  auto device = RHIDevice::Create(config);
+  device->Init(config, nullptr);
+  device->CreateSwapchain(64, 64);
+
+  constexpr size_t PAGE_SIZE = 1024;
+  constexpr size_t BINDING_RANGE = 512;
+  UploadRing ring(*device, BufferUsage::Uniform, PAGE_SIZE, BINDING_RANGE);
+
+  device->BeginFrame();
+  ring.BeginFrame();
+  for (int i = 0; i < 16; ++i) {
+    const auto allocation = ring.Allocate(64, 64);
+    REQUIRE(allocation.Offset + BINDING_RANGE
+            <= allocation.Buffer->GetSize());
+  }
+}